@@ -0,0 +1,55 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#define USE_GANY_CORE
+#include <gx/gany.h>
+
+#include <rx/rx.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+
+using namespace rx;
+
+// Times range(0, count)->toArray()->map(size) against the ArrayView variant.
+// The vector path copies the collected list every time a stage converts it back to std::vector,
+// the view path only passes a shared pointer along.
+template<typename Fn>
+double measure(int32_t rounds, Fn &&fn)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < rounds; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / rounds;
+}
+
+int main(int argc, char *argv[])
+{
+    const int64_t count = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    const int32_t rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    int64_t size = 0;
+    const double vectorMs = measure(rounds, [count, &size] {
+        Observable::range(0, count)
+            ->toArray()
+            ->map([](const GAny &value) { return static_cast<int64_t>(value.castAs<std::vector<GAny> >().size()); })
+            ->subscribe([&size](const GAny &value) { size = value.toInt64(); });
+    });
+    printf("toArray()->map(size):     %10.3f ms  (size %lld)\n", vectorMs, static_cast<long long>(size));
+
+    size = 0;
+    const double viewMs = measure(rounds, [count, &size] {
+        Observable::range(0, count)
+            ->toArrayView()
+            ->map([](const GAny &value) { return static_cast<int64_t>(value.castAs<ArrayViewPtr>()->size()); })
+            ->subscribe([&size](const GAny &value) { size = value.toInt64(); });
+    });
+    printf("toArrayView()->map(size): %10.3f ms  (size %lld)\n", viewMs, static_cast<long long>(size));
+
+    return EXIT_SUCCESS;
+}
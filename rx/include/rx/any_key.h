@@ -0,0 +1,48 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_ANY_KEY_H
+#define RX_ANY_KEY_H
+
+#include <gx/gany.h>
+
+#include <functional>
+#include <string>
+
+
+namespace rx
+{
+// Hash adapter for GAny keys in unordered containers.
+// Numbers hash by value so keys that compare equal across numeric types share a bucket,
+// everything else hashes its string form.
+struct AnyKeyHash
+{
+    size_t operator()(const GAny &key) const
+    {
+        if (key.isNumber()) {
+            return std::hash<double>{}(key.toDouble());
+        }
+        return std::hash<std::string>{}(key.toString());
+    }
+};
+
+struct AnyKeyEqual
+{
+    bool operator()(const GAny &a, const GAny &b) const
+    {
+        return a == b;
+    }
+};
+
+// Stricter equality that also requires the same GAny type, used where 1 and "1" must stay distinct keys.
+struct AnyKeyTypedEqual
+{
+    bool operator()(const GAny &a, const GAny &b) const
+    {
+        return a.typeInfo() == b.typeInfo() && a == b;
+    }
+};
+} // rx
+
+#endif //RX_ANY_KEY_H
@@ -0,0 +1,85 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_ARRAY_VIEW_H
+#define RX_ARRAY_VIEW_H
+
+#include <gx/gany.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+
+namespace rx
+{
+// Immutable slice of GAny values that keeps its backing storage alive through mOwner.
+// Operators hand these out instead of copying into a fresh std::vector per emission.
+class ArrayView
+{
+public:
+    ArrayView(std::span<const GAny> items, std::shared_ptr<const void> owner)
+        : mItems(items), mOwner(std::move(owner))
+    {
+    }
+
+public:
+    // Takes over a finished vector without copying, the view owns it from then on
+    static std::shared_ptr<ArrayView> of(std::vector<GAny> items)
+    {
+        const auto storage = std::make_shared<const std::vector<GAny> >(std::move(items));
+        return std::make_shared<ArrayView>(std::span<const GAny>(*storage), storage);
+    }
+
+public:
+    size_t size() const
+    {
+        return mItems.size();
+    }
+
+    bool empty() const
+    {
+        return mItems.empty();
+    }
+
+    const GAny &operator[](size_t index) const
+    {
+        return mItems[index];
+    }
+
+    auto begin() const
+    {
+        return mItems.begin();
+    }
+
+    auto end() const
+    {
+        return mItems.end();
+    }
+
+    std::span<const GAny> span() const
+    {
+        return mItems;
+    }
+
+    const std::shared_ptr<const void> &owner() const
+    {
+        return mOwner;
+    }
+
+    // Copies the slice, only needed when the consumer wants its own vector
+    std::vector<GAny> toVector() const
+    {
+        return std::vector<GAny>(mItems.begin(), mItems.end());
+    }
+
+private:
+    std::span<const GAny> mItems;
+    std::shared_ptr<const void> mOwner;
+};
+
+using ArrayViewPtr = std::shared_ptr<ArrayView>;
+} // rx
+
+#endif //RX_ARRAY_VIEW_H
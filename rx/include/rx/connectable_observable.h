@@ -0,0 +1,47 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_CONNECTABLE_OBSERVABLE_H
+#define RX_CONNECTABLE_OBSERVABLE_H
+
+#include "observable.h"
+
+
+namespace rx
+{
+// Observable that shares one upstream subscription among all its observers.
+// Observers only receive values once connect() has subscribed the upstream.
+class GX_API ConnectableObservable : public Observable
+{
+public:
+    using ConnectionCallback = std::function<void(const DisposablePtr &connection)>;
+
+    ~ConnectableObservable() override = default;
+
+public:
+    // onConnect receives the connection before the upstream is subscribed, so it can be disposed
+    // even while a synchronous upstream is still emitting
+    virtual void connect(const ConnectionCallback &onConnect) = 0;
+
+    // Drops a terminated connection, later observers then wait for the next connect() instead of
+    // receiving the old terminal event
+    virtual void reset() = 0;
+
+    DisposablePtr connect();
+
+    // Connects on the first observer and disconnects when the last one goes away
+    std::shared_ptr<Observable> refCount();
+
+    // Connects once minSubscribers observers are present, after the last one leaves the connection
+    // is kept for gracePeriod milliseconds in case a new observer arrives
+    std::shared_ptr<Observable> refCount(uint32_t minSubscribers, uint64_t gracePeriod, SchedulerPtr scheduler = nullptr);
+
+    // Connects once numberOfObservers observers subscribed, the connection is never disposed
+    std::shared_ptr<Observable> autoConnect(uint32_t numberOfObservers = 1);
+};
+
+using ConnectableObservablePtr = std::shared_ptr<ConnectableObservable>;
+} // rx
+
+#endif //RX_CONNECTABLE_OBSERVABLE_H
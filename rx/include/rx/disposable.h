@@ -15,8 +15,12 @@ struct Disposable
 {
     virtual ~Disposable() = default;
 
+    // Races with the operator's own terminal event: whichever of the two flips the operator's termination flag
+    // first takes over the downstream, the other returns without touching it.
     virtual void dispose() = 0;
 
+    // True only after an explicit dispose(). An operator that terminates on its own keeps reporting false,
+    // since the operators below it check isDisposed() before forwarding the terminal it delivers.
     virtual bool isDisposed() const = 0;
 };
 
@@ -0,0 +1,55 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_ACTION_DISPOSABLE_H
+#define RX_ACTION_DISPOSABLE_H
+
+#include "../disposable.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+#include <functional>
+
+
+namespace rx
+{
+// Runs the action once, on the first dispose
+class ActionDisposable : public Disposable
+{
+public:
+    explicit ActionDisposable(std::function<void()> action)
+        : mAction(std::move(action))
+    {
+        LeakObserver::make<ActionDisposable>();
+    }
+
+    ~ActionDisposable() override
+    {
+        LeakObserver::release<ActionDisposable>();
+    }
+
+public:
+    void dispose() override
+    {
+        if (!mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            const auto action = std::move(mAction);
+            mAction = nullptr;
+            if (action) {
+                action();
+            }
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    std::function<void()> mAction;
+    std::atomic<bool> mDisposed = false;
+};
+} // rx
+
+#endif //RX_ACTION_DISPOSABLE_H
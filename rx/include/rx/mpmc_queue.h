@@ -0,0 +1,107 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_MPMC_QUEUE_H
+#define RX_MPMC_QUEUE_H
+
+#include <gx/gany.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+
+
+namespace rx
+{
+// Bounded multi-producer multi-consumer queue of GAny (Vyukov's array queue).
+// Every cell carries a sequence number telling producers and consumers whose turn it is,
+// so offer()/poll() only contend on one CAS each and never lock or allocate.
+class MpmcQueue
+{
+private:
+    struct Cell
+    {
+        std::atomic<uint64_t> sequence = 0;
+        GAny value;
+    };
+
+public:
+    // The capacity is rounded up to a power of two
+    explicit MpmcQueue(size_t capacity)
+        : mMask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+          mCells(std::make_unique<Cell[]>(mMask + 1))
+    {
+        for (size_t i = 0; i <= mMask; ++i) {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+public:
+    // Fails when the queue is full
+    bool offer(const GAny &value)
+    {
+        uint64_t position = mEnqueue.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &mCells[position & mMask];
+            const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (diff == 0) {
+                if (mEnqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = mEnqueue.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool poll(GAny &out)
+    {
+        uint64_t position = mDequeue.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &mCells[position & mMask];
+            const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+            if (diff == 0) {
+                if (mDequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = mDequeue.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->value = GAny();
+        cell->sequence.store(position + mMask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const
+    {
+        return mMask + 1;
+    }
+
+private:
+    const size_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+    alignas(64) std::atomic<uint64_t> mEnqueue = 0;
+    alignas(64) std::atomic<uint64_t> mDequeue = 0;
+};
+} // rx
+
+#endif //RX_MPMC_QUEUE_H
@@ -10,10 +10,15 @@
 #include "emitter.h"
 #include "scheduler.h"
 
+#include <span>
+
 
 namespace rx
 {
 class Observable;
+class ConnectableObservable;
+class ParallelObservable;
+class SpillCodec;
 
 using ObservableOnSubscribe = std::function<void(const ObservableEmitterPtr &emitter)>;
 using MapFunction = std::function<GAny(const GAny &x)>;
@@ -25,6 +30,42 @@ using CombineLatestFunction = std::function<GAny(const std::vector<GAny> &values
 using ComparatorFunction = std::function<bool(const GAny &a, const GAny &b)>;
 using ResumeFunction = std::function<std::shared_ptr<Observable>(const GAnyException &e)>;
 
+// What a bounded buffer does when a new value arrives while it is full
+enum class OverflowStrategy
+{
+    Error,      // Terminate with an error
+    DropLatest, // Discard the arriving value
+    Block,      // Hold the producer thread back until there is room, only mergeSorted() supports it
+};
+
+// How a broadcast producer waits while the slowest consumer still holds the slot it wants to reuse
+enum class WaitStrategy
+{
+    BusySpin, // Re-check continuously, lowest latency but keeps a core busy
+    Yield,    // Re-check after yielding the thread
+    Park,     // Sleep until a consumer advances
+};
+
+// How balance() picks the rail that receives the next value
+enum class BalanceStrategy
+{
+    RoundRobin,       // Rails take turns
+    LeastOutstanding, // The rail with the fewest queued or in-flight values
+    WorkStealing,     // Values go to a shared bounded queue and any free rail takes the next one
+};
+
+struct CombineOptions
+{
+    bool coalesce = false;              // Call the combiner once per batch of updates that arrived during a drain
+};
+
+struct GroupOptions
+{
+    uint64_t idleTimeout = 0;           // Complete a group after this many milliseconds without values, 0 disables
+    uint64_t maxGroups = 0;             // Complete the least recently active group beyond this count, 0 disables
+    SchedulerPtr scheduler = nullptr;   // Drives idleTimeout, defaults to MainThreadScheduler
+};
+
 class GX_API Observable : public ObservableSource, public std::enable_shared_from_this<Observable>
 {
 public:
@@ -37,6 +78,15 @@ public:
 
     static std::shared_ptr<Observable> fromArray(const std::vector<GAny> &array);
 
+    static std::shared_ptr<Observable> fromArray(std::vector<GAny> &&array);
+
+    static std::shared_ptr<Observable> fromIterable(std::shared_ptr<const std::vector<GAny> > items);
+
+    static std::shared_ptr<Observable> fromIterable(std::span<const GAny> items, std::shared_ptr<const void> owner);
+
+    // Emits the items on a scheduler worker, chunkSize at a time, yielding the worker between chunks
+    static std::shared_ptr<Observable> fromArray(std::vector<GAny> array, SchedulerPtr scheduler, uint64_t chunkSize = 1024);
+
     template<typename... Args>
     static std::shared_ptr<Observable> just(Args &&... sources)
     {
@@ -58,9 +108,16 @@ public:
 
     static std::shared_ptr<Observable> range(int64_t start, uint64_t count);
 
+    // Emits the range on a scheduler worker, chunkSize values at a time, yielding the worker between chunks
+    static std::shared_ptr<Observable> range(int64_t start, uint64_t count, SchedulerPtr scheduler, uint64_t chunkSize = 1024);
+
     static std::shared_ptr<Observable> combineLatestArray(const std::vector<std::shared_ptr<Observable> > &sources,
                                                           const CombineLatestFunction &combiner);
 
+    static std::shared_ptr<Observable> combineLatestArray(const std::vector<std::shared_ptr<Observable> > &sources,
+                                                          const CombineLatestFunction &combiner,
+                                                          CombineOptions options);
+
     static std::shared_ptr<Observable> combineLatest(const std::shared_ptr<Observable> &source1, const std::shared_ptr<Observable> &source2,
                                                      const BiFunction &combiner);
 
@@ -76,6 +133,19 @@ public:
         return mergeArray({std::forward<Args>(sources)...});
     }
 
+    // Merges sources that are each ordered by comparator (a < b when null) into one ordered stream. The smallest
+    // buffered head is emitted once every source that has not completed has a head, ties go to the earlier source.
+    // By default the per-source queues are unbounded, so sources running ahead of a slower one are only buffered.
+    // A non-zero prefetch bounds the values queued per source and strategy decides what happens to a source that
+    // runs further ahead: Error fails the stream, DropLatest discards the value and Block holds the source back on
+    // its thread until the merge catches up. Block hangs when sources share a thread, such as two sources on the
+    // MainThreadScheduler. Values a source emits synchronously while it is being subscribed are always queued,
+    // since the sources after it are not subscribed yet
+    static std::shared_ptr<Observable> mergeSorted(const std::vector<std::shared_ptr<Observable> > &sources,
+                                                   const ComparatorFunction &comparator = nullptr,
+                                                   uint64_t prefetch = 0,
+                                                   OverflowStrategy strategy = OverflowStrategy::Error);
+
     static std::shared_ptr<Observable> concatArray(const std::vector<std::shared_ptr<Observable> > &sources);
 
     template<typename... Args>
@@ -95,6 +165,12 @@ public:
     static std::shared_ptr<Observable> zipArray(const std::vector<std::shared_ptr<Observable> > &sources,
                                                 const CombineLatestFunction &zipper);
 
+    // Buffers at most capacity pending values per source, strategy decides what happens beyond that
+    static std::shared_ptr<Observable> zipArray(const std::vector<std::shared_ptr<Observable> > &sources,
+                                                const CombineLatestFunction &zipper,
+                                                uint64_t capacity,
+                                                OverflowStrategy strategy = OverflowStrategy::Error);
+
     static std::shared_ptr<Observable> zip(const std::shared_ptr<Observable> &source1,
                                            const std::shared_ptr<Observable> &source2,
                                            const BiFunction &zipper);
@@ -102,6 +178,12 @@ public:
 
     std::shared_ptr<Observable> map(const MapFunction &function);
 
+    // Maps up to maxConcurrency values at once on workers from scheduler and emits the results in input order.
+    // Once maxConcurrency values are in flight the upstream thread waits for the oldest one, so the scheduler
+    // must not run on the upstream thread. Defaults to a NewThreadScheduler, one thread per worker
+    std::shared_ptr<Observable> mapAsync(const MapFunction &function, SchedulerPtr scheduler = nullptr,
+                                         uint32_t maxConcurrency = 4);
+
     std::shared_ptr<Observable> flatMap(const FlatMapFunction &function);
 
     std::shared_ptr<Observable> concatMap(const FlatMapFunction &function);
@@ -112,8 +194,90 @@ public:
 
     std::shared_ptr<Observable> buffer(uint64_t count);
 
+    // Flushes every timespan milliseconds or once maxCount values are buffered, whichever comes first (0 means no count limit)
+    std::shared_ptr<Observable> bufferTimed(uint64_t timespan, uint64_t maxCount = 0, SchedulerPtr scheduler = nullptr);
+
+    // Opens a buffer every timeskip milliseconds, each buffer collects for timespan milliseconds
+    std::shared_ptr<Observable> bufferTimedSkip(uint64_t timespan, uint64_t timeskip, SchedulerPtr scheduler = nullptr);
+
+    // Same windows as buffer(count, skip), emitted as ArrayViewPtr slices of shared storage instead of copies
+    std::shared_ptr<Observable> bufferView(uint64_t count, uint64_t skip);
+
+    // Same batches as buffer(count), each emitted as an ArrayViewPtr that owns its values
+    std::shared_ptr<Observable> bufferView(uint64_t count);
+
     std::shared_ptr<Observable> toArray();
 
+    // Collects the upstream into one list sorted by comparator (a < b when null), the sort is stable.
+    // With a scheduler, large inputs are merge sorted in parallel on its workers
+    std::shared_ptr<Observable> toSortedList(const ComparatorFunction &comparator = nullptr,
+                                             SchedulerPtr scheduler = nullptr);
+
+    // Same order as toSortedList(), the values are emitted one by one
+    std::shared_ptr<Observable> sorted(const ComparatorFunction &comparator = nullptr, SchedulerPtr scheduler = nullptr);
+
+    // Sorts by the natural order of keySelector(value), which is called once per value.
+    // Keys that are all numbers or all strings are compared natively instead of as GAny
+    std::shared_ptr<Observable> toSortedListBy(const MapFunction &keySelector, SchedulerPtr scheduler = nullptr);
+
+    // Same order as toSortedListBy(), the values are emitted one by one
+    std::shared_ptr<Observable> sortedBy(const MapFunction &keySelector, SchedulerPtr scheduler = nullptr);
+
+    // Sorts streams larger than memory: values are buffered up to roughly memoryBudget bytes, each full buffer is
+    // sorted and spilled to a run file in tmpDir (the system temp directory when empty) using codec
+    // (a BinarySpillCodec when null). On completion the runs are merged and emitted in order, stable like sorted().
+    // At most 16 run files are open at once, more runs are first merged in intermediate passes.
+    // The run files are removed once the merge finishes, on error and on dispose
+    std::shared_ptr<Observable> sortedExternal(const ComparatorFunction &comparator, uint64_t memoryBudget,
+                                               const std::string &tmpDir = "",
+                                               std::shared_ptr<SpillCodec> codec = nullptr);
+
+    // Shares a single upstream subscription among all observers once connect() is called
+    std::shared_ptr<ConnectableObservable> publish();
+
+    // publish()->refCount(): the upstream runs while at least one observer is subscribed
+    std::shared_ptr<Observable> share();
+
+    // Multicasts through one preallocated ring of capacity slots (rounded up to a power of two).
+    // Each observer reads the slots in place on its own worker from scheduler, the producer blocks according
+    // to waitStrategy while the slowest observer lags a full ring behind, so observers must not share its thread.
+    // Defaults to a NewThreadScheduler, one thread per observer
+    std::shared_ptr<ConnectableObservable> broadcast(uint64_t capacity, WaitStrategy waitStrategy = WaitStrategy::Yield,
+                                                     SchedulerPtr scheduler = nullptr);
+
+    // Splits the stream over n rails, each value reaches exactly one of them. Every rail allows a single observer
+    // and delivers on its own worker from scheduler. The upstream is subscribed once all rails have an observer.
+    // capacity bounds the shared WorkStealing queue, a full queue parks the upstream thread until a rail catches up,
+    // so the rails must not share its thread. Defaults to a NewThreadScheduler, one thread per rail
+    std::vector<std::shared_ptr<Observable> > balance(uint32_t n, BalanceStrategy strategy = BalanceStrategy::RoundRobin,
+                                                      SchedulerPtr scheduler = nullptr, uint64_t capacity = 1024);
+
+    // Splits the stream over n rails, consecutive runs of batchSize values go to the same rail in one hand-over.
+    // A run is held back until it is full or the upstream terminates, use batchSize 1 for a sparse hot source.
+    // Rails run on the upstream thread until ParallelObservable::runOn() gives each of them its own worker
+    std::shared_ptr<ParallelObservable> parallel(uint32_t n, uint32_t batchSize = 16);
+
+    // Same as parallel(n, batchSize)->runOn(scheduler)
+    std::shared_ptr<ParallelObservable> parallel(uint32_t n, SchedulerPtr scheduler, uint32_t batchSize = 16);
+
+    // Records the upstream once connected and replays every recorded value to each observer
+    std::shared_ptr<ConnectableObservable> replay();
+
+    // Replays at most the last bufferSize values
+    std::shared_ptr<ConnectableObservable> replay(uint64_t bufferSize);
+
+    // Replays the values emitted within the last time milliseconds, as measured by the scheduler
+    std::shared_ptr<ConnectableObservable> replay(uint64_t time, SchedulerPtr scheduler);
+
+    // Replays at most the last bufferSize values emitted within the last time milliseconds
+    std::shared_ptr<ConnectableObservable> replay(uint64_t bufferSize, uint64_t time, SchedulerPtr scheduler);
+
+    // replay()->autoConnect(): subscribes the upstream on the first observer and keeps everything it emits
+    std::shared_ptr<Observable> cache();
+
+    // Same list as toArray(), emitted as an ArrayViewPtr so downstream stages read it without copying
+    std::shared_ptr<Observable> toArrayView();
+
     std::shared_ptr<Observable> repeat(uint64_t times);
 
     std::shared_ptr<Observable> retry(uint64_t times);
@@ -136,6 +300,13 @@ public:
 
     std::shared_ptr<Observable> reduce(const BiFunction &accumulator);
 
+    // Folds range() and fromArray() sources in cache-sized chunks on workers from scheduler and combines the chunk
+    // results in a tree, other sources are folded sequentially. identity must leave any value unchanged under
+    // combiner, and combiner must be associative and agree with accumulator. Defaults to a NewThreadScheduler, one
+    // thread per chunk worker
+    std::shared_ptr<Observable> reduceParallel(const GAny &identity, const BiFunction &accumulator,
+                                               const BiFunction &combiner, SchedulerPtr scheduler = nullptr);
+
 
     std::shared_ptr<Observable> filter(const FilterFunction &filter);
 
@@ -143,6 +314,8 @@ public:
 
     std::shared_ptr<Observable> distinct(const MapFunction &keySelector);
 
+    std::shared_ptr<Observable> distinct(const MapFunction &keySelector, uint64_t maxKeys);
+
     std::shared_ptr<Observable> distinctUntilChanged();
 
     std::shared_ptr<Observable> distinctUntilChanged(const MapFunction &keySelector);
@@ -169,10 +342,16 @@ public:
 
     std::shared_ptr<Observable> skipLast(uint64_t count);
 
+    // Drops values that are younger than time milliseconds when the source completes
+    std::shared_ptr<Observable> skipLast(uint64_t time, SchedulerPtr scheduler);
+
     std::shared_ptr<Observable> take(uint64_t count);
 
     std::shared_ptr<Observable> takeLast(uint64_t count);
 
+    // Emits at most count values received within the last time milliseconds before completion
+    std::shared_ptr<Observable> takeLast(uint64_t count, uint64_t time, SchedulerPtr scheduler = nullptr);
+
     std::shared_ptr<Observable> takeUntil(const std::shared_ptr<Observable> &other);
 
     std::shared_ptr<Observable> takeWhile(const FilterFunction &predicate);
@@ -183,10 +362,27 @@ public:
 
     std::shared_ptr<Observable> groupBy(const MapFunction &keySelector, const MapFunction &valueSelector);
 
+    std::shared_ptr<Observable> groupBy(const MapFunction &keySelector, const MapFunction &valueSelector, GroupOptions options);
+
+    // Groups like groupBy(), but hashes every key onto one of parallelism serial lanes with a worker from scheduler.
+    // Groups are announced and fed on their lane, so values of one key keep their order while the lanes run in parallel.
+    // Defaults to a NewThreadScheduler, one thread per lane
+    std::shared_ptr<Observable> groupByParallel(const MapFunction &keySelector, SchedulerPtr scheduler = nullptr,
+                                                uint32_t parallelism = 4);
+
+    // Each window is unicast: it queues its values until its one observer subscribes, a second observer gets an error.
+    // A window nobody subscribes to keeps every value it received until it is released
     std::shared_ptr<Observable> window(int32_t count);
 
+    // Unicast windows like window(count)
     std::shared_ptr<Observable> window(int32_t count, int32_t skip);
 
+    // Starts a new window every timespan milliseconds or once the current one received maxCount values (0 means no count limit)
+    std::shared_ptr<Observable> windowTimed(uint64_t timespan, uint64_t maxCount = 0, SchedulerPtr scheduler = nullptr);
+
+    // Opens a window every timeskip milliseconds, each window stays open for timespan milliseconds
+    std::shared_ptr<Observable> windowTimedSkip(uint64_t timespan, uint64_t timeskip, SchedulerPtr scheduler = nullptr);
+
     std::shared_ptr<Observable> timeout(uint64_t timeout, SchedulerPtr scheduler = nullptr, const std::shared_ptr<Observable> &fallback = nullptr);
 
     std::shared_ptr<Observable> timeout(uint64_t timeout, const std::shared_ptr<Observable> &fallback);
@@ -202,6 +398,22 @@ public:
                                      const FlatMapFunction &rightDurationSelector,
                                      const BiFunction &resultSelector);
 
+    std::shared_ptr<Observable> joinOnKey(const std::shared_ptr<Observable> &other,
+                                          const MapFunction &leftKeySelector,
+                                          const MapFunction &rightKeySelector,
+                                          const FlatMapFunction &leftDurationSelector,
+                                          const FlatMapFunction &rightDurationSelector,
+                                          const BiFunction &resultSelector);
+
+    // Interval join: each value stays joinable for its side's window in milliseconds
+    std::shared_ptr<Observable> joinOnKey(const std::shared_ptr<Observable> &other,
+                                          const MapFunction &leftKeySelector,
+                                          const MapFunction &rightKeySelector,
+                                          uint64_t leftWindow,
+                                          uint64_t rightWindow,
+                                          const BiFunction &resultSelector,
+                                          SchedulerPtr scheduler = nullptr);
+
     std::shared_ptr<Observable> startWith(const GAny &item);
 
     std::shared_ptr<Observable> startWithArray(const std::vector<GAny> &items);
@@ -0,0 +1,192 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_MULTI_SOURCE_DRAIN_H
+#define RX_MULTI_SOURCE_DRAIN_H
+
+#include "../observable.h"
+
+#include <gx/gmutex.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+namespace rx
+{
+// Common part of zip() and mergeSorted(): every source feeds a queue of its own and whichever thread wins the
+// WIP counter drains them. It keeps the upstream handles and the first error, and hands the terminal to the
+// downstream once, from the draining thread.
+class MultiSourceDrain : public Disposable
+{
+public:
+    explicit MultiSourceDrain(const ObserverPtr &downstream)
+        : mDownstream(downstream)
+    {
+    }
+
+    ~MultiSourceDrain() override = default;
+
+public:
+    void onSubscribe(const DisposablePtr &d)
+    {
+        bool disposeNow = false;
+        {
+            GLockerGuard lock(mLock);
+            if (mCancelled) {
+                disposeNow = true;
+            } else {
+                mDisposables.push_back(d);
+            }
+        }
+        if (disposeNow) {
+            d->dispose();
+        }
+    }
+
+    void onError(const GAnyException &e)
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mCancelled || mError) {
+                return;
+            }
+            mError = std::make_unique<GAnyException>(e);
+        }
+        mErrored.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void dispose() override
+    {
+        mDisposed.store(true, std::memory_order_release);
+        if (!cancel()) {
+            return;
+        }
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+protected:
+    // Emits the next value and returns true, false while nothing is ready. A step that terminates through
+    // complete() or fail() also returns true, the drain loop then sees the cancellation and stops.
+    virtual bool drainNext() = 0;
+
+    // Drops whatever the queues still hold, only called by the thread that owns the WIP count
+    virtual void clearQueues() = 0;
+
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        while (true) {
+            while (true) {
+                if (mCancelled) {
+                    clear();
+                    return;
+                }
+                if (mErrored.load(std::memory_order_acquire)) {
+                    const GAnyException error = *mError;
+                    fail(error);
+                    return;
+                }
+                if (!drainNext()) {
+                    break;
+                }
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    void emit(const GAny &value)
+    {
+        if (!mCancelled && mDownstream) {
+            mDownstream->onNext(value);
+        }
+    }
+
+    void complete()
+    {
+        terminate([](const ObserverPtr &downstream) { downstream->onComplete(); });
+    }
+
+    void fail(const GAnyException &error)
+    {
+        terminate([&error](const ObserverPtr &downstream) { downstream->onError(error); });
+    }
+
+    bool isCancelled() const
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    // The draining thread keeps the WIP count afterwards, so a later drain() never reaches the downstream
+    template<typename Signal>
+    void terminate(const Signal &signal)
+    {
+        if (!cancel()) {
+            return;
+        }
+        const ObserverPtr downstream = std::move(mDownstream);
+        clear();
+        if (downstream) {
+            signal(downstream);
+        }
+    }
+
+    // Marks the drain cancelled and disposes the upstreams, false when it already was
+    bool cancel()
+    {
+        std::vector<DisposablePtr> disposables;
+        {
+            GLockerGuard lock(mLock);
+            if (mCancelled) {
+                return false;
+            }
+            mCancelled = true;
+            disposables = std::move(mDisposables);
+            mDisposables.clear();
+        }
+        for (const auto &disposable: disposables) {
+            if (disposable) {
+                disposable->dispose();
+            }
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        clearQueues();
+        mDownstream = nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::vector<DisposablePtr> mDisposables;
+    std::unique_ptr<GAnyException> mError; // Written once under mLock, read after mErrored
+
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mErrored = false;
+    std::atomic<bool> mCancelled = false; // Terminated or disposed
+    std::atomic<bool> mDisposed = false;
+    GMutex mLock;
+};
+} // rx
+
+#endif //RX_MULTI_SOURCE_DRAIN_H
@@ -0,0 +1,47 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_AUTO_CONNECT_H
+#define RX_OBSERVABLE_AUTO_CONNECT_H
+
+#include "../connectable_observable.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+
+
+namespace rx
+{
+// Connects the source once numberOfObservers observers subscribed and never disconnects it
+class ObservableAutoConnect : public Observable
+{
+public:
+    ObservableAutoConnect(std::shared_ptr<ConnectableObservable> source, uint32_t numberOfObservers)
+        : mSource(std::move(source)), mNumberOfObservers(numberOfObservers)
+    {
+        LeakObserver::make<ObservableAutoConnect>();
+    }
+
+    ~ObservableAutoConnect() override
+    {
+        LeakObserver::release<ObservableAutoConnect>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(observer);
+        if (mCount.fetch_add(1, std::memory_order_acq_rel) + 1 == mNumberOfObservers) {
+            mSource->connect(nullptr);
+        }
+    }
+
+private:
+    std::shared_ptr<ConnectableObservable> mSource;
+    uint32_t mNumberOfObservers;
+    std::atomic<uint32_t> mCount = 0;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_AUTO_CONNECT_H
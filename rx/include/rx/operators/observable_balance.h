@@ -0,0 +1,438 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_BALANCE_H
+#define RX_OBSERVABLE_BALANCE_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../mpmc_queue.h"
+#include "../spsc_queue.h"
+#include "../producer_park.h"
+#include "../disposables/disposable_helper.h"
+#include "observable_empty.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+#include <vector>
+
+
+namespace rx
+{
+class BalanceParent;
+
+// One output of balance(): delivers its share of the upstream to a single observer on its own worker.
+// RoundRobin and LeastOutstanding push into the rail's SPSC queue, WorkStealing rails all poll the
+// parent's shared MPMC queue, so whichever rail is free takes the next value.
+class BalanceRail : public Disposable, public std::enable_shared_from_this<BalanceRail>
+{
+public:
+    BalanceRail()
+    {
+        LeakObserver::make<BalanceRail>();
+    }
+
+    ~BalanceRail() override
+    {
+        LeakObserver::release<BalanceRail>();
+    }
+
+public:
+    // Fails when the rail already has an observer
+    bool attach(const ObserverPtr &observer, const std::shared_ptr<BalanceParent> &parent, const WorkerPtr &worker)
+    {
+        if (mSubscribed.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        mDownstream = observer;
+        mParent = parent;
+        mOwner = parent;
+        mWorker = worker;
+        observer->onSubscribe(shared_from_this());
+        return true;
+    }
+
+    bool isActive() const
+    {
+        return !mDisposed.load(std::memory_order_acquire) && !mTerminated.load(std::memory_order_acquire);
+    }
+
+    // Values queued or being delivered
+    uint64_t outstanding() const
+    {
+        return mOutstanding.load(std::memory_order_acquire);
+    }
+
+    // Only called by the upstream thread, fails once the rail is disposed so the value can go to another rail
+    bool offer(const GAny &value)
+    {
+        {
+            GLockerGuard lock(mOfferLock);
+            if (!isActive()) {
+                return false;
+            }
+            mOutstanding.fetch_add(1, std::memory_order_acq_rel);
+            mQueue.offer(value);
+        }
+        signal();
+        return true;
+    }
+
+    void signal()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        std::weak_ptr<BalanceRail> weakSelf = shared_from_this();
+        mWorker->schedule([weakSelf] {
+            if (const auto self = weakSelf.lock()) {
+                self->drain();
+            }
+        });
+    }
+
+    // Wakes the rail only if it is not draining already, lets idle rails join in on shared work
+    void signalIfIdle()
+    {
+        if (mWip.load(std::memory_order_acquire) == 0) {
+            signal();
+        }
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    void drain();
+
+    void clear()
+    {
+        mQueue.clear();
+        mDownstream = nullptr;
+        mParent = nullptr;
+        if (mWorker) {
+            mWorker->dispose();
+        }
+    }
+
+private:
+    SpscQueue mQueue;
+    std::atomic<uint64_t> mOutstanding = 0;
+    ObserverPtr mDownstream;
+    std::shared_ptr<BalanceParent> mParent; // Released by the draining thread on termination
+    std::weak_ptr<BalanceParent> mOwner;    // Set once in attach(), used by dispose()
+    WorkerPtr mWorker;
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mSubscribed = false;
+    std::atomic<bool> mTerminated = false;
+    std::atomic<bool> mDisposed = false;
+    GMutex mOfferLock; // Orders offer() against dispose(), nothing is queued once dispose() marked the rail
+};
+
+// Upstream side of balance(): hands every value to exactly one rail. The upstream is subscribed once all
+// rails have an observer and disposed once all of them went away.
+class BalanceParent : public Observer, public std::enable_shared_from_this<BalanceParent>
+{
+public:
+    BalanceParent(ObservableSourcePtr source, uint32_t count, BalanceStrategy strategy, SchedulerPtr scheduler,
+                  uint64_t capacity)
+        : mSource(std::move(source)),
+          mStrategy(strategy),
+          mScheduler(std::move(scheduler)),
+          mShared(strategy == BalanceStrategy::WorkStealing ? capacity : 2)
+    {
+        LeakObserver::make<BalanceParent>();
+        mRails.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            mRails.push_back(std::make_shared<BalanceRail>());
+        }
+    }
+
+    ~BalanceParent() override
+    {
+        LeakObserver::release<BalanceParent>();
+    }
+
+public:
+    void subscribeRail(size_t index, const ObserverPtr &observer)
+    {
+        if (!mRails[index]->attach(observer, shared_from_this(), mScheduler->createWorker())) {
+            EmptyDisposable::error(observer.get(), GAnyException("Balance rail allows only a single observer"));
+            return;
+        }
+        if (mAttached.fetch_add(1, std::memory_order_acq_rel) + 1 == mRails.size()) {
+            mSource->subscribe(shared_from_this());
+        }
+    }
+
+    void railDisposed()
+    {
+        if (mDisposedRails.fetch_add(1, std::memory_order_acq_rel) + 1 == mRails.size()) {
+            DisposableHelper::dispose(mUpstream, mLock);
+            mPark.wake();
+        }
+    }
+
+    bool isWorkStealing() const
+    {
+        return mStrategy == BalanceStrategy::WorkStealing;
+    }
+
+    bool pollShared(GAny &value)
+    {
+        if (!mShared.poll(value)) {
+            return false;
+        }
+        mPark.wake();
+        return true;
+    }
+
+    bool isDone() const
+    {
+        return mDone.load(std::memory_order_acquire);
+    }
+
+    // Valid once isDone() returned true
+    const std::unique_ptr<GAnyException> &error() const
+    {
+        return mError;
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        DisposableHelper::setOnce(mUpstream, d, mLock);
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (isDone()) {
+            return;
+        }
+        switch (mStrategy) {
+            case BalanceStrategy::RoundRobin:
+                for (size_t i = 0; i < mRails.size(); ++i) {
+                    if (mRails[mNext++ % mRails.size()]->offer(value)) {
+                        return;
+                    }
+                }
+                break;
+            case BalanceStrategy::LeastOutstanding:
+                // A rail disposed since it was picked refuses the value, every retry has one rail less to pick from
+                while (true) {
+                    // Ties go to the rail after the last pick, so equally idle rails take turns
+                    const BalanceRail *best = nullptr;
+                    uint64_t bestOutstanding = 0;
+                    size_t bestIndex = 0;
+                    for (size_t i = 0; i < mRails.size(); ++i) {
+                        const size_t index = (mNext + i) % mRails.size();
+                        const auto &rail = mRails[index];
+                        if (!rail->isActive()) {
+                            continue;
+                        }
+                        const uint64_t outstanding = rail->outstanding();
+                        if (!best || outstanding < bestOutstanding) {
+                            best = rail.get();
+                            bestOutstanding = outstanding;
+                            bestIndex = index;
+                        }
+                    }
+                    if (!best) {
+                        return;
+                    }
+                    mNext = bestIndex + 1;
+                    if (mRails[bestIndex]->offer(value)) {
+                        return;
+                    }
+                }
+            case BalanceStrategy::WorkStealing:
+                // A full queue parks the producer until some rail frees a cell
+                while (!mShared.offer(value)) {
+                    if (allRailsDisposed()) {
+                        return;
+                    }
+                    bool offered = false;
+                    mPark.parkWhile([this, &value, &offered] {
+                        offered = mShared.offer(value);
+                        return !offered && !allRailsDisposed();
+                    });
+                    if (offered) {
+                        break;
+                    }
+                }
+                signalShared();
+                break;
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (isDone()) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        terminate();
+    }
+
+    void onComplete() override
+    {
+        if (isDone()) {
+            return;
+        }
+        terminate();
+    }
+
+private:
+    bool allRailsDisposed() const
+    {
+        return mDisposedRails.load(std::memory_order_acquire) == mRails.size();
+    }
+
+    // One active rail is always signalled so the value cannot be stranded, idle ones are woken to steal it.
+    // A disposed rail would drop the signal, so the forced one is the next rail that is still active.
+    void signalShared()
+    {
+        const BalanceRail *forced = nullptr;
+        for (size_t i = 0; i < mRails.size(); ++i) {
+            const auto &rail = mRails[mNext++ % mRails.size()];
+            if (rail->isActive()) {
+                rail->signal();
+                forced = rail.get();
+                break;
+            }
+        }
+        for (const auto &other: mRails) {
+            if (other.get() != forced) {
+                other->signalIfIdle();
+            }
+        }
+    }
+
+    void terminate()
+    {
+        {
+            GLockerGuard lock(mLock);
+            mUpstream = DisposableHelper::disposed();
+        }
+        mDone.store(true, std::memory_order_release);
+        for (const auto &rail: mRails) {
+            rail->signal();
+        }
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    BalanceStrategy mStrategy;
+    SchedulerPtr mScheduler;
+    std::vector<std::shared_ptr<BalanceRail> > mRails;
+    MpmcQueue mShared; // WorkStealing only
+    size_t mNext = 0;  // Upstream thread only
+
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+    std::atomic<size_t> mAttached = 0;
+    std::atomic<size_t> mDisposedRails = 0;
+
+    DisposablePtr mUpstream;
+    GMutex mLock;
+
+    ProducerPark mPark; // WorkStealing only
+};
+
+class ObservableBalanceRail : public Observable
+{
+public:
+    ObservableBalanceRail(std::shared_ptr<BalanceParent> parent, size_t index)
+        : mParent(std::move(parent)), mIndex(index)
+    {
+        LeakObserver::make<ObservableBalanceRail>();
+    }
+
+    ~ObservableBalanceRail() override
+    {
+        LeakObserver::release<ObservableBalanceRail>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mParent->subscribeRail(mIndex, observer);
+    }
+
+private:
+    std::shared_ptr<BalanceParent> mParent;
+    size_t mIndex;
+};
+
+inline void BalanceRail::drain()
+{
+    uint32_t missed = 1;
+    while (true) {
+        while (true) {
+            if (isDisposed()) {
+                clear();
+                return;
+            }
+            const auto &parent = mParent;
+            const bool done = parent->isDone();
+            if (done && parent->error()) {
+                mTerminated.store(true, std::memory_order_release);
+                const auto downstream = std::move(mDownstream);
+                const auto terminalParent = std::move(mParent);
+                clear();
+                downstream->onError(*terminalParent->error());
+                return;
+            }
+
+            GAny value;
+            if (parent->isWorkStealing()) {
+                if (parent->pollShared(value)) {
+                    mDownstream->onNext(value);
+                    continue;
+                }
+            } else if (mQueue.poll(value)) {
+                mDownstream->onNext(value);
+                mOutstanding.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
+            if (done) {
+                mTerminated.store(true, std::memory_order_release);
+                const auto downstream = std::move(mDownstream);
+                clear();
+                downstream->onComplete();
+                return;
+            }
+            break;
+        }
+
+        missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+        if (missed == 0) {
+            return;
+        }
+    }
+}
+
+inline void BalanceRail::dispose()
+{
+    {
+        GLockerGuard lock(mOfferLock);
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+    if (const auto parent = mOwner.lock()) {
+        parent->railDisposed();
+    }
+    // Let the running drain, or this call if none is running, release the queue and the observer
+    if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        clear();
+    }
+}
+} // rx
+
+#endif //RX_OBSERVABLE_BALANCE_H
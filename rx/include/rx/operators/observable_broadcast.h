@@ -0,0 +1,462 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_BROADCAST_H
+#define RX_OBSERVABLE_BROADCAST_H
+
+#include "../connectable_observable.h"
+#include "../scheduler.h"
+#include "../subscriber_array.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+#include "../producer_park.h"
+
+#include <gx/gmutex.h>
+
+#include <atomic>
+#include <bit>
+#include <thread>
+#include <vector>
+
+
+namespace rx
+{
+class BroadcastRing;
+class ObservableBroadcast;
+
+// One consumer of a broadcast ring. It reads published slots in place on its own worker and advances
+// its sequence behind them, which is what lets the producer reuse those slots.
+class BroadcastConsumer : public Disposable, public std::enable_shared_from_this<BroadcastConsumer>
+{
+public:
+    BroadcastConsumer(const ObserverPtr &downstream, const std::shared_ptr<BroadcastRing> &ring, const WorkerPtr &worker)
+        : mDownstream(downstream), mRing(ring), mOwner(ring), mWorker(worker)
+    {
+        LeakObserver::make<BroadcastConsumer>();
+    }
+
+    ~BroadcastConsumer() override
+    {
+        LeakObserver::release<BroadcastConsumer>();
+    }
+
+public:
+    int64_t sequence() const
+    {
+        return mSequence.load();
+    }
+
+    void setSequence(int64_t sequence)
+    {
+        mSequence.store(sequence);
+    }
+
+    // New slots were published or the ring terminated
+    void signal()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        std::weak_ptr<BroadcastConsumer> weakSelf = shared_from_this();
+        mWorker->schedule([weakSelf] {
+            if (const auto self = weakSelf.lock()) {
+                self->drain();
+            }
+        });
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    void drain();
+
+    void clear()
+    {
+        mDownstream = nullptr;
+        mRing = nullptr;
+        mWorker->dispose();
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::shared_ptr<BroadcastRing> mRing; // Owned by the draining thread, released on termination
+    std::weak_ptr<BroadcastRing> mOwner;  // Never reassigned, used by dispose()
+    WorkerPtr mWorker;
+    std::atomic<int64_t> mSequence = -1; // Last consumed sequence, sequentially consistent for the park handshake
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mDisposed = false;
+};
+
+// Disruptor-style ring for one connection of broadcast(): a preallocated power-of-two array of slots,
+// a single producer sequence and one sequence per consumer. The producer only claims a slot once the
+// slowest consumer has moved past its previous occupant, and waits for that according to the WaitStrategy.
+class BroadcastRing : public Observer, public Disposable, public std::enable_shared_from_this<BroadcastRing>
+{
+public:
+    BroadcastRing(const std::weak_ptr<ObservableBroadcast> &parent, uint64_t capacity, WaitStrategy waitStrategy)
+        : mParent(parent),
+          mSlots(std::bit_ceil(capacity)),
+          mMask(static_cast<int64_t>(mSlots.size()) - 1),
+          mWaitStrategy(waitStrategy)
+    {
+        LeakObserver::make<BroadcastRing>();
+    }
+
+    ~BroadcastRing() override
+    {
+        LeakObserver::release<BroadcastRing>();
+    }
+
+public:
+    // Fails once the ring has terminated or was disposed
+    bool add(const std::shared_ptr<BroadcastConsumer> &consumer)
+    {
+        // Start behind the current cursor, then again after joining the gating set: a producer that
+        // checked the gates before this consumer joined may have lapped the first snapshot
+        consumer->setSequence(cursor());
+        if (!mConsumers.add(consumer)) {
+            return false;
+        }
+        consumer->setSequence(cursor());
+        return true;
+    }
+
+    void remove(const BroadcastConsumer *consumer)
+    {
+        mConsumers.remove(consumer);
+        wakeProducer();
+    }
+
+    bool tryConnect()
+    {
+        return !mConnected.exchange(true, std::memory_order_acq_rel);
+    }
+
+    int64_t cursor() const
+    {
+        return mCursor.load(std::memory_order_acquire);
+    }
+
+    const GAny &slot(int64_t sequence) const
+    {
+        return mSlots[sequence & mMask];
+    }
+
+    bool isDone() const
+    {
+        return mDone.load(std::memory_order_acquire);
+    }
+
+    const std::unique_ptr<GAnyException> &error() const
+    {
+        return mError;
+    }
+
+    // Called by consumers after advancing, only takes the lock while the producer is parked
+    void wakeProducer()
+    {
+        mPark.wake();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        DisposableHelper::setOnce(mUpstream, d, mLock);
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (isDone() || isDisposed()) {
+            return;
+        }
+        const int64_t next = mNext + 1;
+        const int64_t wrapPoint = next - static_cast<int64_t>(mSlots.size());
+        if (wrapPoint > mGatingCache && !waitForConsumers(wrapPoint, next - 1)) {
+            return;
+        }
+        mSlots[next & mMask] = value;
+        mNext = next;
+        mCursor.store(next, std::memory_order_release);
+
+        const auto consumers = mConsumers.load();
+        for (const auto &consumer: *consumers) {
+            consumer->signal();
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (isDone()) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        terminate();
+    }
+
+    void onComplete() override
+    {
+        if (isDone()) {
+            return;
+        }
+        terminate();
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    int64_t minimumSequence(int64_t defaultValue) const
+    {
+        int64_t minimum = defaultValue;
+        const auto consumers = mConsumers.load();
+        for (const auto &consumer: *consumers) {
+            minimum = std::min(minimum, consumer->sequence());
+        }
+        return minimum;
+    }
+
+    // Blocks the producer until every consumer has read past wrapPoint, false if the ring was disposed meanwhile
+    bool waitForConsumers(int64_t wrapPoint, int64_t current)
+    {
+        while (true) {
+            const int64_t minimum = minimumSequence(current);
+            if (minimum >= wrapPoint) {
+                mGatingCache = minimum;
+                return true;
+            }
+            if (isDisposed()) {
+                return false;
+            }
+            switch (mWaitStrategy) {
+                case WaitStrategy::BusySpin:
+                    break;
+                case WaitStrategy::Yield:
+                    std::this_thread::yield();
+                    break;
+                case WaitStrategy::Park: {
+                    mPark.parkWhile([this, current, wrapPoint] {
+                        return minimumSequence(current) < wrapPoint && !isDisposed();
+                    });
+                    break;
+                }
+            }
+        }
+    }
+
+    void terminate()
+    {
+        {
+            GLockerGuard lock(mLock);
+            mUpstream = DisposableHelper::disposed();
+        }
+        mDone.store(true, std::memory_order_release);
+        const auto consumers = mConsumers.terminate();
+        for (const auto &consumer: *consumers) {
+            consumer->signal();
+        }
+    }
+
+private:
+    std::weak_ptr<ObservableBroadcast> mParent;
+    std::vector<GAny> mSlots;
+    const int64_t mMask;
+    const WaitStrategy mWaitStrategy;
+    SubscriberArray<BroadcastConsumer> mConsumers;
+
+    // Producer side
+    int64_t mNext = -1;
+    int64_t mGatingCache = -1;
+    std::atomic<int64_t> mCursor = -1; // Last published sequence
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+
+    ProducerPark mPark;
+
+    DisposablePtr mUpstream;
+    GMutex mLock;
+    std::atomic<bool> mConnected = false;
+    std::atomic<bool> mDisposed = false;
+};
+
+class ObservableBroadcast : public ConnectableObservable
+{
+public:
+    ObservableBroadcast(ObservableSourcePtr source, uint64_t capacity, WaitStrategy waitStrategy, SchedulerPtr scheduler)
+        : mSource(std::move(source)),
+          mCapacity(capacity),
+          mWaitStrategy(waitStrategy),
+          mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableBroadcast>();
+    }
+
+    ~ObservableBroadcast() override
+    {
+        LeakObserver::release<ObservableBroadcast>();
+    }
+
+public:
+    using ConnectableObservable::connect;
+
+    void connect(const ConnectionCallback &onConnect) override
+    {
+        std::shared_ptr<BroadcastRing> ring;
+        while (true) {
+            ring = mCurrent.load(std::memory_order_acquire);
+            if (!ring || ring->isDisposed()) {
+                auto fresh = std::make_shared<BroadcastRing>(self(), mCapacity, mWaitStrategy);
+                if (!mCurrent.compare_exchange_strong(ring, fresh, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                ring = std::move(fresh);
+            }
+            break;
+        }
+
+        const bool doConnect = ring->tryConnect();
+        if (onConnect) {
+            onConnect(ring);
+        }
+        if (doConnect) {
+            mSource->subscribe(ring);
+        }
+    }
+
+    void reset() override
+    {
+        auto ring = mCurrent.load(std::memory_order_acquire);
+        if (ring && ring->isDisposed()) {
+            mCurrent.compare_exchange_strong(ring, nullptr, std::memory_order_acq_rel);
+        }
+    }
+
+    // Called by a disposed ring so the next connect() or subscriber starts a fresh one
+    void clearCurrent(const std::shared_ptr<BroadcastRing> &ring)
+    {
+        auto expected = ring;
+        mCurrent.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        std::shared_ptr<BroadcastRing> ring;
+        while (true) {
+            ring = mCurrent.load(std::memory_order_acquire);
+            if (!ring) {
+                auto fresh = std::make_shared<BroadcastRing>(self(), mCapacity, mWaitStrategy);
+                if (!mCurrent.compare_exchange_strong(ring, fresh, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                ring = std::move(fresh);
+            }
+            break;
+        }
+
+        const auto consumer = std::make_shared<BroadcastConsumer>(observer, ring, mScheduler->createWorker());
+        observer->onSubscribe(consumer);
+        if (ring->add(consumer)) {
+            if (consumer->isDisposed()) {
+                ring->remove(consumer.get());
+            }
+            return;
+        }
+        // Terminated ring: the consumer only delivers the terminal event
+        consumer->signal();
+    }
+
+private:
+    std::weak_ptr<ObservableBroadcast> self()
+    {
+        return std::static_pointer_cast<ObservableBroadcast>(shared_from_this());
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    uint64_t mCapacity;
+    WaitStrategy mWaitStrategy;
+    SchedulerPtr mScheduler;
+    std::atomic<std::shared_ptr<BroadcastRing> > mCurrent;
+};
+
+inline void BroadcastConsumer::drain()
+{
+    uint32_t missed = 1;
+    while (true) {
+        if (isDisposed()) {
+            clear();
+            return;
+        }
+        const auto &ring = mRing;
+        // Read the terminal flag first, everything published before it is then visible through the cursor
+        const bool done = ring->isDone();
+        const int64_t available = ring->cursor();
+        int64_t sequence = mSequence.load(std::memory_order_relaxed);
+        while (sequence < available) {
+            if (isDisposed()) {
+                clear();
+                return;
+            }
+            mDownstream->onNext(ring->slot(sequence + 1));
+            mSequence.store(++sequence);
+            ring->wakeProducer();
+        }
+        if (done) {
+            // The WIP count stays taken, so nothing is delivered afterwards
+            const auto downstream = std::move(mDownstream);
+            const auto terminalRing = std::move(mRing);
+            mWorker->dispose();
+            if (const auto &error = terminalRing->error()) {
+                downstream->onError(*error);
+            } else {
+                downstream->onComplete();
+            }
+            return;
+        }
+
+        missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+        if (missed == 0) {
+            return;
+        }
+    }
+}
+
+inline void BroadcastConsumer::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (const auto ring = mOwner.lock()) {
+        ring->remove(this);
+    }
+    // Let the running drain, or this call if none is running, release the ring
+    if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        clear();
+    }
+}
+
+inline void BroadcastRing::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    mConsumers.terminate();
+    wakeProducer();
+    if (const auto parent = mParent.lock()) {
+        parent->clearCurrent(shared_from_this());
+    }
+    DisposableHelper::dispose(mUpstream, mLock);
+}
+} // rx
+
+#endif //RX_OBSERVABLE_BROADCAST_H
@@ -8,6 +8,10 @@
 #include "../observable.h"
 #include "../disposables/disposable_helper.h"
 #include "../leak_observer.h"
+#include "../array_view.h"
+
+#include <algorithm>
+#include <limits>
 
 
 namespace rx
@@ -15,10 +19,11 @@ namespace rx
 class BufferExactObserver : public Observer, public Disposable, public std::enable_shared_from_this<BufferExactObserver>
 {
 public:
-    explicit BufferExactObserver(const ObserverPtr &observer, uint64_t count)
-        : mDownstream(observer), mCount(count)
+    explicit BufferExactObserver(const ObserverPtr &observer, uint64_t count, bool views = false)
+        : mDownstream(observer), mCount(count), mViews(views)
     {
         LeakObserver::make<BufferExactObserver>();
+        mBuffer.reserve(std::min<uint64_t>(count, 1024));
     }
 
     ~BufferExactObserver() override
@@ -43,7 +48,7 @@ public:
 
         if (mBuffer.size() >= mCount) {
             if (const auto d = mDownstream) {
-                d->onNext(mBuffer);
+                emit(d);
             }
             mBuffer.clear();
         }
@@ -64,7 +69,7 @@ public:
     {
         if (const auto d = mDownstream) {
             if (!mBuffer.empty()) {
-                d->onNext(mBuffer);
+                emit(d);
             }
             mBuffer.clear();
             d->onComplete();
@@ -91,18 +96,39 @@ public:
         return true;
     }
 
+private:
+    // Hands the finished batch over instead of copying it, the next batch starts from a fresh reservation
+    void emit(const ObserverPtr &downstream)
+    {
+        std::vector<GAny> batch;
+        batch.reserve(std::min<uint64_t>(mCount, 1024));
+        std::swap(batch, mBuffer);
+        if (mViews) {
+            downstream->onNext(ArrayView::of(std::move(batch)));
+        } else {
+            downstream->onNext(std::move(batch));
+        }
+    }
+
 private:
     ObserverPtr mDownstream;
     DisposablePtr mUpstream;
     uint64_t mCount;
+    bool mViews;
     std::vector<GAny> mBuffer;
 };
 
+// Overlapping and gapped buffers share one append-only segment of recent values.
+// A finished window is emitted as an ArrayView into the segment (or copied out when vectors are wanted),
+// so each value is stored once rather than once per open window. When the segment fills up, only the
+// values still needed by open windows are carried over into a new one, older segments live on only as
+// long as views reference them. Segments start small and double per rollover up to a few windows long.
 class BufferSkipObserver : public Observer, public Disposable, public std::enable_shared_from_this<BufferSkipObserver>
 {
 public:
-    explicit BufferSkipObserver(const ObserverPtr &observer, uint64_t count, uint64_t skip)
-        : mDownstream(observer), mCount(count), mSkip(skip)
+    explicit BufferSkipObserver(const ObserverPtr &observer, uint64_t count, uint64_t skip, bool views = false)
+        : mDownstream(observer), mCount(count), mSkip(skip), mViews(views),
+          mMaxSegmentCapacity(std::max(std::min(count, std::numeric_limits<uint64_t>::max() / 4) * 4, InitialSegmentCapacity))
     {
         LeakObserver::make<BufferSkipObserver>();
     }
@@ -126,26 +152,21 @@ public:
     void onNext(const GAny &value) override
     {
         if (const auto d = mDownstream) {
-            if (mIndex++ % mSkip == 0) {
-                mBuffers.push_back({});
+            const uint64_t index = mIndex++;
+            if (index % mSkip >= mCount) {
+                return; // Gap between windows
             }
+            append(index, value);
 
-            for (auto it = mBuffers.begin(); it != mBuffers.end();) {
-                auto &buffer = *it;
-                buffer.push_back(value);
-                if (mCount <= buffer.size()) {
-                    d->onNext(buffer);
-                    it = mBuffers.erase(it);
-                } else {
-                    ++it;
-                }
+            if (mIndex >= mCount && (mIndex - mCount) % mSkip == 0) {
+                d->onNext(window(mIndex - mCount, mIndex));
             }
         }
     }
 
     void onError(const GAnyException &e) override
     {
-        mBuffers.clear();
+        mSegment = nullptr;
         if (const auto d = mDownstream) {
             d->onError(e);
         }
@@ -157,10 +178,10 @@ public:
     void onComplete() override
     {
         if (const auto d = mDownstream) {
-            for (auto it = mBuffers.begin(); it != mBuffers.end(); ++it) {
-                d->onNext(*it);
+            for (uint64_t start = firstOpenWindow(mIndex); start < mIndex; start += mSkip) {
+                d->onNext(window(start, mIndex));
             }
-            mBuffers.clear();
+            mSegment = nullptr;
             d->onComplete();
         }
 
@@ -185,20 +206,77 @@ public:
         return true;
     }
 
+private:
+    // Start of the oldest window that has not been emitted once `end` values were received
+    uint64_t firstOpenWindow(uint64_t end) const
+    {
+        if (end < mCount) {
+            return 0;
+        }
+        const uint64_t oldest = end - mCount + 1;
+        return (oldest + mSkip - 1) / mSkip * mSkip;
+    }
+
+    void append(uint64_t index, const GAny &value)
+    {
+        if (!mSegment || mSegment->empty() || index != mSegmentBase + mSegment->size()) {
+            // First value or first value after a gap, nothing has to be carried over
+            newSegment(index, mSegment ? mSegment->size() : 0);
+        } else if (mSegment->size() == mSegment->capacity()) {
+            mSegmentCapacity = std::min(mSegmentCapacity * 2, mMaxSegmentCapacity);
+            const uint64_t carryFrom = std::max(firstOpenWindow(index), mSegmentBase);
+            newSegment(carryFrom, carryFrom - mSegmentBase);
+        }
+        mSegment->push_back(value);
+    }
+
+    void newSegment(uint64_t base, uint64_t carryOffset)
+    {
+        // Reuse the current storage when nothing is carried and no view still references it
+        if (mSegment && mSegment.use_count() == 1 && carryOffset == mSegment->size()) {
+            mSegment->clear();
+        } else {
+            auto segment = std::make_shared<std::vector<GAny> >();
+            segment->reserve(mSegmentCapacity);
+            if (mSegment) {
+                segment->insert(segment->end(), mSegment->begin() + static_cast<ptrdiff_t>(carryOffset), mSegment->end());
+            }
+            mSegment = std::move(segment);
+        }
+        mSegmentBase = base;
+    }
+
+    GAny window(uint64_t start, uint64_t end) const
+    {
+        // A segment never reallocates (full ones are replaced), so the span stays valid while it is appended to
+        const std::span<const GAny> items(mSegment->data() + (start - mSegmentBase), end - start);
+        if (mViews) {
+            return std::make_shared<ArrayView>(items, mSegment);
+        }
+        return std::vector<GAny>(items.begin(), items.end());
+    }
+
 private:
     ObserverPtr mDownstream;
     DisposablePtr mUpstream;
     uint64_t mCount;
     uint64_t mSkip;
+    bool mViews;
     uint64_t mIndex = 0;
-    std::vector<std::vector<GAny> > mBuffers;
+
+    static constexpr uint64_t InitialSegmentCapacity = 256;
+
+    uint64_t mMaxSegmentCapacity;
+    uint64_t mSegmentCapacity = InitialSegmentCapacity; // Reservation of the next segment, grows up to mMaxSegmentCapacity
+    uint64_t mSegmentBase = 0;
+    std::shared_ptr<std::vector<GAny> > mSegment;
 };
 
 class ObservableBuffer : public Observable
 {
 public:
-    explicit ObservableBuffer(ObservableSourcePtr source, uint64_t count, uint64_t skip)
-        : mSource(source), mCount(count), mSkip(skip)
+    explicit ObservableBuffer(ObservableSourcePtr source, uint64_t count, uint64_t skip, bool views = false)
+        : mSource(source), mCount(count), mSkip(skip), mViews(views)
     {
         LeakObserver::make<ObservableBuffer>();
     }
@@ -212,9 +290,9 @@ protected:
     void subscribeActual(const ObserverPtr &observer) override
     {
         if (mSkip == mCount) {
-            mSource->subscribe(std::make_shared<BufferExactObserver>(observer, mCount));
+            mSource->subscribe(std::make_shared<BufferExactObserver>(observer, mCount, mViews));
         } else {
-            mSource->subscribe(std::make_shared<BufferSkipObserver>(observer, mCount, mSkip));
+            mSource->subscribe(std::make_shared<BufferSkipObserver>(observer, mCount, mSkip, mViews));
         }
     }
 
@@ -222,6 +300,7 @@ private:
     ObservableSourcePtr mSource;
     uint64_t mCount;
     uint64_t mSkip;
+    bool mViews;
 };
 } // rx
 
@@ -0,0 +1,337 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_BUFFER_TIMED_H
+#define RX_OBSERVABLE_BUFFER_TIMED_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../disposables/sequential_disposable.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+
+#include <algorithm>
+#include <deque>
+
+
+namespace rx
+{
+// Time-bounded batching driven by a single timer task per subscription.
+// Exact mode (timeskip == 0): one buffer at a time, flushed every timespan or as soon as it holds maxCount
+// values, a size flush restarts the timer. Skip mode: a buffer opens every timeskip and closes timespan
+// after it opened. Empty batches are not emitted.
+// Finished batches are queued and emitted by whichever thread wins the WIP counter, so timer ticks
+// and upstream signals never reach the downstream concurrently or out of order.
+class BufferTimedObserver : public Observer, public Disposable, public std::enable_shared_from_this<BufferTimedObserver>
+{
+public:
+    BufferTimedObserver(const ObserverPtr &downstream, uint64_t timespan, uint64_t timeskip, uint64_t maxCount,
+                        const WorkerPtr &worker)
+        : mDownstream(downstream),
+          mTimespan(timespan),
+          mTimeskip(timeskip),
+          mMaxCount(maxCount),
+          mWorker(worker),
+          mTimer(std::make_shared<SequentialDisposable>())
+    {
+        LeakObserver::make<BufferTimedObserver>();
+    }
+
+    ~BufferTimedObserver() override
+    {
+        LeakObserver::release<BufferTimedObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+
+                GLockerGuard lock(mLock);
+                mStart = mWorker->now();
+                uint64_t delay = mTimespan;
+                if (mTimeskip > 0) {
+                    mOpen.push_back({mTimespan, newBatch()});
+                    mNextOpen = mTimeskip;
+                    delay = std::min(mTimespan, mTimeskip);
+                }
+                schedule(delay, 0);
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            if (mTimeskip > 0) {
+                for (auto &[closeAt, batch]: mOpen) {
+                    batch.push_back(value);
+                }
+                return;
+            }
+            mBatch.push_back(value);
+            if (mMaxCount == 0 || mBatch.size() < mMaxCount) {
+                return;
+            }
+            flush(mBatch);
+            schedule(mTimespan, ++mGeneration);
+        }
+        drain();
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            mTerminated = true;
+            mError = std::make_unique<GAnyException>(e);
+            mBatch.clear();
+            mOpen.clear();
+            mReady.clear();
+        }
+        mTimer->dispose();
+        drain();
+    }
+
+    void onComplete() override
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            mTerminated = true;
+            flush(mBatch);
+            for (auto &[closeAt, batch]: mOpen) {
+                flush(batch);
+            }
+            mOpen.clear();
+        }
+        mTimer->dispose();
+        drain();
+    }
+
+    void dispose() override
+    {
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto d = mUpstream) {
+            d->dispose();
+        }
+        mTimer->dispose();
+        mWorker->dispose();
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    // Called with mLock held so the timer of the newest generation is always the one that stays scheduled
+    void schedule(uint64_t delay, uint64_t generation)
+    {
+        std::weak_ptr<BufferTimedObserver> weakSelf = shared_from_this();
+        mTimer->update(mWorker->schedule([weakSelf, generation] {
+            if (const auto self = weakSelf.lock()) {
+                self->tick(generation);
+            }
+        }, delay));
+    }
+
+    void tick(uint64_t generation)
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated || mCancelled.load(std::memory_order_acquire)) {
+                return;
+            }
+            if (mTimeskip == 0) {
+                // A size flush restarted the timer, this tick belongs to the previous batch
+                if (generation != mGeneration) {
+                    return;
+                }
+                flush(mBatch);
+                schedule(mTimespan, ++mGeneration);
+            } else {
+                const uint64_t elapsed = (mWorker->now() - mStart) / 1000000;
+                while (!mOpen.empty() && mOpen.front().first <= elapsed) {
+                    flush(mOpen.front().second);
+                    mOpen.pop_front();
+                }
+                while (mNextOpen <= elapsed) {
+                    mOpen.push_back({mNextOpen + mTimespan, newBatch()});
+                    mNextOpen += mTimeskip;
+                }
+                const uint64_t next = mOpen.empty() ? mNextOpen : std::min(mNextOpen, mOpen.front().first);
+                schedule(std::max<uint64_t>(next - elapsed, 1), generation);
+            }
+        }
+        drain();
+    }
+
+    // Queues a finished batch and remembers its size so the next batch reserves about as much up front
+    void flush(std::vector<GAny> &batch)
+    {
+        if (batch.empty()) {
+            return;
+        }
+        mSizeHint = batch.size();
+        mReady.push_back(std::move(batch));
+        batch = newBatch();
+    }
+
+    std::vector<GAny> newBatch() const
+    {
+        std::vector<GAny> batch;
+        batch.reserve(mMaxCount > 0 ? std::min<size_t>(mSizeHint, mMaxCount) : mSizeHint);
+        return batch;
+    }
+
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        while (true) {
+            while (true) {
+                if (mCancelled.load(std::memory_order_acquire)) {
+                    clear();
+                    return;
+                }
+
+                std::vector<GAny> batch;
+                bool hasBatch = false;
+                bool terminated;
+                {
+                    GLockerGuard lock(mLock);
+                    if (!mReady.empty()) {
+                        batch = std::move(mReady.front());
+                        mReady.pop_front();
+                        hasBatch = true;
+                    }
+                    terminated = mTerminated;
+                }
+
+                if (hasBatch) {
+                    if (const auto ds = mDownstream) {
+                        ds->onNext(std::move(batch));
+                    }
+                    continue;
+                }
+                if (terminated) {
+                    terminate();
+                    return;
+                }
+                break;
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    // Disposes the worker first, a timer firing now can no longer flush a buffer behind the terminal
+    void terminate()
+    {
+        mWorker->dispose();
+        const auto downstream = std::move(mDownstream);
+        mUpstream = nullptr;
+        if (downstream) {
+            if (mError) {
+                downstream->onError(*mError);
+            } else {
+                downstream->onComplete();
+            }
+        }
+    }
+
+    void clear()
+    {
+        {
+            GLockerGuard lock(mLock);
+            mBatch.clear();
+            mOpen.clear();
+            mReady.clear();
+        }
+        mDownstream = nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    uint64_t mTimespan;
+    uint64_t mTimeskip;
+    uint64_t mMaxCount;
+    WorkerPtr mWorker;
+    std::shared_ptr<SequentialDisposable> mTimer;
+
+    GMutex mLock;
+    std::vector<GAny> mBatch;                                   // Exact mode
+    uint64_t mGeneration = 0;                                   // Exact mode, bumped whenever the timer restarts
+    std::deque<std::pair<uint64_t, std::vector<GAny> > > mOpen; // Skip mode, (close time in ms since start, batch)
+    uint64_t mNextOpen = 0;                                     // Skip mode, ms since start
+    uint64_t mStart = 0;
+    size_t mSizeHint = 0;
+    std::deque<std::vector<GAny> > mReady;
+    bool mTerminated = false;
+    std::unique_ptr<GAnyException> mError;
+
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mCancelled = false;
+};
+
+class ObservableBufferTimed : public Observable
+{
+public:
+    ObservableBufferTimed(ObservableSourcePtr source, uint64_t timespan, uint64_t timeskip, uint64_t maxCount,
+                          SchedulerPtr scheduler)
+        : mSource(std::move(source)),
+          mTimespan(timespan),
+          mTimeskip(timeskip),
+          mMaxCount(maxCount),
+          mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableBufferTimed>();
+    }
+
+    ~ObservableBufferTimed() override
+    {
+        LeakObserver::release<ObservableBufferTimed>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<BufferTimedObserver>(observer, mTimespan, mTimeskip, mMaxCount,
+                                                                 mScheduler->createWorker()));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    uint64_t mTimespan;
+    uint64_t mTimeskip;
+    uint64_t mMaxCount;
+    SchedulerPtr mScheduler;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_BUFFER_TIMED_H
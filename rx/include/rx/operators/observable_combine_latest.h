@@ -9,32 +9,56 @@
 #include "../observable.h"
 #include "../exception_helper.h"
 #include "../leak_observer.h"
+#include <algorithm>
+#include <memory>
 #include <mutex>
 
 
 namespace rx
 {
-class CombineLatestObserver;
-
+template<typename Parent>
 class CombineLatestInnerObserver : public Observer
 {
 public:
-    CombineLatestInnerObserver(const std::shared_ptr<CombineLatestObserver> &parent, size_t index)
+    CombineLatestInnerObserver(const std::shared_ptr<Parent> &parent, size_t index)
         : mParent(parent), mIndex(index)
     {
     }
 
 public:
-    void onSubscribe(const DisposablePtr &d) override;
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (const auto parent = mParent.lock()) {
+            mUpstream = d;
+            parent->onSubscribe(mIndex, d);
+        } else {
+            d->dispose();
+        }
+    }
 
-    void onNext(const GAny &value) override;
+    void onNext(const GAny &value) override
+    {
+        if (const auto parent = mParent.lock()) {
+            parent->onNext(mIndex, value);
+        }
+    }
 
-    void onError(const GAnyException &e) override;
+    void onError(const GAnyException &e) override
+    {
+        if (const auto parent = mParent.lock()) {
+            parent->onError(e);
+        }
+    }
 
-    void onComplete() override;
+    void onComplete() override
+    {
+        if (const auto parent = mParent.lock()) {
+            parent->onComplete(mIndex);
+        }
+    }
 
 private:
-    std::weak_ptr<CombineLatestObserver> mParent;
+    std::weak_ptr<Parent> mParent;
     size_t mIndex;
     DisposablePtr mUpstream;
 };
@@ -63,7 +87,7 @@ public:
             if (mDone.load(std::memory_order_acquire)) {
                 break;
             }
-            auto inner = std::make_shared<CombineLatestInnerObserver>(this->shared_from_this(), i);
+            auto inner = std::make_shared<CombineLatestInnerObserver<CombineLatestObserver> >(this->shared_from_this(), i);
             sources[i]->subscribe(inner);
         }
     }
@@ -199,6 +223,7 @@ public:
 
     void dispose() override
     {
+        mDisposed.store(true, std::memory_order_release);
         std::lock_guard<std::recursive_mutex> signalLock(mSignalLock);
         if (mDone.exchange(true, std::memory_order_acq_rel)) {
             return;
@@ -214,7 +239,7 @@ public:
 
     bool isDisposed() const override
     {
-        return mDone.load(std::memory_order_acquire);
+        return mDisposed.load(std::memory_order_acquire);
     }
 
 private:
@@ -244,47 +269,271 @@ private:
     size_t mInFlight = 0;
 
     std::vector<DisposablePtr> mDisposables;
-    std::atomic<bool> mDone = false;
+    std::atomic<bool> mDone = false; // Terminated or disposed
+    std::atomic<bool> mDisposed = false;
     GMutex mMutex;
     std::recursive_mutex mSignalLock;
 };
 
-inline void CombineLatestInnerObserver::onSubscribe(const DisposablePtr &d)
+// Coalescing mode: sources only store their latest value and bump a version, whichever thread wins the
+// WIP counter copies the changed slots into its own view and calls the combiner once per batch.
+class CombineLatestCoalescingObserver : public Disposable, public std::enable_shared_from_this<CombineLatestCoalescingObserver>
 {
-    if (const auto parent = mParent.lock()) {
-        mUpstream = d;
-        parent->onSubscribe(mIndex, d);
-    } else {
-        d->dispose();
+public:
+    CombineLatestCoalescingObserver(const ObserverPtr &downstream,
+                                    CombineLatestFunction combiner,
+                                    size_t count)
+        : mDownstream(downstream), mCombiner(std::move(combiner)), mValues(count), mVersions(count, 0),
+          mActiveCount(count), mView(count), mViewVersions(count, 0), mDisposables(count)
+    {
+        LeakObserver::make<CombineLatestCoalescingObserver>();
     }
-}
 
-inline void CombineLatestInnerObserver::onNext(const GAny &value)
-{
-    if (const auto parent = mParent.lock()) {
-        parent->onNext(mIndex, value);
+    ~CombineLatestCoalescingObserver() override
+    {
+        LeakObserver::release<CombineLatestCoalescingObserver>();
     }
-}
 
-inline void CombineLatestInnerObserver::onError(const GAnyException &e)
-{
-    if (const auto parent = mParent.lock()) {
-        parent->onError(e);
+public:
+    void subscribe(const std::vector<std::shared_ptr<Observable> > &sources)
+    {
+        for (size_t i = 0; i < sources.size(); ++i) {
+            if (mCancelled.load(std::memory_order_acquire)) {
+                break;
+            }
+            auto inner = std::make_shared<CombineLatestInnerObserver<CombineLatestCoalescingObserver> >(this->shared_from_this(), i);
+            sources[i]->subscribe(inner);
+        }
     }
-}
 
-inline void CombineLatestInnerObserver::onComplete()
-{
-    if (const auto parent = mParent.lock()) {
-        parent->onComplete(mIndex);
+    void onSubscribe(size_t index, const DisposablePtr &d)
+    {
+        bool disposeNow = false;
+        {
+            GLockerGuard lock(mMutex);
+            if (mCancelled.load(std::memory_order_acquire)) {
+                disposeNow = true;
+            } else {
+                mDisposables[index] = d;
+            }
+        }
+        if (disposeNow) {
+            d->dispose();
+        }
+    }
+
+    void onNext(size_t index, const GAny &value)
+    {
+        {
+            GLockerGuard lock(mMutex);
+            if (mTerminated) {
+                return;
+            }
+            mValues[index] = value;
+            if (mVersions[index]++ == 0) {
+                ++mEmittedCount;
+            }
+            ++mVersion;
+        }
+        drain();
+    }
+
+    void onError(const GAnyException &e)
+    {
+        {
+            GLockerGuard lock(mMutex);
+            if (mTerminated) {
+                return;
+            }
+            mTerminated = true;
+            mError = std::make_unique<GAnyException>(e);
+        }
+        drain();
+    }
+
+    void onComplete(size_t index)
+    {
+        {
+            GLockerGuard lock(mMutex);
+            if (mTerminated) {
+                return;
+            }
+            // A source that completes without a value means no combination can ever be produced
+            if (mVersions[index] == 0 || --mActiveCount == 0) {
+                mTerminated = true;
+            }
+        }
+        drain();
     }
-}
+
+    void dispose() override
+    {
+        mDisposeRequested.store(true, std::memory_order_release);
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        std::vector<DisposablePtr> disposables;
+        {
+            GLockerGuard lock(mMutex);
+            mTerminated = true;
+            takeDisposables(disposables);
+        }
+        disposeAll(disposables);
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposeRequested.load(std::memory_order_acquire);
+    }
+
+private:
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        while (true) {
+            while (true) {
+                if (mCancelled.load(std::memory_order_acquire)) {
+                    clear();
+                    return;
+                }
+
+                bool changed = false;
+                bool terminated;
+                bool errored;
+                {
+                    GLockerGuard lock(mMutex);
+                    errored = mError != nullptr;
+                    terminated = mTerminated;
+                    if (!errored && mEmittedCount == mValues.size() && mVersion != mViewVersion) {
+                        for (size_t i = 0; i < mValues.size(); ++i) {
+                            if (mViewVersions[i] != mVersions[i]) {
+                                mView[i] = mValues[i];
+                                mViewVersions[i] = mVersions[i];
+                            }
+                        }
+                        mViewVersion = mVersion;
+                        changed = true;
+                    }
+                }
+
+                if (errored) {
+                    // mError is written once before mTerminated, it no longer changes
+                    const GAnyException error = *mError;
+                    terminate([&error](const ObserverPtr &downstream) { downstream->onError(error); });
+                    return;
+                }
+                if (changed) {
+                    GAny result;
+                    try {
+                        result = mCombiner(mView);
+                    } catch (...) {
+                        const auto error = ExceptionHelper::fromCurrentException("CombineLatest: Combiner failed");
+                        terminate([&error](const ObserverPtr &downstream) { downstream->onError(error); });
+                        return;
+                    }
+                    if (!mCancelled.load(std::memory_order_acquire) && mDownstream) {
+                        mDownstream->onNext(result);
+                    }
+                    continue;
+                }
+                if (terminated) {
+                    terminate([](const ObserverPtr &downstream) { downstream->onComplete(); });
+                    return;
+                }
+                break;
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    // Disposes the sources before signalling, a source that emits while the downstream handles the terminal
+    // then finds the combine cancelled
+    template<typename Signal>
+    void terminate(const Signal &signal)
+    {
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        std::vector<DisposablePtr> disposables;
+        {
+            GLockerGuard lock(mMutex);
+            mTerminated = true;
+            takeDisposables(disposables);
+        }
+        disposeAll(disposables);
+        const ObserverPtr downstream = std::move(mDownstream);
+        clear();
+        if (downstream) {
+            signal(downstream);
+        }
+    }
+
+    void clear()
+    {
+        {
+            GLockerGuard lock(mMutex);
+            std::fill(mValues.begin(), mValues.end(), GAny());
+        }
+        std::fill(mView.begin(), mView.end(), GAny());
+        mDownstream = nullptr;
+    }
+
+    void takeDisposables(std::vector<DisposablePtr> &disposables)
+    {
+        disposables = std::move(mDisposables);
+        mDisposables.clear();
+    }
+
+    static void disposeAll(const std::vector<DisposablePtr> &disposables)
+    {
+        for (const auto &disposable: disposables) {
+            if (disposable) {
+                disposable->dispose();
+            }
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    CombineLatestFunction mCombiner;
+
+    // Written by sources under mMutex
+    std::vector<GAny> mValues;
+    std::vector<uint64_t> mVersions;
+    uint64_t mVersion = 0;
+    size_t mEmittedCount = 0;
+    size_t mActiveCount;
+    bool mTerminated = false;
+    std::unique_ptr<GAnyException> mError;
+
+    // Owned by the draining thread, handed to the combiner as a read-only view
+    std::vector<GAny> mView;
+    std::vector<uint64_t> mViewVersions;
+    uint64_t mViewVersion = 0;
+
+    std::vector<DisposablePtr> mDisposables;
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mCancelled = false;        // Set by whoever took over the downstream, a terminal event or dispose()
+    std::atomic<bool> mDisposeRequested = false; // Set by dispose() only
+    GMutex mMutex;
+};
 
 class ObservableCombineLatest : public Observable
 {
 public:
-    ObservableCombineLatest(std::vector<std::shared_ptr<Observable> > sources, CombineLatestFunction combiner)
-        : mSources(std::move(sources)), mCombiner(std::move(combiner))
+    ObservableCombineLatest(std::vector<std::shared_ptr<Observable> > sources, CombineLatestFunction combiner,
+                            CombineOptions options = {})
+        : mSources(std::move(sources)), mCombiner(std::move(combiner)), mOptions(options)
     {
         LeakObserver::make<ObservableCombineLatest>();
     }
@@ -302,6 +551,13 @@ protected:
             return;
         }
 
+        if (mOptions.coalesce) {
+            const auto parent = std::make_shared<CombineLatestCoalescingObserver>(observer, mCombiner, mSources.size());
+            observer->onSubscribe(parent);
+            parent->subscribe(mSources);
+            return;
+        }
+
         const auto parent = std::make_shared<CombineLatestObserver>(observer, mCombiner, mSources.size());
         observer->onSubscribe(parent);
         parent->subscribe(mSources);
@@ -310,6 +566,7 @@ protected:
 private:
     std::vector<std::shared_ptr<Observable> > mSources;
     CombineLatestFunction mCombiner;
+    CombineOptions mOptions;
 };
 } // namespace rx
 
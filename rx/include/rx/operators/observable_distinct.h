@@ -9,8 +9,11 @@
 #include "../exception_helper.h"
 #include "../disposables/disposable_helper.h"
 #include "../leak_observer.h"
+#include "../any_key.h"
 
-#include <vector>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 
 namespace rx
@@ -18,8 +21,8 @@ namespace rx
 class DistinctObserver : public Observer, public Disposable, public std::enable_shared_from_this<DistinctObserver>
 {
 public:
-    explicit DistinctObserver(const ObserverPtr &observer, MapFunction keySelector)
-        : mKeySelector(std::move(keySelector)), mDownstream(observer)
+    explicit DistinctObserver(const ObserverPtr &observer, MapFunction keySelector, uint64_t maxKeys)
+        : mKeySelector(std::move(keySelector)), mMaxKeys(maxKeys), mDownstream(observer)
     {
         LeakObserver::make<DistinctObserver>();
     }
@@ -55,24 +58,13 @@ public:
             return;
         }
 
-        // Check if key already exists using linear search
         bool isNew = false;
         bool hasError = false;
         std::shared_ptr<GAnyException> error;
         {
             GLockerGuard locker(mLock);
             try {
-                bool found = false;
-                for (const auto &k : mSeenKeys) {
-                    if (k == key) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    mSeenKeys.push_back(key);
-                    isNew = true;
-                }
+                isNew = mMaxKeys == 0 ? mSeenKeys.insert(key).second : markRecent(key);
             } catch (...) {
                 hasError = true;
                 error = std::make_shared<GAnyException>(
@@ -133,28 +125,54 @@ public:
     }
 
 private:
+    // Bounded mode: a key seen again moves to the front, the least recently seen key is evicted
+    bool markRecent(const GAny &key)
+    {
+        if (const auto it = mKeyIndex.find(key); it != mKeyIndex.end()) {
+            mRecentKeys.splice(mRecentKeys.begin(), mRecentKeys, it->second);
+            return false;
+        }
+        mRecentKeys.push_front(key);
+        try {
+            mKeyIndex.emplace(key, mRecentKeys.begin());
+        } catch (...) {
+            mRecentKeys.pop_front();
+            throw;
+        }
+        if (mKeyIndex.size() > mMaxKeys) {
+            mKeyIndex.erase(mRecentKeys.back());
+            mRecentKeys.pop_back();
+        }
+        return true;
+    }
+
     void clear()
     {
         mDownstream = nullptr;
         mUpstream = nullptr;
         GLockerGuard locker(mLock);
         mSeenKeys.clear();
+        mKeyIndex.clear();
+        mRecentKeys.clear();
     }
 
 private:
     MapFunction mKeySelector;
+    uint64_t mMaxKeys; // 0 means unbounded
     ObserverPtr mDownstream;
     DisposablePtr mUpstream;
     std::atomic<bool> mDone = false;
     GMutex mLock;
-    std::vector<GAny> mSeenKeys;
+    std::unordered_set<GAny, AnyKeyHash, AnyKeyEqual> mSeenKeys;
+    std::list<GAny> mRecentKeys;
+    std::unordered_map<GAny, std::list<GAny>::iterator, AnyKeyHash, AnyKeyEqual> mKeyIndex;
 };
 
 class ObservableDistinct : public Observable
 {
 public:
-    explicit ObservableDistinct(ObservableSourcePtr source, MapFunction keySelector)
-        : mSource(std::move(source)), mKeySelector(std::move(keySelector))
+    explicit ObservableDistinct(ObservableSourcePtr source, MapFunction keySelector, uint64_t maxKeys = 0)
+        : mSource(std::move(source)), mKeySelector(std::move(keySelector)), mMaxKeys(maxKeys)
     {
         LeakObserver::make<ObservableDistinct>();
     }
@@ -167,12 +185,13 @@ public:
 protected:
     void subscribeActual(const ObserverPtr &observer) override
     {
-        mSource->subscribe(std::make_shared<DistinctObserver>(observer, mKeySelector));
+        mSource->subscribe(std::make_shared<DistinctObserver>(observer, mKeySelector, mMaxKeys));
     }
 
 private:
     ObservableSourcePtr mSource;
     MapFunction mKeySelector;
+    uint64_t mMaxKeys;
 };
 } // rx
 
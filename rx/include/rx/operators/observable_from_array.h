@@ -6,7 +6,12 @@
 #define RX_OBSERVABLE_FROM_ARRAY_H
 
 #include "../observable.h"
+#include "../scheduler.h"
+#include "../sized_source.h"
 #include "../leak_observer.h"
+#include "scheduled_emission.h"
+
+#include <span>
 
 
 namespace rx
@@ -14,8 +19,8 @@ namespace rx
 class FromArrayDisposable : public Disposable
 {
 public:
-    explicit FromArrayDisposable(const ObserverPtr &observer, const std::vector<GAny> &array)
-        : mDownstream(observer), mArray(array)
+    explicit FromArrayDisposable(const ObserverPtr &observer, std::span<const GAny> items, std::shared_ptr<const void> owner)
+        : mDownstream(observer), mItems(items), mOwner(std::move(owner))
     {
         LeakObserver::make<FromArrayDisposable>();
     }
@@ -23,7 +28,7 @@ public:
     ~FromArrayDisposable() override
     {
         mDownstream = nullptr;  // Release reference
-        mArray.clear();         // Clear array
+        mOwner = nullptr;       // Release shared storage
         LeakObserver::release<FromArrayDisposable>();
     }
 
@@ -31,8 +36,8 @@ public:
     void run()
     {
         if (const auto d = mDownstream) {
-            for (size_t i = 0; i < mArray.size() && !isDisposed(); ++i) {
-                d->onNext(mArray[i]);
+            for (size_t i = 0; i < mItems.size() && !isDisposed(); ++i) {
+                d->onNext(mItems[i]);
             }
             if (!isDisposed()) {
                 d->onComplete();
@@ -54,15 +59,30 @@ public:
 
 private:
     ObserverPtr mDownstream;
-    std::vector<GAny> mArray;
+    std::span<const GAny> mItems;
+    std::shared_ptr<const void> mOwner; // Keeps mItems alive while emitting
     std::atomic<bool> mDisposed = false;
 };
 
-class ObservableFromArray : public Observable
+// Every subscription walks the same read-only storage by index, mOwner keeps it alive.
+// With a scheduler the walk runs on a worker in chunks, holding this observable and so the storage.
+class ObservableFromArray : public Observable, public SizedSource
 {
 public:
-    explicit ObservableFromArray(const std::vector<GAny> &array)
-        : mArray(array)
+    explicit ObservableFromArray(std::shared_ptr<const std::vector<GAny> > array)
+        : mItems(*array), mOwner(std::move(array))
+    {
+        LeakObserver::make<ObservableFromArray>();
+    }
+
+    explicit ObservableFromArray(std::span<const GAny> items, std::shared_ptr<const void> owner)
+        : mItems(items), mOwner(std::move(owner))
+    {
+        LeakObserver::make<ObservableFromArray>();
+    }
+
+    explicit ObservableFromArray(std::shared_ptr<const std::vector<GAny> > array, SchedulerPtr scheduler, size_t chunkSize)
+        : mItems(*array), mOwner(std::move(array)), mScheduler(std::move(scheduler)), mChunkSize(chunkSize)
     {
         LeakObserver::make<ObservableFromArray>();
     }
@@ -72,16 +92,38 @@ public:
         LeakObserver::release<ObservableFromArray>();
     }
 
+public:
+    uint64_t itemCount() const override
+    {
+        return mItems.size();
+    }
+
+    GAny itemAt(uint64_t index) const override
+    {
+        return mItems[index];
+    }
+
 protected:
     void subscribeActual(const ObserverPtr &observer) override
     {
-        const auto disposable = std::make_shared<FromArrayDisposable>(observer, mArray);
+        if (mScheduler) {
+            const auto disposable = std::make_shared<ScheduledEmissionDisposable>(
+                observer, std::static_pointer_cast<ObservableFromArray>(shared_from_this()),
+                mScheduler->createWorker(), mChunkSize);
+            observer->onSubscribe(disposable);
+            disposable->start();
+            return;
+        }
+        const auto disposable = std::make_shared<FromArrayDisposable>(observer, mItems, mOwner);
         observer->onSubscribe(disposable);
         disposable->run();
     }
 
 private:
-    std::vector<GAny> mArray;
+    std::span<const GAny> mItems;
+    std::shared_ptr<const void> mOwner;
+    SchedulerPtr mScheduler;
+    size_t mChunkSize = 0;
 };
 } // rx
 
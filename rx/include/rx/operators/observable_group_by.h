@@ -6,10 +6,14 @@
 #define RX_OBSERVABLE_GROUP_BY_H
 
 #include "../observable.h"
+#include "../any_key.h"
 #include "../disposables/disposable_helper.h"
 #include "../exception_helper.h"
 #include "../grouped_observable.h"
-#include <optional>
+#include "../subjects/publish_subject.h"
+#include <algorithm>
+#include <list>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -20,8 +24,9 @@ class GroupState;
 class GroupByObserver : public Observer, public Disposable, public std::enable_shared_from_this<GroupByObserver>
 {
 public:
-    GroupByObserver(ObserverPtr downstream, MapFunction keySelector, MapFunction valueSelector)
-        : mDownstream(std::move(downstream)), mKeySelector(std::move(keySelector)), mValueSelector(std::move(valueSelector))
+    GroupByObserver(ObserverPtr downstream, MapFunction keySelector, MapFunction valueSelector, GroupOptions options)
+        : mDownstream(std::move(downstream)), mKeySelector(std::move(keySelector)), mValueSelector(std::move(valueSelector)),
+          mOptions(std::move(options))
     {
         LeakObserver::make<GroupByObserver>();
     }
@@ -44,111 +49,71 @@ public:
 
     bool isDisposed() const override;
 
+    void releaseGroup(const GAny &key, const void *groupState);
+
+private:
+    std::vector<std::shared_ptr<GroupState> > takeExpiredGroups(uint64_t now);
+
+    std::vector<std::shared_ptr<GroupState> > takeAllGroups();
+
+    void scheduleSweep(uint64_t delay);
+
+    void sweep();
+
 private:
+    struct Activity
+    {
+        GAny key;
+        uint64_t lastActive;
+    };
+
+    struct GroupEntry
+    {
+        std::shared_ptr<GroupState> group;
+        std::list<Activity>::iterator activity;
+    };
+
     ObserverPtr mDownstream;
     MapFunction mKeySelector;
     MapFunction mValueSelector;
+    GroupOptions mOptions;
     DisposablePtr mUpstream;
+    WorkerPtr mWorker;
     std::atomic<bool> mDone{false};
 
-    std::vector<std::pair<GAny, std::shared_ptr<GroupState> > > mGroups;
+    GMutex mLock;
+    std::unordered_map<GAny, GroupEntry, AnyKeyHash, AnyKeyTypedEqual> mGroups;
+    std::list<Activity> mActivity; // Most recently active group first
 };
 
-// Helper to act as the "Subject" for each group
-class GroupState
+// Each group is a PublishSubject: values reach its observers through the subject's subscriber array.
+// Once the last observer of a group leaves, the group closes and the parent forgets it,
+// so a later value with the same key opens a fresh group.
+class GroupState : public PublishSubject
 {
 public:
-    GroupState(GAny key, std::shared_ptr<GroupByObserver> parent)
-        : mKey(std::move(key)), mParent(std::move(parent)), mState(std::make_shared<State>())
+    GroupState(GAny key, const std::shared_ptr<GroupByObserver> &parent)
+        : mKey(std::move(key)), mParent(parent)
     {
-        const auto state = mState;
-        mObservable = Observable::create([state](const ObservableEmitterPtr &emitter) {
-            std::optional<GAnyException> error;
-            bool completed = false;
-            {
-                GLockerGuard lock(state->lock);
-                error = state->error;
-                completed = state->completed;
-                if (!error && !completed) {
-                    state->emitters.push_back(emitter);
-                    return;
-                }
-            }
-            if (error) {
-                emitter->onError(error.value());
-            } else {
-                emitter->onComplete();
-            }
-        });
-    }
-
-    std::shared_ptr<Observable> getObservable() { return mObservable; }
-
-    void onNext(const GAny &value)
-    {
-        std::vector<ObservableEmitterPtr> emitters;
-        {
-            GLockerGuard lock(mState->lock);
-            auto it = mState->emitters.begin();
-            while (it != mState->emitters.end()) {
-                if ((*it)->isDisposed()) {
-                    it = mState->emitters.erase(it);
-                } else {
-                    emitters.push_back(*it);
-                    ++it;
-                }
-            }
-        }
-        for (const auto &emitter: emitters) {
-            emitter->onNext(value);
-        }
     }
 
-    void onError(const GAnyException &e)
+    std::shared_ptr<Observable> getObservable()
     {
-        std::vector<ObservableEmitterPtr> emitters;
-        {
-            GLockerGuard lock(mState->lock);
-            mState->error = e;
-            emitters = std::move(mState->emitters);
-            mState->emitters.clear();
-        }
-        for (const auto &emitter: emitters) {
-            if (!emitter->isDisposed()) {
-                emitter->onError(e);
-            }
-        }
+        return shared_from_this();
     }
 
-    void onComplete()
+protected:
+    void onObserversEmpty() override
     {
-        std::vector<ObservableEmitterPtr> emitters;
-        {
-            GLockerGuard lock(mState->lock);
-            mState->completed = true;
-            emitters = std::move(mState->emitters);
-            mState->emitters.clear();
-        }
-        for (const auto &emitter: emitters) {
-            if (!emitter->isDisposed()) {
-                emitter->onComplete();
-            }
+        onComplete();
+        if (const auto parent = mParent.lock()) {
+            parent->releaseGroup(mKey, this);
         }
     }
 
 private:
-    struct State
-    {
-        std::vector<ObservableEmitterPtr> emitters;
-        std::optional<GAnyException> error;
-        bool completed = false;
-        GMutex lock;
-    };
-
     GAny mKey;
     std::weak_ptr<GroupByObserver> mParent;
-    std::shared_ptr<Observable> mObservable;
-    std::shared_ptr<State> mState;
 };
 
 // Implementation of GroupByObserver methods
@@ -157,9 +122,15 @@ inline void GroupByObserver::onSubscribe(const DisposablePtr &d)
 {
     if (DisposableHelper::validate(mUpstream, d)) {
         mUpstream = d;
+        if (mOptions.idleTimeout > 0 && mOptions.scheduler) {
+            mWorker = mOptions.scheduler->createWorker();
+        }
         if (const auto downstream = mDownstream) {
             downstream->onSubscribe(shared_from_this());
         }
+        if (mWorker) {
+            scheduleSweep(mOptions.idleTimeout);
+        }
     }
 }
 
@@ -179,19 +150,32 @@ inline void GroupByObserver::onNext(const GAny &t)
         return;
     }
 
+    const uint64_t now = mWorker ? mWorker->now() : 0;
     std::shared_ptr<GroupState> groupState;
+    std::vector<std::shared_ptr<GroupState> > evicted;
     bool isNew = false;
     try {
-        for (const auto &group: mGroups) {
-            if (group.first.typeInfo() == key.typeInfo() && group.first == key) {
-                groupState = group.second;
-                break;
-            }
-        }
-        if (!groupState) {
+        GLockerGuard lock(mLock);
+        if (const auto it = mGroups.find(key); it != mGroups.end()) {
+            groupState = it->second.group;
+            mActivity.splice(mActivity.begin(), mActivity, it->second.activity);
+            it->second.activity->lastActive = now;
+        } else {
             isNew = true;
             groupState = std::make_shared<GroupState>(key, this->shared_from_this());
-            mGroups.emplace_back(key, groupState);
+            mActivity.push_front({key, now});
+            try {
+                mGroups.emplace(key, GroupEntry{groupState, mActivity.begin()});
+            } catch (...) {
+                mActivity.pop_front();
+                throw;
+            }
+            if (mOptions.maxGroups > 0 && mGroups.size() > mOptions.maxGroups) {
+                const auto victim = mGroups.find(mActivity.back().key);
+                evicted.push_back(victim->second.group);
+                mGroups.erase(victim);
+                mActivity.pop_back();
+            }
         }
     } catch (...) {
         if (mUpstream) {
@@ -201,9 +185,19 @@ inline void GroupByObserver::onNext(const GAny &t)
         return;
     }
 
+    if (mWorker) {
+        const auto expired = takeExpiredGroups(now);
+        evicted.insert(evicted.end(), expired.begin(), expired.end());
+    }
+    for (const auto &group: evicted) {
+        group->onComplete();
+    }
+
     if (isNew) {
         const auto groupedObservable = std::make_shared<GroupedObservable>(key, groupState->getObservable());
-        mDownstream->onNext(groupedObservable);
+        if (const auto downstream = mDownstream) {
+            downstream->onNext(groupedObservable);
+        }
         if (mDone.load(std::memory_order_acquire)) {
             return;
         }
@@ -229,10 +223,12 @@ inline void GroupByObserver::onError(const GAnyException &e)
     if (mDone.exchange(true, std::memory_order_acq_rel)) {
         return;
     }
-    for (const auto &group: mGroups) {
-        group.second->onError(e);
+    if (const auto w = mWorker) {
+        w->dispose();
+    }
+    for (const auto &group: takeAllGroups()) {
+        group->onError(e);
     }
-    mGroups.clear();
     if (mDownstream)
         mDownstream->onError(e);
     mDownstream = nullptr;
@@ -244,10 +240,12 @@ inline void GroupByObserver::onComplete()
     if (mDone.exchange(true, std::memory_order_acq_rel)) {
         return;
     }
-    for (const auto &group: mGroups) {
-        group.second->onComplete();
+    if (const auto w = mWorker) {
+        w->dispose();
+    }
+    for (const auto &group: takeAllGroups()) {
+        group->onComplete();
     }
-    mGroups.clear();
     if (mDownstream)
         mDownstream->onComplete();
     mDownstream = nullptr;
@@ -262,10 +260,12 @@ inline void GroupByObserver::dispose()
     if (mUpstream) {
         mUpstream->dispose();
     }
-    for (const auto &group: mGroups) {
-        group.second->onComplete();
+    if (const auto w = mWorker) {
+        w->dispose();
+    }
+    for (const auto &group: takeAllGroups()) {
+        group->onComplete();
     }
-    mGroups.clear();
     mDownstream = nullptr;
     mUpstream = nullptr;
 }
@@ -275,11 +275,85 @@ inline bool GroupByObserver::isDisposed() const
     return mDone.load(std::memory_order_acquire);
 }
 
+inline void GroupByObserver::releaseGroup(const GAny &key, const void *groupState)
+{
+    GLockerGuard lock(mLock);
+    const auto it = mGroups.find(key);
+    if (it != mGroups.end() && it->second.group.get() == groupState) {
+        mActivity.erase(it->second.activity);
+        mGroups.erase(it);
+    }
+}
+
+inline std::vector<std::shared_ptr<GroupState> > GroupByObserver::takeExpiredGroups(uint64_t now)
+{
+    const uint64_t idle = mOptions.idleTimeout * 1000000;
+    std::vector<std::shared_ptr<GroupState> > expired;
+    GLockerGuard lock(mLock);
+    while (!mActivity.empty() && mActivity.back().lastActive <= now && now - mActivity.back().lastActive >= idle) {
+        const auto it = mGroups.find(mActivity.back().key);
+        expired.push_back(it->second.group);
+        mGroups.erase(it);
+        mActivity.pop_back();
+    }
+    return expired;
+}
+
+inline std::vector<std::shared_ptr<GroupState> > GroupByObserver::takeAllGroups()
+{
+    std::vector<std::shared_ptr<GroupState> > groups;
+    GLockerGuard lock(mLock);
+    groups.reserve(mGroups.size());
+    for (const auto &activity: mActivity) {
+        groups.push_back(mGroups.find(activity.key)->second.group);
+    }
+    mGroups.clear();
+    mActivity.clear();
+    return groups;
+}
+
+inline void GroupByObserver::scheduleSweep(uint64_t delay)
+{
+    if (const auto w = mWorker) {
+        w->schedule([weak = weak_from_this()] {
+            if (const auto self = weak.lock()) {
+                self->sweep();
+            }
+        }, delay);
+    }
+}
+
+inline void GroupByObserver::sweep()
+{
+    if (mDone.load(std::memory_order_acquire)) {
+        return;
+    }
+    const uint64_t now = mWorker->now();
+    for (const auto &group: takeExpiredGroups(now)) {
+        group->onComplete();
+    }
+
+    // Wake up again when the least recently active group would expire
+    uint64_t next = mOptions.idleTimeout;
+    {
+        GLockerGuard lock(mLock);
+        if (!mActivity.empty()) {
+            const uint64_t idle = mOptions.idleTimeout * 1000000;
+            const uint64_t lastActive = std::min(now, mActivity.back().lastActive);
+            const uint64_t remaining = idle - std::min(idle, now - lastActive);
+            next = std::max<uint64_t>(1, (remaining + 999999) / 1000000);
+        }
+    }
+    scheduleSweep(next);
+}
+
 class ObservableGroupBy : public Observable
 {
 public:
-    ObservableGroupBy(std::shared_ptr<Observable> source, MapFunction keySelector, MapFunction valueSelector = nullptr)
-        : mSource(std::move(source)), mKeySelector(std::move(keySelector)), mValueSelector(std::move(valueSelector))
+    ObservableGroupBy(std::shared_ptr<Observable> source, MapFunction keySelector, MapFunction valueSelector = nullptr,
+                      GroupOptions options = {})
+        : mSource(std::move(source)), mKeySelector(std::move(keySelector)), mValueSelector(std::move(valueSelector)),
+          mOptions(std::move(options))
     {
         LeakObserver::make<ObservableGroupBy>();
     }
@@ -292,13 +366,14 @@ public:
 protected:
     void subscribeActual(const ObserverPtr &observer) override
     {
-        mSource->subscribe(std::make_shared<GroupByObserver>(observer, mKeySelector, mValueSelector));
+        mSource->subscribe(std::make_shared<GroupByObserver>(observer, mKeySelector, mValueSelector, mOptions));
     }
 
 private:
     std::shared_ptr<Observable> mSource;
     MapFunction mKeySelector;
     MapFunction mValueSelector;
+    GroupOptions mOptions;
 };
 } // rx
 
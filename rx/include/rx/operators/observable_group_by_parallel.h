@@ -0,0 +1,359 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_GROUP_BY_PARALLEL_H
+#define RX_OBSERVABLE_GROUP_BY_PARALLEL_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../any_key.h"
+#include "../exception_helper.h"
+#include "../grouped_observable.h"
+#include "../disposables/disposable_helper.h"
+#include "../subjects/publish_subject.h"
+#include "../leak_observer.h"
+#include "../spsc_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace rx
+{
+class GroupByParallelObserver;
+
+// A group of groupByParallel(), only ever fed by its lane. Once its last observer leaves it completes and
+// flags itself, the lane notices the flag on the next value with that key and opens a fresh group.
+class ParallelGroup : public PublishSubject
+{
+public:
+    bool isReleased() const
+    {
+        return mReleased.load(std::memory_order_acquire);
+    }
+
+protected:
+    void onObserversEmpty() override
+    {
+        mReleased.store(true, std::memory_order_release);
+        onComplete();
+    }
+
+private:
+    std::atomic<bool> mReleased = false;
+};
+
+// One serial lane: a worker, the values routed to it and the groups of every key hashed onto it.
+// The upstream is the only producer, so keys and values go through a pair of SPSC queues, and the group map
+// is only touched by the draining thread: neither an offer nor a lookup takes a lock.
+class GroupLane : public std::enable_shared_from_this<GroupLane>
+{
+public:
+    GroupLane(const std::shared_ptr<GroupByParallelObserver> &parent, const WorkerPtr &worker)
+        : mParent(parent), mWorker(worker)
+    {
+        LeakObserver::make<GroupLane>();
+    }
+
+    ~GroupLane()
+    {
+        LeakObserver::release<GroupLane>();
+    }
+
+public:
+    // Upstream thread only, the value goes in first so the drain finds it once it sees the key
+    void offer(const GAny &key, const GAny &value)
+    {
+        mValues.offer(value);
+        mKeys.offer(key);
+        signal();
+    }
+
+    // Upstream thread only, the lane terminates its groups once it has delivered everything before
+    void finish(const GAnyException *error)
+    {
+        if (error) {
+            mError = std::make_unique<GAnyException>(*error);
+        }
+        mDone.store(true, std::memory_order_release);
+        signal();
+    }
+
+    void cancel()
+    {
+        mCancelled.store(true, std::memory_order_release);
+        signal();
+    }
+
+private:
+    void signal()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        std::weak_ptr<GroupLane> weakSelf = shared_from_this();
+        mWorker->schedule([weakSelf] {
+            if (const auto self = weakSelf.lock()) {
+                self->run();
+            }
+        });
+    }
+
+    void run();
+
+    void terminate(const GAnyException *error);
+
+private:
+    std::shared_ptr<GroupByParallelObserver> mParent; // Released by the draining thread on termination
+    WorkerPtr mWorker;
+
+    SpscQueue mKeys;
+    SpscQueue mValues;
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+    std::atomic<bool> mCancelled = false;
+
+    // Owned by the draining thread
+    std::unordered_map<GAny, std::shared_ptr<ParallelGroup>, AnyKeyHash, AnyKeyTypedEqual> mGroups;
+
+    std::atomic<uint32_t> mWip = 0;
+};
+
+// Hashes every key onto one of a fixed set of lanes and lets the lanes run the groups. Values of one key
+// always take the same lane and stay in order, announcing a new group is the only step lanes serialize on.
+class GroupByParallelObserver : public Observer, public Disposable, public std::enable_shared_from_this<GroupByParallelObserver>
+{
+public:
+    GroupByParallelObserver(const ObserverPtr &downstream, const MapFunction &keySelector)
+        : mDownstream(downstream), mKeySelector(keySelector)
+    {
+        LeakObserver::make<GroupByParallelObserver>();
+    }
+
+    ~GroupByParallelObserver() override
+    {
+        LeakObserver::release<GroupByParallelObserver>();
+    }
+
+public:
+    void start(const SchedulerPtr &scheduler, uint32_t parallelism)
+    {
+        mLanes.reserve(parallelism);
+        for (uint32_t i = 0; i < parallelism; ++i) {
+            mLanes.push_back(std::make_shared<GroupLane>(shared_from_this(), scheduler->createWorker()));
+        }
+        mRemainingLanes = parallelism;
+    }
+
+    // Called on a lane thread before the first value of a new group is delivered
+    void emitGroup(const GAny &key, const std::shared_ptr<ParallelGroup> &group)
+    {
+        GLockerGuard lock(mEmitLock);
+        if (mDownstream && !isDisposed()) {
+            mDownstream->onNext(std::make_shared<GroupedObservable>(key, group));
+        }
+    }
+
+    // Called by each lane once it has terminated its groups, the last one terminates the downstream
+    void laneFinished(const GAnyException *error)
+    {
+        GLockerGuard lock(mEmitLock);
+        if (--mRemainingLanes != 0) {
+            return;
+        }
+        const auto downstream = std::move(mDownstream);
+        if (isDisposed()) {
+            return;
+        }
+        if (error) {
+            downstream->onError(*error);
+        } else {
+            downstream->onComplete();
+        }
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        GAny key;
+        try {
+            key = mKeySelector(value);
+        } catch (...) {
+            mUpstream->dispose();
+            onError(ExceptionHelper::fromCurrentException("GroupByParallel: Key selector failed"));
+            return;
+        }
+        mLanes[laneOf(AnyKeyHash{}(key), static_cast<int32_t>(mLanes.size()))]->offer(key, value);
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        for (const auto &lane: mLanes) {
+            lane->finish(&e);
+        }
+    }
+
+    void onComplete() override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        for (const auto &lane: mLanes) {
+            lane->finish(nullptr);
+        }
+    }
+
+    // Completes every open group on its lane, like groupBy() does. It takes no lock, so the downstream may
+    // dispose from inside onNext, and the last lane to finish releases the downstream.
+    void dispose() override
+    {
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        mDone.store(true, std::memory_order_release);
+        if (const auto d = mUpstream) {
+            d->dispose();
+        }
+        for (const auto &lane: mLanes) {
+            lane->cancel();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    // Jump consistent hash (Lamping and Veach), spreads keys evenly without a modulo bias towards low lanes
+    static size_t laneOf(uint64_t key, int32_t lanes)
+    {
+        int64_t b = -1;
+        int64_t j = 0;
+        while (j < lanes) {
+            b = j;
+            key = key * 2862933555777941757ULL + 1;
+            j = static_cast<int64_t>(static_cast<double>(b + 1) *
+                                     (static_cast<double>(1LL << 31) / static_cast<double>((key >> 33) + 1)));
+        }
+        return static_cast<size_t>(b);
+    }
+
+private:
+    ObserverPtr mDownstream; // Guarded by mEmitLock
+    MapFunction mKeySelector;
+    std::vector<std::shared_ptr<GroupLane> > mLanes;
+    DisposablePtr mUpstream;
+    GMutex mEmitLock;
+    uint32_t mRemainingLanes = 0; // Guarded by mEmitLock
+    std::atomic<bool> mDone = false;
+    std::atomic<bool> mCancelled = false;
+};
+
+inline void GroupLane::run()
+{
+    uint32_t missed = 1;
+    while (true) {
+        if (mCancelled.load(std::memory_order_acquire)) {
+            terminate(nullptr);
+            return;
+        }
+        // Read before polling, every value offered before the terminal event is then queued
+        const bool done = mDone.load(std::memory_order_acquire);
+        GAny key;
+        GAny value;
+        while (!mCancelled.load(std::memory_order_acquire) && mKeys.poll(key)) {
+            mValues.poll(value);
+            auto &group = mGroups[key];
+            if (!group || group->isReleased()) {
+                group = std::make_shared<ParallelGroup>();
+                mParent->emitGroup(key, group);
+            }
+            group->onNext(value);
+        }
+        if (done) {
+            terminate(mError.get());
+            return;
+        }
+
+        missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+        if (missed == 0) {
+            return;
+        }
+    }
+}
+
+// Ends every group of the lane before the parent hears of it. The WIP count is left held, so values offered
+// to the lane afterwards never schedule it again
+inline void GroupLane::terminate(const GAnyException *error)
+{
+    for (const auto &[key, group]: mGroups) {
+        if (error) {
+            group->onError(*error);
+        } else {
+            group->onComplete();
+        }
+    }
+    mGroups.clear();
+    mKeys.clear();
+    mValues.clear();
+    mWorker->dispose();
+    const auto parent = std::move(mParent);
+    parent->laneFinished(error);
+}
+
+class ObservableGroupByParallel : public Observable
+{
+public:
+    ObservableGroupByParallel(ObservableSourcePtr source, MapFunction keySelector, SchedulerPtr scheduler,
+                              uint32_t parallelism)
+        : mSource(std::move(source)),
+          mKeySelector(std::move(keySelector)),
+          mScheduler(std::move(scheduler)),
+          mParallelism(parallelism)
+    {
+        LeakObserver::make<ObservableGroupByParallel>();
+    }
+
+    ~ObservableGroupByParallel() override
+    {
+        LeakObserver::release<ObservableGroupByParallel>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const auto parent = std::make_shared<GroupByParallelObserver>(observer, mKeySelector);
+        parent->start(mScheduler, mParallelism);
+        mSource->subscribe(parent);
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    MapFunction mKeySelector;
+    SchedulerPtr mScheduler;
+    uint32_t mParallelism;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_GROUP_BY_PARALLEL_H
@@ -15,12 +15,12 @@
 
 namespace rx
 {
-class JoinMainObserver;
-
+// Left/right source observer, forwards into a join parent (JoinMainObserver or KeyedJoinObserver)
+template<typename Parent>
 class JoinSupportObserver : public Observer, public Disposable
 {
 public:
-    JoinSupportObserver(std::shared_ptr<JoinMainObserver> parent, bool isLeft)
+    JoinSupportObserver(std::shared_ptr<Parent> parent, bool isLeft)
         : mParent(std::move(parent)), mIsLeft(isLeft)
     {
         LeakObserver::make<JoinSupportObserver>();
@@ -37,11 +37,26 @@ public:
         DisposableHelper::setOnce(mDisposable, d, mLock);
     }
 
-    void onNext(const GAny &value) override;
+    void onNext(const GAny &value) override
+    {
+        if (const auto p = mParent.lock()) {
+            p->innerValue(mIsLeft, value);
+        }
+    }
 
-    void onError(const GAnyException &e) override;
+    void onError(const GAnyException &e) override
+    {
+        if (const auto p = mParent.lock()) {
+            p->innerError(e);
+        }
+    }
 
-    void onComplete() override;
+    void onComplete() override
+    {
+        if (const auto p = mParent.lock()) {
+            p->innerComplete(mIsLeft);
+        }
+    }
 
     void dispose() override
     {
@@ -54,16 +69,17 @@ public:
     }
 
 private:
-    std::weak_ptr<JoinMainObserver> mParent;
+    std::weak_ptr<Parent> mParent;
     bool mIsLeft;
     DisposablePtr mDisposable;
     GMutex mLock;
 };
 
+template<typename Parent>
 class JoinDurationObserver : public Observer, public Disposable
 {
 public:
-    JoinDurationObserver(std::shared_ptr<JoinMainObserver> parent, uint64_t id, bool isLeft)
+    JoinDurationObserver(std::shared_ptr<Parent> parent, uint64_t id, bool isLeft)
         : mParent(std::move(parent)), mId(id), mIsLeft(isLeft)
     {
         LeakObserver::make<JoinDurationObserver>();
@@ -85,9 +101,19 @@ public:
         onComplete();
     }
 
-    void onError(const GAnyException &e) override;
+    void onError(const GAnyException &e) override
+    {
+        if (const auto p = mParent.lock()) {
+            p->innerError(e);
+        }
+    }
 
-    void onComplete() override;
+    void onComplete() override
+    {
+        if (const auto p = mParent.lock()) {
+            p->innerClose(mIsLeft, mId);
+        }
+    }
 
     void dispose() override
     {
@@ -100,7 +126,7 @@ public:
     }
 
 private:
-    std::weak_ptr<JoinMainObserver> mParent;
+    std::weak_ptr<Parent> mParent;
     uint64_t mId;
     bool mIsLeft;
     DisposablePtr mDisposable;
@@ -131,8 +157,8 @@ public:
 public:
     void subscribe(const ObservableSourcePtr &left, const ObservableSourcePtr &right)
     {
-        const auto leftObs = std::make_shared<JoinSupportObserver>(shared_from_this(), true);
-        const auto rightObs = std::make_shared<JoinSupportObserver>(shared_from_this(), false);
+        const auto leftObs = std::make_shared<JoinSupportObserver<JoinMainObserver> >(shared_from_this(), true);
+        const auto rightObs = std::make_shared<JoinSupportObserver<JoinMainObserver> >(shared_from_this(), false);
         {
             GLockerGuard lock(mGate);
             if (mCancelled.load(std::memory_order_acquire)) {
@@ -143,13 +169,14 @@ public:
         }
 
         left->subscribe(leftObs);
-        if (!isDisposed()) {
+        if (!mCancelled.load(std::memory_order_acquire)) {
             right->subscribe(rightObs);
         }
     }
 
     void dispose() override
     {
+        mDisposed.store(true, std::memory_order_release);
         std::vector<DisposablePtr> disposables;
         {
             GLockerGuard lock(mGate);
@@ -163,7 +190,7 @@ public:
 
     bool isDisposed() const override
     {
-        return mCancelled.load(std::memory_order_acquire);
+        return mDisposed.load(std::memory_order_acquire);
     }
 
     void innerError(const GAnyException &e)
@@ -231,7 +258,7 @@ public:
             }
             id = mIdGenerator++;
         }
-        const auto durationObserver = std::make_shared<JoinDurationObserver>(shared_from_this(), id, isLeft);
+        const auto durationObserver = std::make_shared<JoinDurationObserver<JoinMainObserver> >(shared_from_this(), id, isLeft);
         std::vector<GAny> values;
         {
             GLockerGuard lock(mGate);
@@ -260,7 +287,7 @@ public:
             } else {
                 emitResult(otherValue, value);
             }
-            if (isDisposed()) {
+            if (mCancelled.load(std::memory_order_acquire)) {
                 return;
             }
         }
@@ -334,7 +361,8 @@ private:
     BiFunction mResultSelector;
 
     GMutex mGate;
-    std::atomic<bool> mCancelled{false};
+    std::atomic<bool> mCancelled{false}; // Terminated or disposed
+    std::atomic<bool> mDisposed{false};
     std::atomic<int> mActiveCount{0};
     uint64_t mIdGenerator{0};
 
@@ -347,41 +375,6 @@ private:
     std::map<uint64_t, DisposablePtr> mRightDurations;
 };
 
-inline void JoinSupportObserver::onNext(const GAny &value)
-{
-    if (const auto p = mParent.lock()) {
-        p->innerValue(mIsLeft, value);
-    }
-}
-
-inline void JoinSupportObserver::onError(const GAnyException &e)
-{
-    if (const auto p = mParent.lock()) {
-        p->innerError(e);
-    }
-}
-
-inline void JoinSupportObserver::onComplete()
-{
-    if (const auto p = mParent.lock()) {
-        p->innerComplete(mIsLeft);
-    }
-}
-
-inline void JoinDurationObserver::onError(const GAnyException &e)
-{
-    if (const auto p = mParent.lock()) {
-        p->innerError(e);
-    }
-}
-
-inline void JoinDurationObserver::onComplete()
-{
-    if (const auto p = mParent.lock()) {
-        p->innerClose(mIsLeft, mId);
-    }
-}
-
 class ObservableJoin : public Observable
 {
 public:
@@ -0,0 +1,438 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_JOIN_ON_KEY_H
+#define RX_OBSERVABLE_JOIN_ON_KEY_H
+
+#include "observable_join.h"
+#include "../any_key.h"
+#include "../scheduler.h"
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+
+namespace rx
+{
+// Equi-join: values only pair with opposite values whose key is equal.
+// Each side keeps its open values bucketed by key, so a lookup touches only the matching bucket.
+// Windows are either closed by duration Observables or, in interval mode, by a fixed time window
+// per side, in which case expiry walks a deadline-ordered ring instead of subscribing per value.
+class KeyedJoinObserver : public Disposable, public std::enable_shared_from_this<KeyedJoinObserver>
+{
+private:
+    struct Entry
+    {
+        uint64_t id;
+        GAny value;
+    };
+
+    // Entries are appended in id order, so a bucket stays sorted by id
+    using Bucket = std::deque<Entry>;
+
+    struct Window
+    {
+        std::unordered_map<GAny, Bucket, AnyKeyHash, AnyKeyTypedEqual> buckets;
+
+        // Duration mode: open id -> key and its duration subscription
+        std::unordered_map<uint64_t, std::pair<GAny, DisposablePtr> > open;
+
+        // Interval mode: (deadline, key) in arrival order, deadlines are non-decreasing
+        std::deque<std::pair<uint64_t, GAny> > deadlines;
+    };
+
+public:
+    KeyedJoinObserver(ObserverPtr downstream,
+                      MapFunction leftKeySelector,
+                      MapFunction rightKeySelector,
+                      FlatMapFunction leftDurationSelector,
+                      FlatMapFunction rightDurationSelector,
+                      BiFunction resultSelector)
+        : mDownstream(std::move(downstream)),
+          mLeftKeySelector(std::move(leftKeySelector)),
+          mRightKeySelector(std::move(rightKeySelector)),
+          mLeftDurationSelector(std::move(leftDurationSelector)),
+          mRightDurationSelector(std::move(rightDurationSelector)),
+          mResultSelector(std::move(resultSelector))
+    {
+        LeakObserver::make<KeyedJoinObserver>();
+        mActiveCount.store(2);
+    }
+
+    KeyedJoinObserver(ObserverPtr downstream,
+                      MapFunction leftKeySelector,
+                      MapFunction rightKeySelector,
+                      uint64_t leftWindow,
+                      uint64_t rightWindow,
+                      BiFunction resultSelector,
+                      WorkerPtr worker)
+        : mDownstream(std::move(downstream)),
+          mLeftKeySelector(std::move(leftKeySelector)),
+          mRightKeySelector(std::move(rightKeySelector)),
+          mResultSelector(std::move(resultSelector)),
+          mLeftWindow(leftWindow * 1000000),
+          mRightWindow(rightWindow * 1000000),
+          mWorker(std::move(worker))
+    {
+        LeakObserver::make<KeyedJoinObserver>();
+        mActiveCount.store(2);
+    }
+
+    ~KeyedJoinObserver() override
+    {
+        LeakObserver::release<KeyedJoinObserver>();
+    }
+
+public:
+    void subscribe(const ObservableSourcePtr &left, const ObservableSourcePtr &right)
+    {
+        const auto leftObs = std::make_shared<JoinSupportObserver<KeyedJoinObserver> >(shared_from_this(), true);
+        const auto rightObs = std::make_shared<JoinSupportObserver<KeyedJoinObserver> >(shared_from_this(), false);
+        {
+            GLockerGuard lock(mGate);
+            if (mCancelled.load(std::memory_order_acquire)) {
+                return;
+            }
+            mDisposables.push_back(leftObs);
+            mDisposables.push_back(rightObs);
+        }
+
+        left->subscribe(leftObs);
+        if (!mCancelled.load(std::memory_order_acquire)) {
+            right->subscribe(rightObs);
+        }
+    }
+
+    void dispose() override
+    {
+        mDisposed.store(true, std::memory_order_release);
+        std::vector<DisposablePtr> disposables;
+        {
+            GLockerGuard lock(mGate);
+            if (mCancelled.exchange(true)) {
+                return;
+            }
+            collectDisposables(disposables);
+        }
+        disposeAll(disposables);
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+    void innerError(const GAnyException &e)
+    {
+        ObserverPtr downstream;
+        std::vector<DisposablePtr> disposables;
+        {
+            GLockerGuard lock(mGate);
+            if (mCancelled.exchange(true)) {
+                return;
+            }
+            downstream = mDownstream;
+            collectDisposables(disposables);
+        }
+        disposeAll(disposables);
+        if (downstream) {
+            downstream->onError(e);
+        }
+    }
+
+    void innerComplete(bool /*isLeft*/)
+    {
+        if (mActiveCount.fetch_sub(1) == 1) {
+            ObserverPtr downstream;
+            std::vector<DisposablePtr> disposables;
+            {
+                GLockerGuard lock(mGate);
+                if (mCancelled.exchange(true)) {
+                    return;
+                }
+                downstream = mDownstream;
+                collectDisposables(disposables);
+            }
+            disposeAll(disposables);
+            if (downstream) {
+                downstream->onComplete();
+            }
+        }
+    }
+
+    void innerValue(bool isLeft, const GAny &value)
+    {
+        GAny key;
+        try {
+            key = isLeft ? mLeftKeySelector(value) : mRightKeySelector(value);
+        } catch (...) {
+            innerError(ExceptionHelper::fromCurrentException("JoinOnKey: Key selector failed"));
+            return;
+        }
+
+        ObservableSourcePtr durationObservable;
+        if (!mWorker) {
+            try {
+                durationObservable = isLeft ? mLeftDurationSelector(value) : mRightDurationSelector(value);
+            } catch (...) {
+                innerError(ExceptionHelper::fromCurrentException("JoinOnKey: Duration selector failed"));
+                return;
+            }
+            if (!durationObservable) {
+                innerError(GAnyException("JoinOnKey: Duration Selector returned null"));
+                return;
+            }
+        }
+
+        std::shared_ptr<JoinDurationObserver<KeyedJoinObserver> > durationObserver;
+        std::vector<GAny> matches;
+        {
+            GLockerGuard lock(mGate);
+            if (mCancelled.load(std::memory_order_acquire)) {
+                return;
+            }
+            const uint64_t id = mIdGenerator++;
+            Window &own = isLeft ? mLefts : mRights;
+            const Window &other = isLeft ? mRights : mLefts;
+
+            if (mWorker) {
+                const uint64_t now = mWorker->now();
+                expire(mLefts, now);
+                expire(mRights, now);
+                const uint64_t window = isLeft ? mLeftWindow : mRightWindow;
+                if (window > 0) {
+                    own.buckets[key].push_back({id, value});
+                    own.deadlines.emplace_back(now + window, key);
+                }
+            } else {
+                durationObserver = std::make_shared<JoinDurationObserver<KeyedJoinObserver> >(shared_from_this(), id, isLeft);
+                own.buckets[key].push_back({id, value});
+                own.open.emplace(id, std::make_pair(key, durationObserver));
+            }
+
+            if (const auto it = other.buckets.find(key); it != other.buckets.end()) {
+                matches.reserve(it->second.size());
+                for (const auto &entry: it->second) {
+                    matches.push_back(entry.value);
+                }
+            }
+        }
+        if (durationObserver) {
+            durationObservable->subscribe(durationObserver);
+        }
+
+        for (const auto &otherValue: matches) {
+            if (isLeft) {
+                emitResult(value, otherValue);
+            } else {
+                emitResult(otherValue, value);
+            }
+            if (mCancelled.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+    }
+
+    void innerClose(bool isLeft, uint64_t id)
+    {
+        GLockerGuard lock(mGate);
+        Window &window = isLeft ? mLefts : mRights;
+        const auto it = window.open.find(id);
+        if (it == window.open.end()) {
+            return;
+        }
+        if (const auto bucket = window.buckets.find(it->second.first); bucket != window.buckets.end()) {
+            auto &entries = bucket->second;
+            const auto entry = std::lower_bound(entries.begin(), entries.end(), id, [](const Entry &e, uint64_t v) {
+                return e.id < v;
+            });
+            if (entry != entries.end() && entry->id == id) {
+                entries.erase(entry);
+            }
+            if (entries.empty()) {
+                window.buckets.erase(bucket);
+            }
+        }
+        window.open.erase(it);
+    }
+
+private:
+    // Drops every interval-mode entry whose deadline has passed, oldest first
+    static void expire(Window &window, uint64_t now)
+    {
+        while (!window.deadlines.empty() && window.deadlines.front().first <= now) {
+            if (const auto bucket = window.buckets.find(window.deadlines.front().second); bucket != window.buckets.end()) {
+                bucket->second.pop_front();
+                if (bucket->second.empty()) {
+                    window.buckets.erase(bucket);
+                }
+            }
+            window.deadlines.pop_front();
+        }
+    }
+
+    void emitResult(const GAny &left, const GAny &right)
+    {
+        GAny result;
+        try {
+            result = mResultSelector(left, right);
+        } catch (...) {
+            innerError(ExceptionHelper::fromCurrentException("JoinOnKey: Result selector failed"));
+            return;
+        }
+        ObserverPtr downstream;
+        {
+            GLockerGuard lock(mGate);
+            if (mCancelled.load(std::memory_order_acquire)) {
+                return;
+            }
+            downstream = mDownstream;
+        }
+        if (downstream) {
+            downstream->onNext(result);
+        }
+    }
+
+    void collectDisposables(std::vector<DisposablePtr> &disposables)
+    {
+        disposables.insert(disposables.end(), mDisposables.begin(), mDisposables.end());
+        for (const auto &pair: mLefts.open) {
+            disposables.push_back(pair.second.second);
+        }
+        for (const auto &pair: mRights.open) {
+            disposables.push_back(pair.second.second);
+        }
+        if (mWorker) {
+            disposables.push_back(mWorker);
+        }
+        mDisposables.clear();
+        mLefts = {};
+        mRights = {};
+        mDownstream = nullptr;
+    }
+
+    static void disposeAll(const std::vector<DisposablePtr> &disposables)
+    {
+        for (const auto &disposable: disposables) {
+            if (disposable) {
+                disposable->dispose();
+            }
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    MapFunction mLeftKeySelector;
+    MapFunction mRightKeySelector;
+    FlatMapFunction mLeftDurationSelector;
+    FlatMapFunction mRightDurationSelector;
+    BiFunction mResultSelector;
+
+    // Interval mode only, windows in nanoseconds to match Worker::now()
+    uint64_t mLeftWindow = 0;
+    uint64_t mRightWindow = 0;
+    WorkerPtr mWorker;
+
+    GMutex mGate;
+    std::atomic<bool> mCancelled{false}; // Terminated or disposed
+    std::atomic<bool> mDisposed{false};
+    std::atomic<int> mActiveCount{0};
+    uint64_t mIdGenerator{0};
+
+    std::vector<DisposablePtr> mDisposables;
+
+    Window mLefts;
+    Window mRights;
+};
+
+class ObservableJoinOnKey : public Observable
+{
+public:
+    ObservableJoinOnKey(ObservableSourcePtr source,
+                        ObservableSourcePtr other,
+                        MapFunction leftKeySelector,
+                        MapFunction rightKeySelector,
+                        FlatMapFunction leftDurationSelector,
+                        FlatMapFunction rightDurationSelector,
+                        BiFunction resultSelector)
+        : mSource(std::move(source)),
+          mOther(std::move(other)),
+          mLeftKeySelector(std::move(leftKeySelector)),
+          mRightKeySelector(std::move(rightKeySelector)),
+          mLeftDurationSelector(std::move(leftDurationSelector)),
+          mRightDurationSelector(std::move(rightDurationSelector)),
+          mResultSelector(std::move(resultSelector))
+    {
+        LeakObserver::make<ObservableJoinOnKey>();
+    }
+
+    ObservableJoinOnKey(ObservableSourcePtr source,
+                        ObservableSourcePtr other,
+                        MapFunction leftKeySelector,
+                        MapFunction rightKeySelector,
+                        uint64_t leftWindow,
+                        uint64_t rightWindow,
+                        BiFunction resultSelector,
+                        SchedulerPtr scheduler)
+        : mSource(std::move(source)),
+          mOther(std::move(other)),
+          mLeftKeySelector(std::move(leftKeySelector)),
+          mRightKeySelector(std::move(rightKeySelector)),
+          mResultSelector(std::move(resultSelector)),
+          mLeftWindow(leftWindow),
+          mRightWindow(rightWindow),
+          mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableJoinOnKey>();
+    }
+
+    ~ObservableJoinOnKey() override
+    {
+        LeakObserver::release<ObservableJoinOnKey>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        std::shared_ptr<KeyedJoinObserver> parent;
+        if (mScheduler) {
+            parent = std::make_shared<KeyedJoinObserver>(
+                observer,
+                mLeftKeySelector,
+                mRightKeySelector,
+                mLeftWindow,
+                mRightWindow,
+                mResultSelector,
+                mScheduler->createWorker()
+            );
+        } else {
+            parent = std::make_shared<KeyedJoinObserver>(
+                observer,
+                mLeftKeySelector,
+                mRightKeySelector,
+                mLeftDurationSelector,
+                mRightDurationSelector,
+                mResultSelector
+            );
+        }
+
+        observer->onSubscribe(parent);
+        parent->subscribe(mSource, mOther);
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    ObservableSourcePtr mOther;
+    MapFunction mLeftKeySelector;
+    MapFunction mRightKeySelector;
+    FlatMapFunction mLeftDurationSelector;
+    FlatMapFunction mRightDurationSelector;
+    BiFunction mResultSelector;
+    uint64_t mLeftWindow = 0;
+    uint64_t mRightWindow = 0;
+    SchedulerPtr mScheduler;
+};
+} // rx
+
+#endif // RX_OBSERVABLE_JOIN_ON_KEY_H
@@ -0,0 +1,282 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_MAP_ASYNC_H
+#define RX_OBSERVABLE_MAP_ASYNC_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../exception_helper.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+#include "../producer_park.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+namespace rx
+{
+// Runs the mapper for up to maxConcurrency values at once and emits the results in input order.
+// Value n is mapped on worker n % maxConcurrency into slot n % maxConcurrency of a reorder ring, it is only
+// dispatched once value n - maxConcurrency has been emitted, so a slot and its worker are always free by then.
+// Whichever thread wins the WIP counter emits the ready slots at the head of the ring.
+class MapAsyncObserver : public Observer, public Disposable, public std::enable_shared_from_this<MapAsyncObserver>
+{
+public:
+    MapAsyncObserver(const ObserverPtr &downstream, const MapFunction &function, const SchedulerPtr &scheduler,
+                     uint32_t maxConcurrency)
+        : mDownstream(downstream),
+          mFunction(function),
+          mMaxConcurrency(maxConcurrency),
+          mSlots(std::make_unique<Slot[]>(maxConcurrency))
+    {
+        LeakObserver::make<MapAsyncObserver>();
+        mWorkers.reserve(maxConcurrency);
+        for (uint32_t i = 0; i < maxConcurrency; ++i) {
+            mWorkers.push_back(scheduler->createWorker());
+        }
+    }
+
+    ~MapAsyncObserver() override
+    {
+        LeakObserver::release<MapAsyncObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        const uint64_t sequence = mSubmitted.load(std::memory_order_relaxed);
+        // All slots busy, hold the upstream thread back until the head of the ring has been emitted
+        while (sequence - mEmitted.load(std::memory_order_acquire) >= mMaxConcurrency) {
+            if (stopped()) {
+                return;
+            }
+            mPark.parkWhile([this, sequence] {
+                return sequence - mEmitted.load(std::memory_order_acquire) >= mMaxConcurrency && !stopped();
+            });
+        }
+
+        const size_t slot = sequence % mMaxConcurrency;
+        mSubmitted.store(sequence + 1, std::memory_order_release);
+        std::weak_ptr<MapAsyncObserver> weakSelf = shared_from_this();
+        mWorkers[slot]->schedule([weakSelf, slot, value] {
+            if (const auto self = weakSelf.lock()) {
+                self->run(slot, value);
+            }
+        });
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        mDone.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void onComplete() override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mDone.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void dispose() override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto d = mUpstream) {
+            d->dispose();
+        }
+        disposeWorkers();
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    // Result of the value at one ring position, filled by its worker and emptied by the drain
+    struct alignas(64) Slot
+    {
+        GAny value;
+        std::unique_ptr<GAnyException> error;
+        std::atomic<bool> ready = false;
+    };
+
+    // Disposed, or the downstream already received its terminal event
+    bool stopped() const
+    {
+        return isDisposed() || mTerminated.load(std::memory_order_acquire);
+    }
+
+    void run(size_t slot, const GAny &value)
+    {
+        if (stopped()) {
+            return;
+        }
+        auto &s = mSlots[slot];
+        try {
+            s.value = mFunction(value);
+        } catch (...) {
+            s.error = std::make_unique<GAnyException>(
+                ExceptionHelper::fromCurrentException("MapAsync: Mapper failed"));
+        }
+        s.ready.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        while (true) {
+            while (true) {
+                if (isDisposed()) {
+                    clear();
+                    return;
+                }
+                // Read before mSubmitted, every value dispatched before the terminal event is then counted
+                const bool done = mDone.load(std::memory_order_acquire);
+                const uint64_t emitted = mEmitted.load(std::memory_order_relaxed);
+                if (emitted == mSubmitted.load(std::memory_order_acquire)) {
+                    if (done) {
+                        terminate(mError.get());
+                        return;
+                    }
+                    break;
+                }
+
+                auto &slot = mSlots[emitted % mMaxConcurrency];
+                if (!slot.ready.load(std::memory_order_acquire)) {
+                    break;
+                }
+                if (slot.error) {
+                    if (const auto d = mUpstream) {
+                        d->dispose();
+                    }
+                    terminate(slot.error.get());
+                    return;
+                }
+                const GAny value = std::move(slot.value);
+                slot.value = GAny();
+                slot.ready.store(false, std::memory_order_relaxed);
+                mEmitted.store(emitted + 1, std::memory_order_release);
+                mPark.wake();
+                mDownstream->onNext(value);
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    // Stops the workers and releases a parked upstream before the terminal goes out
+    void terminate(const GAnyException *error)
+    {
+        mTerminated.store(true, std::memory_order_release);
+        disposeWorkers();
+        mPark.wake();
+        const auto downstream = std::move(mDownstream);
+        if (error) {
+            downstream->onError(*error);
+        } else {
+            downstream->onComplete();
+        }
+    }
+
+    void disposeWorkers()
+    {
+        for (const auto &worker: mWorkers) {
+            worker->dispose();
+        }
+        mPark.wake();
+    }
+
+    void clear()
+    {
+        mDownstream = nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    MapFunction mFunction;
+    const uint32_t mMaxConcurrency;
+    std::unique_ptr<Slot[]> mSlots;
+    std::vector<WorkerPtr> mWorkers;
+    DisposablePtr mUpstream;
+
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+    alignas(64) std::atomic<uint64_t> mSubmitted = 0; // Written by the upstream thread
+    alignas(64) std::atomic<uint64_t> mEmitted = 0;   // Written by the draining thread
+
+    ProducerPark mPark;
+
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mTerminated = false;
+    std::atomic<bool> mDisposed = false;
+};
+
+class ObservableMapAsync : public Observable
+{
+public:
+    ObservableMapAsync(ObservableSourcePtr source, MapFunction function, SchedulerPtr scheduler,
+                       uint32_t maxConcurrency)
+        : mSource(std::move(source)),
+          mFunction(std::move(function)),
+          mScheduler(std::move(scheduler)),
+          mMaxConcurrency(maxConcurrency)
+    {
+        LeakObserver::make<ObservableMapAsync>();
+    }
+
+    ~ObservableMapAsync() override
+    {
+        LeakObserver::release<ObservableMapAsync>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<MapAsyncObserver>(observer, mFunction, mScheduler, mMaxConcurrency));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    MapFunction mFunction;
+    SchedulerPtr mScheduler;
+    uint32_t mMaxConcurrency;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_MAP_ASYNC_H
@@ -0,0 +1,305 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_MERGE_SORTED_H
+#define RX_OBSERVABLE_MERGE_SORTED_H
+
+#include "../observable.h"
+#include "../exception_helper.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+#include "../spsc_queue.h"
+#include "../producer_park.h"
+#include "multi_source_drain.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace rx
+{
+class MergeSortedCoordinator;
+
+class MergeSortedInnerObserver : public Observer
+{
+public:
+    MergeSortedInnerObserver(const std::shared_ptr<MergeSortedCoordinator> &parent, size_t index)
+        : mParent(parent), mIndex(index)
+    {
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override;
+
+    void onNext(const GAny &value) override;
+
+    void onError(const GAnyException &e) override;
+
+    void onComplete() override;
+
+private:
+    std::weak_ptr<MergeSortedCoordinator> mParent;
+    size_t mIndex;
+};
+
+// Each source feeds its own SPSC queue. The draining thread keeps at most one head per source in a min-heap
+// and emits the smallest head only while every source that has not completed has one, so the output follows
+// the comparator as long as each source is ordered. Ties go to the lower source index.
+// With a prefetch, a value arriving while its source has that many queued fails the stream, is dropped, or with
+// OverflowStrategy::Block holds the source back on its own thread until the drain takes one. Sources emitting
+// on the subscribing thread while subscribe() runs are never limited, the later sources they wait for are not
+// subscribed yet.
+class MergeSortedCoordinator : public MultiSourceDrain, public std::enable_shared_from_this<MergeSortedCoordinator>
+{
+public:
+    MergeSortedCoordinator(const ObserverPtr &downstream, const ComparatorFunction &comparator, size_t count,
+                           size_t prefetch, OverflowStrategy strategy)
+        : MultiSourceDrain(downstream), mComparator(comparator), mPrefetch(prefetch), mStrategy(strategy),
+          mDone(count)
+    {
+        LeakObserver::make<MergeSortedCoordinator>();
+        mQueues.reserve(count);
+        mMissing.reserve(count);
+        mHeap.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            mQueues.push_back(std::make_unique<SpscQueue>());
+            mMissing.push_back(i);
+        }
+    }
+
+    ~MergeSortedCoordinator() override
+    {
+        LeakObserver::release<MergeSortedCoordinator>();
+    }
+
+public:
+    void subscribe(const std::vector<std::shared_ptr<Observable> > &sources)
+    {
+        mSubscribingThread = std::this_thread::get_id();
+        mSubscribing.store(true, std::memory_order_release);
+        for (size_t i = 0; i < sources.size(); ++i) {
+            if (isCancelled()) {
+                break;
+            }
+            sources[i]->subscribe(std::make_shared<MergeSortedInnerObserver>(shared_from_this(), i));
+        }
+        mSubscribing.store(false, std::memory_order_release);
+    }
+
+    void onNext(size_t index, const GAny &value)
+    {
+        if (isCancelled() || mDone[index].load(std::memory_order_acquire)) {
+            return;
+        }
+        const auto &queue = mQueues[index];
+        if (mPrefetch > 0 && queue->size() >= mPrefetch && !emittingOnSubscribe()) {
+            switch (mStrategy) {
+                case OverflowStrategy::Error:
+                    onError(GAnyException("MergeSorted: Source buffer exceeded its prefetch of " +
+                                          std::to_string(mPrefetch)));
+                    return;
+                case OverflowStrategy::DropLatest:
+                    return;
+                case OverflowStrategy::Block:
+                    if (!holdBack(*queue)) {
+                        return;
+                    }
+                    break;
+            }
+        }
+        queue->offer(value);
+        drain();
+    }
+
+    void onComplete(size_t index)
+    {
+        mDone[index].store(true, std::memory_order_release);
+        drain();
+    }
+
+protected:
+    bool drainNext() override
+    {
+        const auto after = [this](const Head &a, const Head &b) { return this->after(a, b); };
+        try {
+            if (!fillHeads()) {
+                return false;
+            }
+            if (mHeap.empty()) {
+                complete();
+                return true;
+            }
+            std::pop_heap(mHeap.begin(), mHeap.end(), after);
+        } catch (...) {
+            fail(ExceptionHelper::fromCurrentException("MergeSorted: Comparator failed"));
+            return true;
+        }
+        Head head = std::move(mHeap.back());
+        mHeap.pop_back();
+        mMissing.push_back(head.source);
+        emit(head.value);
+        return true;
+    }
+
+    void clearQueues() override
+    {
+        for (const auto &queue: mQueues) {
+            queue->clear();
+        }
+        mHeap.clear();
+    }
+
+private:
+    struct Head
+    {
+        GAny value;
+        size_t source;
+    };
+
+    bool less(const GAny &a, const GAny &b) const
+    {
+        if (mComparator) {
+            return mComparator(a, b);
+        }
+        return a < b;
+    }
+
+    // Heap order for std's max-heap, so the smallest head ends up on top
+    bool after(const Head &a, const Head &b) const
+    {
+        if (less(b.value, a.value)) {
+            return true;
+        }
+        return !less(a.value, b.value) && a.source > b.source;
+    }
+
+    bool emittingOnSubscribe() const
+    {
+        return mSubscribing.load(std::memory_order_acquire) && std::this_thread::get_id() == mSubscribingThread;
+    }
+
+    // Parks the source thread while its queue is full, false once the merge is cancelled
+    bool holdBack(const SpscQueue &queue)
+    {
+        while (queue.size() >= mPrefetch) {
+            if (isCancelled()) {
+                return false;
+            }
+            mPark.parkWhile([this, &queue] { return queue.size() >= mPrefetch && !isCancelled(); });
+        }
+        return true;
+    }
+
+    // Moves the next value of every source without a head into the heap, false while a live source has none
+    bool fillHeads()
+    {
+        const auto after = [this](const Head &a, const Head &b) { return this->after(a, b); };
+        bool ready = true;
+        bool polled = false;
+        auto keep = mMissing.begin();
+        for (const size_t source: mMissing) {
+            // Read done before polling, the last offer happens before the done flag
+            const bool done = mDone[source].load(std::memory_order_acquire);
+            Head head{GAny(), source};
+            if (mQueues[source]->poll(head.value)) {
+                polled = true;
+                mHeap.push_back(std::move(head));
+                std::push_heap(mHeap.begin(), mHeap.end(), after);
+            } else if (!done) {
+                *keep++ = source;
+                ready = false;
+            }
+        }
+        mMissing.erase(keep, mMissing.end());
+        if (polled) {
+            mPark.wake();
+        }
+        return ready;
+    }
+
+private:
+    ComparatorFunction mComparator;
+    size_t mPrefetch;
+    OverflowStrategy mStrategy;
+    std::vector<std::unique_ptr<SpscQueue> > mQueues;
+    std::vector<std::atomic<bool> > mDone;
+
+    // Owned by the draining thread
+    std::vector<Head> mHeap;
+    std::vector<size_t> mMissing; // Sources whose head is not in the heap
+
+    std::thread::id mSubscribingThread; // Written before mSubscribing is set
+    std::atomic<bool> mSubscribing = false;
+    ProducerPark mPark;
+};
+
+inline void MergeSortedInnerObserver::onSubscribe(const DisposablePtr &d)
+{
+    if (const auto p = mParent.lock()) {
+        p->onSubscribe(d);
+    }
+}
+
+inline void MergeSortedInnerObserver::onNext(const GAny &value)
+{
+    if (const auto p = mParent.lock()) {
+        p->onNext(mIndex, value);
+    }
+}
+
+inline void MergeSortedInnerObserver::onError(const GAnyException &e)
+{
+    if (const auto p = mParent.lock()) {
+        p->onError(e);
+    }
+}
+
+inline void MergeSortedInnerObserver::onComplete()
+{
+    if (const auto p = mParent.lock()) {
+        p->onComplete(mIndex);
+    }
+}
+
+class ObservableMergeSorted : public Observable
+{
+public:
+    ObservableMergeSorted(std::vector<std::shared_ptr<Observable> > sources, ComparatorFunction comparator,
+                          size_t prefetch, OverflowStrategy strategy)
+        : mSources(std::move(sources)), mComparator(std::move(comparator)), mPrefetch(prefetch), mStrategy(strategy)
+    {
+        LeakObserver::make<ObservableMergeSorted>();
+    }
+
+    ~ObservableMergeSorted() override
+    {
+        LeakObserver::release<ObservableMergeSorted>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        if (mSources.empty()) {
+            observer->onSubscribe(DisposableHelper::disposed());
+            observer->onComplete();
+            return;
+        }
+        const auto coordinator = std::make_shared<MergeSortedCoordinator>(observer, mComparator, mSources.size(),
+                                                                          mPrefetch, mStrategy);
+        observer->onSubscribe(coordinator);
+        coordinator->subscribe(mSources);
+    }
+
+private:
+    std::vector<std::shared_ptr<Observable> > mSources;
+    ComparatorFunction mComparator;
+    size_t mPrefetch;
+    OverflowStrategy mStrategy;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_MERGE_SORTED_H
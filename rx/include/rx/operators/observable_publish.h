@@ -0,0 +1,311 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_PUBLISH_H
+#define RX_OBSERVABLE_PUBLISH_H
+
+#include "../connectable_observable.h"
+#include "../disposables/disposable_helper.h"
+#include "../subscriber_array.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+
+
+namespace rx
+{
+class PublishConnection;
+class ObservablePublish;
+
+class PublishInnerDisposable : public Disposable
+{
+public:
+    PublishInnerDisposable(const ObserverPtr &downstream, const std::shared_ptr<PublishConnection> &connection)
+        : mDownstream(downstream), mConnection(connection)
+    {
+        LeakObserver::make<PublishInnerDisposable>();
+    }
+
+    ~PublishInnerDisposable() override
+    {
+        LeakObserver::release<PublishInnerDisposable>();
+    }
+
+public:
+    void onNext(const GAny &value) const
+    {
+        if (!isDisposed()) {
+            if (const auto d = mDownstream) {
+                d->onNext(value);
+            }
+        }
+    }
+
+    void onError(const GAnyException &e)
+    {
+        if (!isDisposed()) {
+            if (const auto d = mDownstream) {
+                d->onError(e);
+            }
+        }
+        mDownstream = nullptr;
+    }
+
+    void onComplete()
+    {
+        if (!isDisposed()) {
+            if (const auto d = mDownstream) {
+                d->onComplete();
+            }
+        }
+        mDownstream = nullptr;
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::shared_ptr<PublishConnection> mConnection;
+    std::atomic<bool> mDisposed = false;
+};
+
+// One upstream subscription fanned out to every current observer through a copy-on-write
+// SubscriberArray, so delivering a value takes no lock and allocates nothing.
+class PublishConnection : public Observer, public Disposable, public std::enable_shared_from_this<PublishConnection>
+{
+public:
+    explicit PublishConnection(const std::weak_ptr<ObservablePublish> &parent)
+        : mParent(parent)
+    {
+        LeakObserver::make<PublishConnection>();
+    }
+
+    ~PublishConnection() override
+    {
+        LeakObserver::release<PublishConnection>();
+    }
+
+public:
+    // Fails once the connection has terminated or was disposed
+    bool add(const std::shared_ptr<PublishInnerDisposable> &inner)
+    {
+        return mSubscribers.add(inner);
+    }
+
+    void remove(const PublishInnerDisposable *inner)
+    {
+        mSubscribers.remove(inner);
+    }
+
+    bool tryConnect()
+    {
+        return !mConnected.exchange(true, std::memory_order_acq_rel);
+    }
+
+    bool isDone() const
+    {
+        return mDone.load(std::memory_order_acquire);
+    }
+
+    const std::unique_ptr<GAnyException> &error() const
+    {
+        return mError;
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        DisposableHelper::setOnce(mUpstream, d, mLock);
+    }
+
+    void onNext(const GAny &value) override
+    {
+        const auto subscribers = mSubscribers.load();
+        for (const auto &inner: *subscribers) {
+            inner->onNext(value);
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        const auto subscribers = terminate();
+        for (const auto &inner: *subscribers) {
+            inner->onError(e);
+        }
+    }
+
+    void onComplete() override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        const auto subscribers = terminate();
+        for (const auto &inner: *subscribers) {
+            inner->onComplete();
+        }
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    SubscriberArray<PublishInnerDisposable>::ItemsPtr terminate()
+    {
+        mDone.store(true, std::memory_order_release);
+        mDisposed.store(true, std::memory_order_release);
+        {
+            GLockerGuard lock(mLock);
+            mUpstream = DisposableHelper::disposed();
+        }
+        return mSubscribers.terminate();
+    }
+
+private:
+    std::weak_ptr<ObservablePublish> mParent;
+    SubscriberArray<PublishInnerDisposable> mSubscribers;
+    DisposablePtr mUpstream;
+    GMutex mLock;
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mConnected = false;
+    std::atomic<bool> mDone = false;
+    std::atomic<bool> mDisposed = false;
+};
+
+class ObservablePublish : public ConnectableObservable
+{
+public:
+    explicit ObservablePublish(ObservableSourcePtr source)
+        : mSource(std::move(source))
+    {
+        LeakObserver::make<ObservablePublish>();
+    }
+
+    ~ObservablePublish() override
+    {
+        LeakObserver::release<ObservablePublish>();
+    }
+
+public:
+    using ConnectableObservable::connect;
+
+    void connect(const ConnectionCallback &onConnect) override
+    {
+        std::shared_ptr<PublishConnection> connection;
+        while (true) {
+            connection = mCurrent.load(std::memory_order_acquire);
+            if (!connection || connection->isDisposed()) {
+                auto fresh = std::make_shared<PublishConnection>(self());
+                if (!mCurrent.compare_exchange_strong(connection, fresh, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                connection = std::move(fresh);
+            }
+            break;
+        }
+
+        const bool doConnect = connection->tryConnect();
+        if (onConnect) {
+            onConnect(connection);
+        }
+        if (doConnect) {
+            mSource->subscribe(connection);
+        }
+    }
+
+    void reset() override
+    {
+        auto connection = mCurrent.load(std::memory_order_acquire);
+        if (connection && connection->isDisposed()) {
+            mCurrent.compare_exchange_strong(connection, nullptr, std::memory_order_acq_rel);
+        }
+    }
+
+    // Called by a disposed connection so the next connect() or subscriber starts a fresh one
+    void clearCurrent(const std::shared_ptr<PublishConnection> &connection)
+    {
+        auto expected = connection;
+        mCurrent.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        std::shared_ptr<PublishConnection> connection;
+        while (true) {
+            // A terminated connection is kept until reset(), late observers receive its terminal event
+            connection = mCurrent.load(std::memory_order_acquire);
+            if (!connection) {
+                auto fresh = std::make_shared<PublishConnection>(self());
+                if (!mCurrent.compare_exchange_strong(connection, fresh, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                connection = std::move(fresh);
+            }
+            break;
+        }
+
+        const auto inner = std::make_shared<PublishInnerDisposable>(observer, connection);
+        observer->onSubscribe(inner);
+        if (connection->add(inner)) {
+            if (inner->isDisposed()) {
+                connection->remove(inner.get());
+            }
+            return;
+        }
+        if (const auto &error = connection->error()) {
+            inner->onError(*error);
+        } else {
+            inner->onComplete();
+        }
+    }
+
+private:
+    std::weak_ptr<ObservablePublish> self()
+    {
+        return std::static_pointer_cast<ObservablePublish>(shared_from_this());
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    std::atomic<std::shared_ptr<PublishConnection> > mCurrent;
+};
+
+inline void PublishInnerDisposable::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (const auto connection = std::move(mConnection)) {
+        connection->remove(this);
+    }
+    mDownstream = nullptr;
+}
+
+inline void PublishConnection::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    mSubscribers.terminate();
+    if (const auto parent = mParent.lock()) {
+        parent->clearCurrent(shared_from_this());
+    }
+    DisposableHelper::dispose(mUpstream, mLock);
+}
+} // rx
+
+#endif //RX_OBSERVABLE_PUBLISH_H
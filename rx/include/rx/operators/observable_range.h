@@ -6,7 +6,10 @@
 #define RX_OBSERVABLE_RANGE_H
 
 #include "../observable.h"
+#include "../scheduler.h"
+#include "../sized_source.h"
 #include "../leak_observer.h"
+#include "scheduled_emission.h"
 
 
 namespace rx
@@ -52,11 +55,11 @@ private:
     uint64_t mCount;
 };
 
-class ObservableRange : public Observable
+class ObservableRange : public Observable, public SizedSource
 {
 public:
-    explicit ObservableRange(int64_t start, uint64_t count)
-        : mStart(start), mCount(count)
+    explicit ObservableRange(int64_t start, uint64_t count, SchedulerPtr scheduler = nullptr, uint64_t chunkSize = 0)
+        : mStart(start), mCount(count), mScheduler(std::move(scheduler)), mChunkSize(chunkSize)
     {
         LeakObserver::make<ObservableRange>();
     }
@@ -66,9 +69,28 @@ public:
         LeakObserver::release<ObservableRange>();
     }
 
+public:
+    uint64_t itemCount() const override
+    {
+        return mCount;
+    }
+
+    GAny itemAt(uint64_t index) const override
+    {
+        return static_cast<int64_t>(static_cast<uint64_t>(mStart) + index);
+    }
+
 protected:
     void subscribeActual(const ObserverPtr &observer) override
     {
+        if (mScheduler) {
+            const auto parent = std::make_shared<ScheduledEmissionDisposable>(
+                observer, std::static_pointer_cast<ObservableRange>(shared_from_this()), mScheduler->createWorker(),
+                mChunkSize);
+            observer->onSubscribe(parent);
+            parent->start();
+            return;
+        }
         const auto parent = std::make_shared<RangeDisposable>(observer, mStart, mCount);
         observer->onSubscribe(parent);
         parent->run();
@@ -77,6 +99,8 @@ protected:
 private:
     int64_t mStart;
     uint64_t mCount;
+    SchedulerPtr mScheduler;
+    uint64_t mChunkSize;
 };
 } // rx
 
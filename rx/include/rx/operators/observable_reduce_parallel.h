@@ -0,0 +1,332 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_REDUCE_PARALLEL_H
+#define RX_OBSERVABLE_REDUCE_PARALLEL_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../sized_source.h"
+#include "../exception_helper.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace rx
+{
+// Sized sources are cut into chunks of about one L2 cache worth of values. Workers claim chunks from a shared
+// counter and fold each one from identity, the worker that finishes the last chunk combines the partial
+// results pairwise, level by level, which keeps them in source order.
+class ReduceParallelCoordinator : public Disposable, public std::enable_shared_from_this<ReduceParallelCoordinator>
+{
+public:
+    ReduceParallelCoordinator(const ObserverPtr &downstream, const std::shared_ptr<SizedSource> &source,
+                              const GAny &identity, const BiFunction &accumulator, const BiFunction &combiner)
+        : mDownstream(downstream),
+          mSource(source),
+          mIdentity(identity),
+          mAccumulator(accumulator),
+          mCombiner(combiner),
+          mCount(source->itemCount()),
+          mChunkSize(std::max<uint64_t>(1, ChunkBytes / sizeof(GAny))),
+          mChunks((mCount + mChunkSize - 1) / mChunkSize),
+          mPartials(mChunks),
+          mRemaining(mChunks)
+    {
+        LeakObserver::make<ReduceParallelCoordinator>();
+    }
+
+    ~ReduceParallelCoordinator() override
+    {
+        LeakObserver::release<ReduceParallelCoordinator>();
+    }
+
+public:
+    void start(const SchedulerPtr &scheduler)
+    {
+        if (mChunks == 0) {
+            if (!mTerminated.exchange(true, std::memory_order_acq_rel)) {
+                const auto downstream = std::move(mDownstream);
+                downstream->onNext(mIdentity);
+                downstream->onComplete();
+            }
+            return;
+        }
+        // The downstream got the coordinator in onSubscribe() and may have disposed it already
+        if (mTerminated.load(std::memory_order_acquire)) {
+            return;
+        }
+        const uint64_t count = std::min<uint64_t>(mChunks, std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<WorkerPtr> workers;
+        workers.reserve(count);
+        for (uint64_t i = 0; i < count; ++i) {
+            workers.push_back(scheduler->createWorker());
+        }
+        {
+            GLockerGuard lock(mWorkersLock);
+            mWorkers = workers;
+        }
+        const auto self = shared_from_this();
+        for (const auto &worker: workers) {
+            worker->schedule([self] { self->run(); });
+        }
+        // A dispose() that landed before the workers were published found none to dispose
+        if (mTerminated.load(std::memory_order_acquire)) {
+            disposeWorkers();
+        }
+    }
+
+    void dispose() override
+    {
+        mDisposed.store(true, std::memory_order_release);
+        if (mTerminated.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        disposeWorkers();
+        mDownstream = nullptr;
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    // Per-core L2 share on common desktop and server parts
+    static constexpr uint64_t ChunkBytes = 256 * 1024;
+
+    void run()
+    {
+        while (!mTerminated.load(std::memory_order_acquire)) {
+            const uint64_t chunk = mNextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= mChunks) {
+                return;
+            }
+            const uint64_t begin = chunk * mChunkSize;
+            const uint64_t end = std::min(mCount, begin + mChunkSize);
+            GAny acc = mIdentity;
+            try {
+                for (uint64_t i = begin; i < end; ++i) {
+                    acc = mAccumulator(acc, mSource->itemAt(i));
+                }
+            } catch (...) {
+                fail(ExceptionHelper::fromCurrentException("ReduceParallel: Accumulator failed"));
+                return;
+            }
+            mPartials[chunk] = std::move(acc);
+            if (mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                combine();
+                return;
+            }
+        }
+    }
+
+    // Runs on the worker that finished the last chunk, the acquire on mRemaining makes every partial visible
+    void combine()
+    {
+        if (mTerminated.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        disposeWorkers();
+        const auto downstream = std::move(mDownstream);
+        try {
+            for (size_t width = 1; width < mPartials.size(); width *= 2) {
+                for (size_t i = 0; i + width < mPartials.size(); i += 2 * width) {
+                    mPartials[i] = mCombiner(mPartials[i], mPartials[i + width]);
+                    mPartials[i + width] = GAny();
+                }
+            }
+        } catch (...) {
+            downstream->onError(ExceptionHelper::fromCurrentException("ReduceParallel: Combiner failed"));
+            return;
+        }
+        const GAny result = std::move(mPartials[0]);
+        mPartials.clear();
+        downstream->onNext(result);
+        downstream->onComplete();
+    }
+
+    void fail(const GAnyException &e)
+    {
+        if (mTerminated.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        disposeWorkers();
+        const auto downstream = std::move(mDownstream);
+        downstream->onError(e);
+    }
+
+    // Takes the workers out, the downstream keeps this coordinator as its Disposable after the terminal
+    void disposeWorkers()
+    {
+        std::vector<WorkerPtr> workers;
+        {
+            GLockerGuard lock(mWorkersLock);
+            workers = std::move(mWorkers);
+            mWorkers.clear();
+        }
+        for (const auto &worker: workers) {
+            worker->dispose();
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::shared_ptr<SizedSource> mSource;
+    GAny mIdentity;
+    BiFunction mAccumulator;
+    BiFunction mCombiner;
+    const uint64_t mCount;
+    const uint64_t mChunkSize;
+    const uint64_t mChunks;
+    std::vector<GAny> mPartials; // One slot per chunk, each written by the worker that folded it
+    std::vector<WorkerPtr> mWorkers; // Published by start() under mWorkersLock, disposed from any thread
+    GMutex mWorkersLock;
+    alignas(64) std::atomic<uint64_t> mNextChunk = 0;
+    alignas(64) std::atomic<uint64_t> mRemaining;
+    std::atomic<bool> mTerminated = false;
+    std::atomic<bool> mDisposed = false;
+};
+
+// Fallback for sources of unknown size: a plain left fold starting from identity
+class ReduceSeedObserver : public Observer, public Disposable, public std::enable_shared_from_this<ReduceSeedObserver>
+{
+public:
+    ReduceSeedObserver(const ObserverPtr &downstream, const GAny &identity, const BiFunction &accumulator)
+        : mDownstream(downstream), mValue(identity), mAccumulator(accumulator)
+    {
+        LeakObserver::make<ReduceSeedObserver>();
+    }
+
+    ~ReduceSeedObserver() override
+    {
+        LeakObserver::release<ReduceSeedObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        try {
+            mValue = mAccumulator(mValue, value);
+        } catch (...) {
+            if (const auto up = mUpstream) {
+                up->dispose();
+            }
+            onError(ExceptionHelper::fromCurrentException("ReduceParallel: Accumulator failed"));
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto d = mDownstream) {
+            d->onError(e);
+        }
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    void onComplete() override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto d = mDownstream) {
+            d->onNext(mValue);
+            d->onComplete();
+        }
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    void dispose() override
+    {
+        mDisposed.store(true, std::memory_order_release);
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto d = mUpstream) {
+            d->dispose();
+        }
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    GAny mValue;
+    BiFunction mAccumulator;
+    std::atomic<bool> mDone = false;
+    std::atomic<bool> mDisposed = false;
+};
+
+class ObservableReduceParallel : public Observable
+{
+public:
+    ObservableReduceParallel(ObservableSourcePtr source, GAny identity, BiFunction accumulator, BiFunction combiner,
+                             SchedulerPtr scheduler)
+        : mSource(std::move(source)),
+          mIdentity(std::move(identity)),
+          mAccumulator(std::move(accumulator)),
+          mCombiner(std::move(combiner)),
+          mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableReduceParallel>();
+    }
+
+    ~ObservableReduceParallel() override
+    {
+        LeakObserver::release<ObservableReduceParallel>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        if (const auto sized = std::dynamic_pointer_cast<SizedSource>(mSource)) {
+            const auto coordinator = std::make_shared<ReduceParallelCoordinator>(
+                observer, sized, mIdentity, mAccumulator, mCombiner);
+            observer->onSubscribe(coordinator);
+            coordinator->start(mScheduler);
+            return;
+        }
+        mSource->subscribe(std::make_shared<ReduceSeedObserver>(observer, mIdentity, mAccumulator));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    GAny mIdentity;
+    BiFunction mAccumulator;
+    BiFunction mCombiner;
+    SchedulerPtr mScheduler;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_REDUCE_PARALLEL_H
@@ -0,0 +1,270 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_REF_COUNT_H
+#define RX_OBSERVABLE_REF_COUNT_H
+
+#include "../connectable_observable.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+
+
+namespace rx
+{
+// Book-keeping for one connection of the underlying ConnectableObservable, guarded by the operator lock
+struct RefConnection
+{
+    uint64_t subscriberCount = 0;
+    bool connected = false;
+    bool disconnectedEarly = false; // Timed out before connect() handed over the connection
+    DisposablePtr connection;
+    WorkerPtr timer;
+};
+
+class ObservableRefCount;
+
+class RefCountObserver : public Observer, public Disposable, public std::enable_shared_from_this<RefCountObserver>
+{
+public:
+    RefCountObserver(const ObserverPtr &downstream, const std::shared_ptr<ObservableRefCount> &parent,
+                     const std::shared_ptr<RefConnection> &connection)
+        : mDownstream(downstream), mParent(parent), mConnection(connection)
+    {
+        LeakObserver::make<RefCountObserver>();
+    }
+
+    ~RefCountObserver() override
+    {
+        LeakObserver::release<RefCountObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (const auto ds = mDownstream) {
+            ds->onNext(value);
+        }
+    }
+
+    void onError(const GAnyException &e) override;
+
+    void onComplete() override;
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::shared_ptr<ObservableRefCount> mParent;
+    std::shared_ptr<RefConnection> mConnection;
+    DisposablePtr mUpstream;
+    std::atomic<bool> mDone = false;     // Terminated or disposed, whichever came first releases the connection
+    std::atomic<bool> mDisposed = false;
+};
+
+class ObservableRefCount : public Observable
+{
+public:
+    ObservableRefCount(std::shared_ptr<ConnectableObservable> source, uint32_t minSubscribers,
+                       uint64_t gracePeriod, SchedulerPtr scheduler)
+        : mSource(std::move(source)),
+          mMinSubscribers(minSubscribers),
+          mGracePeriod(gracePeriod),
+          mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableRefCount>();
+    }
+
+    ~ObservableRefCount() override
+    {
+        LeakObserver::release<ObservableRefCount>();
+    }
+
+public:
+    // An observer went away without a terminal event
+    void cancel(const std::shared_ptr<RefConnection> &rc)
+    {
+        WorkerPtr timer;
+        {
+            GLockerGuard lock(mLock);
+            if (mConnection != rc) {
+                return;
+            }
+            if (--rc->subscriberCount != 0 || !rc->connected) {
+                return;
+            }
+            if (mGracePeriod > 0) {
+                timer = mScheduler->createWorker();
+                rc->timer = timer;
+            }
+        }
+        if (!timer) {
+            timeout(rc);
+            return;
+        }
+
+        std::weak_ptr<ObservableRefCount> weakSelf = std::static_pointer_cast<ObservableRefCount>(shared_from_this());
+        std::weak_ptr<RefConnection> weakConnection = rc;
+        timer->schedule([weakSelf, weakConnection] {
+            const auto self = weakSelf.lock();
+            const auto connection = weakConnection.lock();
+            if (self && connection) {
+                self->timeout(connection);
+            }
+        }, mGracePeriod);
+    }
+
+    // An observer received the terminal event, the last one lets the next subscriber reconnect
+    void terminated(const std::shared_ptr<RefConnection> &rc)
+    {
+        WorkerPtr timer;
+        bool reset = false;
+        {
+            GLockerGuard lock(mLock);
+            if (mConnection != rc) {
+                return;
+            }
+            timer = std::move(rc->timer);
+            if (--rc->subscriberCount == 0) {
+                mConnection = nullptr;
+                reset = true;
+            }
+        }
+        if (timer) {
+            timer->dispose();
+        }
+        if (reset) {
+            mSource->reset();
+        }
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        std::shared_ptr<RefConnection> rc;
+        WorkerPtr timer;
+        bool connect = false;
+        {
+            GLockerGuard lock(mLock);
+            rc = mConnection;
+            if (!rc) {
+                rc = std::make_shared<RefConnection>();
+                mConnection = rc;
+            }
+            ++rc->subscriberCount;
+            timer = std::move(rc->timer);
+            if (!rc->connected && rc->subscriberCount == mMinSubscribers) {
+                connect = rc->connected = true;
+            }
+        }
+        if (timer) {
+            timer->dispose();
+        }
+
+        mSource->subscribe(std::make_shared<RefCountObserver>(
+            observer, std::static_pointer_cast<ObservableRefCount>(shared_from_this()), rc));
+
+        if (connect) {
+            mSource->connect([this, rc](const DisposablePtr &connection) {
+                bool disconnected;
+                {
+                    GLockerGuard lock(mLock);
+                    rc->connection = connection;
+                    disconnected = rc->disconnectedEarly;
+                }
+                if (disconnected) {
+                    connection->dispose();
+                }
+            });
+        }
+    }
+
+private:
+    void timeout(const std::shared_ptr<RefConnection> &rc)
+    {
+        DisposablePtr connection;
+        WorkerPtr timer;
+        {
+            GLockerGuard lock(mLock);
+            if (rc->subscriberCount != 0 || mConnection != rc) {
+                return;
+            }
+            mConnection = nullptr;
+            timer = std::move(rc->timer);
+            connection = std::move(rc->connection);
+            if (!connection) {
+                rc->disconnectedEarly = true;
+            }
+        }
+        if (timer) {
+            timer->dispose();
+        }
+        if (connection) {
+            connection->dispose();
+        }
+        mSource->reset();
+    }
+
+private:
+    std::shared_ptr<ConnectableObservable> mSource;
+    uint32_t mMinSubscribers;
+    uint64_t mGracePeriod;
+    SchedulerPtr mScheduler;
+    GMutex mLock;
+    std::shared_ptr<RefConnection> mConnection;
+};
+
+inline void RefCountObserver::onError(const GAnyException &e)
+{
+    if (mDone.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    mParent->terminated(mConnection);
+    if (const auto ds = std::move(mDownstream)) {
+        ds->onError(e);
+    }
+    mUpstream = nullptr;
+}
+
+inline void RefCountObserver::onComplete()
+{
+    if (mDone.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    mParent->terminated(mConnection);
+    if (const auto ds = std::move(mDownstream)) {
+        ds->onComplete();
+    }
+    mUpstream = nullptr;
+}
+
+inline void RefCountObserver::dispose()
+{
+    mDisposed.store(true, std::memory_order_release);
+    if (const auto d = mUpstream) {
+        d->dispose();
+    }
+    if (!mDone.exchange(true, std::memory_order_acq_rel)) {
+        mParent->cancel(mConnection);
+    }
+    mUpstream = nullptr;
+    mDownstream = nullptr;
+}
+} // rx
+
+#endif //RX_OBSERVABLE_REF_COUNT_H
@@ -0,0 +1,202 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_REPLAY_H
+#define RX_OBSERVABLE_REPLAY_H
+
+#include "../connectable_observable.h"
+#include "../disposables/disposable_helper.h"
+#include "../subjects/replay_subject.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+
+
+namespace rx
+{
+class ObservableReplay;
+
+// One upstream subscription recorded into a ReplaySubject. Observers walk the subject's segment buffer
+// with their own cursor, so replaying shares the stored values instead of copying them per observer.
+class ReplayConnection : public Observer, public Disposable, public std::enable_shared_from_this<ReplayConnection>
+{
+public:
+    ReplayConnection(const std::weak_ptr<ObservableReplay> &parent, std::shared_ptr<ReplaySubject> subject)
+        : mParent(parent), mSubject(std::move(subject))
+    {
+        LeakObserver::make<ReplayConnection>();
+    }
+
+    ~ReplayConnection() override
+    {
+        LeakObserver::release<ReplayConnection>();
+    }
+
+public:
+    const std::shared_ptr<ReplaySubject> &subject() const
+    {
+        return mSubject;
+    }
+
+    bool tryConnect()
+    {
+        return !mConnected.exchange(true, std::memory_order_acq_rel);
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        DisposableHelper::setOnce(mUpstream, d, mLock);
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (!isDisposed()) {
+            mSubject->onNext(value);
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (terminate()) {
+            mSubject->onError(e);
+        }
+    }
+
+    void onComplete() override
+    {
+        if (terminate()) {
+            mSubject->onComplete();
+        }
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    // The terminated connection stays current, so later observers replay the recorded values and the terminal event
+    bool terminate()
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        GLockerGuard lock(mLock);
+        mUpstream = DisposableHelper::disposed();
+        return true;
+    }
+
+private:
+    std::weak_ptr<ObservableReplay> mParent;
+    std::shared_ptr<ReplaySubject> mSubject;
+    DisposablePtr mUpstream;
+    GMutex mLock;
+    std::atomic<bool> mConnected = false;
+    std::atomic<bool> mDisposed = false;
+};
+
+class ObservableReplay : public ConnectableObservable
+{
+public:
+    using SubjectFactory = std::function<std::shared_ptr<ReplaySubject>()>;
+
+    ObservableReplay(ObservableSourcePtr source, SubjectFactory subjectFactory)
+        : mSource(std::move(source)), mSubjectFactory(std::move(subjectFactory))
+    {
+        LeakObserver::make<ObservableReplay>();
+    }
+
+    ~ObservableReplay() override
+    {
+        LeakObserver::release<ObservableReplay>();
+    }
+
+public:
+    using ConnectableObservable::connect;
+
+    void connect(const ConnectionCallback &onConnect) override
+    {
+        std::shared_ptr<ReplayConnection> connection;
+        while (true) {
+            connection = mCurrent.load(std::memory_order_acquire);
+            if (!connection || connection->isDisposed()) {
+                auto fresh = std::make_shared<ReplayConnection>(self(), mSubjectFactory());
+                if (!mCurrent.compare_exchange_strong(connection, fresh, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                connection = std::move(fresh);
+            }
+            break;
+        }
+
+        const bool doConnect = connection->tryConnect();
+        if (onConnect) {
+            onConnect(connection);
+        }
+        if (doConnect) {
+            mSource->subscribe(connection);
+        }
+    }
+
+    void reset() override
+    {
+        auto connection = mCurrent.load(std::memory_order_acquire);
+        if (connection && connection->isDisposed()) {
+            mCurrent.compare_exchange_strong(connection, nullptr, std::memory_order_acq_rel);
+        }
+    }
+
+    // Called by a disposed connection so the next connect() or subscriber starts with an empty buffer
+    void clearCurrent(const std::shared_ptr<ReplayConnection> &connection)
+    {
+        auto expected = connection;
+        mCurrent.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        std::shared_ptr<ReplayConnection> connection;
+        while (true) {
+            connection = mCurrent.load(std::memory_order_acquire);
+            if (!connection) {
+                auto fresh = std::make_shared<ReplayConnection>(self(), mSubjectFactory());
+                if (!mCurrent.compare_exchange_strong(connection, fresh, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                connection = std::move(fresh);
+            }
+            break;
+        }
+        connection->subject()->subscribe(observer);
+    }
+
+private:
+    std::weak_ptr<ObservableReplay> self()
+    {
+        return std::static_pointer_cast<ObservableReplay>(shared_from_this());
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    SubjectFactory mSubjectFactory;
+    std::atomic<std::shared_ptr<ReplayConnection> > mCurrent;
+};
+
+inline void ReplayConnection::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (const auto parent = mParent.lock()) {
+        parent->clearCurrent(shared_from_this());
+    }
+    DisposableHelper::dispose(mUpstream, mLock);
+}
+} // rx
+
+#endif //RX_OBSERVABLE_REPLAY_H
@@ -8,8 +8,9 @@
 #include "../observable.h"
 #include "../disposables/disposable_helper.h"
 #include "../leak_observer.h"
+#include "../ring_buffer.h"
 
-#include <deque>
+#include <cstdint>
 
 
 namespace rx
@@ -18,7 +19,7 @@ class SkipLastObserver : public Observer, public Disposable, public std::enable_
 {
 public:
     explicit SkipLastObserver(const ObserverPtr &observer, uint64_t skip)
-        : mDownstream(observer), mSkip(skip)
+        : mDownstream(observer), mSkip(skip), mBuffer(skip)
     {
         LeakObserver::make<SkipLastObserver>();
     }
@@ -41,9 +42,8 @@ public:
 
     void onNext(const GAny &value) override
     {
-        if (mSkip == mBuffer.size()) {
-            mDownstream->onNext(mBuffer.front());
-            mBuffer.pop_front();
+        if (mBuffer.full()) {
+            mDownstream->onNext(mBuffer.pop_front());
         }
         mBuffer.push_back(value);
     }
@@ -88,7 +88,7 @@ private:
     ObserverPtr mDownstream;
     DisposablePtr mUpstream;
     uint64_t mSkip;
-    std::deque<GAny> mBuffer;
+    RingBuffer<GAny> mBuffer;
 };
 
 class ObservableSkipLast : public Observable
@@ -115,6 +115,130 @@ private:
     ObservableSourcePtr mSource;
     uint64_t mSkip;
 };
+
+// Holds values back until they are at least time milliseconds old, values still younger at completion are dropped
+class SkipLastTimedObserver : public Observer, public Disposable, public std::enable_shared_from_this<SkipLastTimedObserver>
+{
+public:
+    SkipLastTimedObserver(const ObserverPtr &observer, uint64_t time, WorkerPtr worker)
+        : mDownstream(observer), mTime(time * 1000000), mWorker(std::move(worker)), mBuffer(SIZE_MAX)
+    {
+        LeakObserver::make<SkipLastTimedObserver>();
+    }
+
+    ~SkipLastTimedObserver() override
+    {
+        LeakObserver::release<SkipLastTimedObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(this->shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        const uint64_t now = mWorker->now();
+        mBuffer.push_back({now, value});
+        emitOlderThanWindow(now);
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        mBuffer.clear();
+        mWorker->dispose();
+        mDownstream->onError(e);
+
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    void onComplete() override
+    {
+        // Values that aged past the window since the last onNext are still due
+        if (!emitOlderThanWindow(mWorker->now())) {
+            return;
+        }
+        mBuffer.clear();
+        mWorker->dispose();
+        mDownstream->onComplete();
+
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    void dispose() override
+    {
+        if (const auto d = mUpstream) {
+            d->dispose();
+            mUpstream = nullptr;
+        }
+        mWorker->dispose();
+        mBuffer.clear();
+        mDownstream = nullptr;
+    }
+
+    bool isDisposed() const override
+    {
+        if (const auto d = mUpstream) {
+            return d->isDisposed();
+        }
+        return true;
+    }
+
+private:
+    // Emits the buffered values that are at least time old at now, false once the downstream went away
+    bool emitOlderThanWindow(uint64_t now)
+    {
+        while (!mBuffer.empty() && now - mBuffer.front().first >= mTime) {
+            if (const auto d = mDownstream) {
+                d->onNext(mBuffer.pop_front().second);
+            } else {
+                return false;
+            }
+        }
+        return mDownstream != nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    uint64_t mTime;
+    WorkerPtr mWorker;
+    RingBuffer<std::pair<uint64_t, GAny> > mBuffer;
+};
+
+class ObservableSkipLastTimed : public Observable
+{
+public:
+    ObservableSkipLastTimed(ObservableSourcePtr source, uint64_t time, SchedulerPtr scheduler)
+        : mSource(std::move(source)), mTime(time), mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableSkipLastTimed>();
+    }
+
+    ~ObservableSkipLastTimed() override
+    {
+        LeakObserver::release<ObservableSkipLastTimed>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<SkipLastTimedObserver>(observer, mTime, mScheduler->createWorker()));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    uint64_t mTime;
+    SchedulerPtr mScheduler;
+};
 } // rx
 
 #endif //RX_OBSERVABLE_SKIP_LAST_H
@@ -0,0 +1,340 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_SORTED_H
+#define RX_OBSERVABLE_SORTED_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../parallel_merge_sort.h"
+#include "../exception_helper.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+
+namespace rx
+{
+// Collects the upstream and sorts it once it completes, stable in both modes. With a scheduler, inputs large
+// enough to split go through a ParallelMergeSort and the result is emitted from the worker that finished it.
+// Key mode calls the key selector once per value and, when all keys are integers, all are floating point or all
+// are strings, sorts plain int64 / double / std::string keys instead of going through GAny comparisons. Mixed
+// keys fall back to GAny comparisons.
+class SortedObserver : public Observer, public Disposable, public std::enable_shared_from_this<SortedObserver>
+{
+public:
+    SortedObserver(const ObserverPtr &downstream, const ComparatorFunction &comparator, const MapFunction &keySelector,
+                   const SchedulerPtr &scheduler, bool list)
+        : mDownstream(downstream),
+          mComparator(comparator),
+          mKeySelector(keySelector),
+          mScheduler(scheduler),
+          mList(list)
+    {
+        LeakObserver::make<SortedObserver>();
+    }
+
+    ~SortedObserver() override
+    {
+        LeakObserver::release<SortedObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (mKeySelector) {
+            try {
+                mKeys.push_back(mKeySelector(value));
+            } catch (...) {
+                if (const auto up = mUpstream) {
+                    up->dispose();
+                }
+                onError(ExceptionHelper::fromCurrentException("Sorted: Key selector failed"));
+                return;
+            }
+        }
+        mValues.push_back(value);
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        mValues.clear();
+        mKeys.clear();
+        mUpstream = nullptr;
+        fail(e);
+    }
+
+    void onComplete() override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        mUpstream = nullptr;
+        if (mKeySelector) {
+            sortByKeys();
+        } else {
+            const auto self = shared_from_this();
+            sortWith<GAny>(std::move(mValues), [comparator = mComparator](const GAny &a, const GAny &b) {
+                return comparator ? comparator(a, b) : a < b;
+            }, [self](std::vector<GAny> &sorted, const GAnyException *error) {
+                if (error) {
+                    self->fail(*error);
+                } else {
+                    self->emit(std::move(sorted));
+                }
+            });
+        }
+    }
+
+    void dispose() override
+    {
+        mCancelled.store(true, std::memory_order_release);
+        if (mTerminated.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (!mDone.exchange(true, std::memory_order_acq_rel)) {
+            if (const auto up = mUpstream) {
+                up->dispose();
+            }
+            mUpstream = nullptr;
+        }
+        DisposableHelper::dispose(mSorter, mLock);
+        mDownstream = nullptr;
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    struct IntegerKey
+    {
+        int64_t key;
+        size_t index;
+    };
+
+    struct NumberKey
+    {
+        double key;
+        size_t index;
+    };
+
+    struct StringKey
+    {
+        std::string key;
+        size_t index;
+    };
+
+    struct AnyKey
+    {
+        size_t index;
+    };
+
+    static bool isFloatingPoint(const GAny &key)
+    {
+        return key.is<double>() || key.is<float>();
+    }
+
+    void sortByKeys()
+    {
+        // Integers keep their own path, int64 keys beyond 2^53 would tie or misorder as doubles
+        const bool integers = std::all_of(mKeys.begin(), mKeys.end(), [](const GAny &k) {
+            return k.isNumber() && !isFloatingPoint(k);
+        });
+        const bool floats = !integers && std::all_of(mKeys.begin(), mKeys.end(), isFloatingPoint);
+        const bool strings = !integers && !floats && std::all_of(mKeys.begin(), mKeys.end(), [](const GAny &k) {
+            return k.isString();
+        });
+        if (integers) {
+            std::vector<IntegerKey> entries;
+            entries.reserve(mKeys.size());
+            for (size_t i = 0; i < mKeys.size(); ++i) {
+                entries.push_back({mKeys[i].toInt64(), i});
+            }
+            mKeys.clear();
+            sortEntries(std::move(entries), [](const IntegerKey &a, const IntegerKey &b) {
+                return a.key < b.key;
+            });
+        } else if (floats) {
+            std::vector<NumberKey> entries;
+            entries.reserve(mKeys.size());
+            for (size_t i = 0; i < mKeys.size(); ++i) {
+                entries.push_back({mKeys[i].toDouble(), i});
+            }
+            mKeys.clear();
+            sortEntries(std::move(entries), [](const NumberKey &a, const NumberKey &b) {
+                return a.key < b.key;
+            });
+        } else if (strings) {
+            std::vector<StringKey> entries;
+            entries.reserve(mKeys.size());
+            for (size_t i = 0; i < mKeys.size(); ++i) {
+                entries.push_back({mKeys[i].toString(), i});
+            }
+            mKeys.clear();
+            sortEntries(std::move(entries), [](const StringKey &a, const StringKey &b) {
+                return a.key < b.key;
+            });
+        } else {
+            std::vector<AnyKey> entries;
+            entries.reserve(mKeys.size());
+            for (size_t i = 0; i < mKeys.size(); ++i) {
+                entries.push_back({i});
+            }
+            const auto keys = std::make_shared<std::vector<GAny> >(std::move(mKeys));
+            sortEntries(std::move(entries), [keys](const AnyKey &a, const AnyKey &b) {
+                return (*keys)[a.index] < (*keys)[b.index];
+            });
+        }
+    }
+
+    // Sorts index entries, then gathers the values in entry order
+    template<typename Entry, typename Less>
+    void sortEntries(std::vector<Entry> entries, Less less)
+    {
+        const auto self = shared_from_this();
+        const auto values = std::make_shared<std::vector<GAny> >(std::move(mValues));
+        sortWith<Entry>(std::move(entries), std::move(less),
+                        [self, values](std::vector<Entry> &sorted, const GAnyException *error) {
+                            if (error) {
+                                self->fail(*error);
+                                return;
+                            }
+                            std::vector<GAny> result;
+                            result.reserve(sorted.size());
+                            for (const auto &entry: sorted) {
+                                result.push_back(std::move((*values)[entry.index]));
+                            }
+                            self->emit(std::move(result));
+                        });
+    }
+
+    template<typename T, typename Less>
+    void sortWith(std::vector<T> data, Less less, typename ParallelMergeSort<T, Less>::Callback done)
+    {
+        const uint32_t runs = mScheduler ? ParallelMergeSort<T, Less>::runsFor(data.size()) : 0;
+        if (runs < 2) {
+            try {
+                std::stable_sort(data.begin(), data.end(), less);
+            } catch (...) {
+                const auto e = ExceptionHelper::fromCurrentException("Sorted: Comparator failed");
+                done(data, &e);
+                return;
+            }
+            done(data, nullptr);
+            return;
+        }
+        const auto sorter = std::make_shared<ParallelMergeSort<T, Less> >(
+            std::move(data), std::move(less), mScheduler, runs, std::move(done), "Sorted: Comparator failed");
+        if (DisposableHelper::setOnce(mSorter, sorter, mLock)) {
+            sorter->start();
+        }
+    }
+
+    void emit(std::vector<GAny> sorted)
+    {
+        if (mTerminated.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const auto downstream = std::move(mDownstream);
+        if (mList) {
+            downstream->onNext(std::move(sorted));
+        } else {
+            for (const auto &value: sorted) {
+                if (isDisposed()) {
+                    return;
+                }
+                downstream->onNext(value);
+            }
+        }
+        if (!isDisposed()) {
+            downstream->onComplete();
+        }
+    }
+
+    void fail(const GAnyException &e)
+    {
+        if (mTerminated.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const auto downstream = std::move(mDownstream);
+        downstream->onError(e);
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    ComparatorFunction mComparator;
+    MapFunction mKeySelector;
+    SchedulerPtr mScheduler;
+    bool mList;
+
+    // Upstream thread only
+    std::vector<GAny> mValues;
+    std::vector<GAny> mKeys; // Key mode, one per value
+
+    GMutex mLock;
+    DisposablePtr mSorter;
+
+    std::atomic<bool> mDone = false;       // Upstream terminated or disposed
+    std::atomic<bool> mTerminated = false; // Downstream handed its terminal event or disposed
+    std::atomic<bool> mCancelled = false;
+};
+
+class ObservableSorted : public Observable
+{
+public:
+    ObservableSorted(ObservableSourcePtr source, ComparatorFunction comparator, MapFunction keySelector,
+                     SchedulerPtr scheduler, bool list)
+        : mSource(std::move(source)),
+          mComparator(std::move(comparator)),
+          mKeySelector(std::move(keySelector)),
+          mScheduler(std::move(scheduler)),
+          mList(list)
+    {
+        LeakObserver::make<ObservableSorted>();
+    }
+
+    ~ObservableSorted() override
+    {
+        LeakObserver::release<ObservableSorted>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<SortedObserver>(observer, mComparator, mKeySelector, mScheduler, mList));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    ComparatorFunction mComparator;
+    MapFunction mKeySelector;
+    SchedulerPtr mScheduler;
+    bool mList;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_SORTED_H
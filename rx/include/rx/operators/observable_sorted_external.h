@@ -0,0 +1,551 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_SORTED_EXTERNAL_H
+#define RX_OBSERVABLE_SORTED_EXTERNAL_H
+
+#include "../observable.h"
+#include "../spill_codec.h"
+#include "../exception_helper.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace rx
+{
+// Appends length-prefixed records to a run file through a write buffer
+class SpillRunWriter
+{
+public:
+    explicit SpillRunWriter(const std::filesystem::path &path)
+        : mPath(path), mFile(std::fopen(path.string().c_str(), "wb"))
+    {
+        if (!mFile) {
+            throw GAnyException("SortedExternal: Cannot create " + mPath.string());
+        }
+    }
+
+    ~SpillRunWriter()
+    {
+        if (mFile) {
+            std::fclose(mFile);
+        }
+    }
+
+    SpillRunWriter(const SpillRunWriter &) = delete;
+    SpillRunWriter &operator=(const SpillRunWriter &) = delete;
+
+public:
+    void write(const GAny &value, const SpillCodec &codec)
+    {
+        mRecord.clear();
+        codec.encode(value, mRecord);
+        BinarySpillCodec::writeVarint(mRecord.size(), mBuffer);
+        mBuffer.append(mRecord);
+        if (mBuffer.size() >= BufferSize) {
+            flush();
+        }
+    }
+
+    void close()
+    {
+        flush();
+        const int result = std::fclose(mFile);
+        mFile = nullptr;
+        if (result != 0) {
+            throw GAnyException("SortedExternal: Cannot write " + mPath.string());
+        }
+    }
+
+private:
+    static constexpr size_t BufferSize = 64 * 1024;
+
+    void flush()
+    {
+        if (!mBuffer.empty() && std::fwrite(mBuffer.data(), 1, mBuffer.size(), mFile) != mBuffer.size()) {
+            throw GAnyException("SortedExternal: Cannot write " + mPath.string());
+        }
+        mBuffer.clear();
+    }
+
+private:
+    std::filesystem::path mPath;
+    std::FILE *mFile;
+    std::string mBuffer;
+    std::string mRecord;
+};
+
+// Reads back the records of a run file through a read buffer of bufferSize bytes
+class SpillRunReader
+{
+public:
+    explicit SpillRunReader(const std::filesystem::path &path, size_t bufferSize)
+        : mPath(path), mFile(std::fopen(path.string().c_str(), "rb")), mBuffer(std::max<size_t>(bufferSize, 1))
+    {
+        if (!mFile) {
+            throw GAnyException("SortedExternal: Cannot open " + mPath.string());
+        }
+    }
+
+    ~SpillRunReader()
+    {
+        std::fclose(mFile);
+    }
+
+    SpillRunReader(const SpillRunReader &) = delete;
+    SpillRunReader &operator=(const SpillRunReader &) = delete;
+
+public:
+    // False once the run is exhausted
+    bool next(GAny &value, const SpillCodec &codec)
+    {
+        char byte;
+        if (!readByte(byte)) {
+            return false;
+        }
+        uint64_t size = 0;
+        for (int shift = 0; ; shift += 7) {
+            size |= static_cast<uint64_t>(static_cast<uint8_t>(byte) & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+            if (shift >= 63 || !readByte(byte)) {
+                throw GAnyException("SortedExternal: Corrupt run " + mPath.string());
+            }
+        }
+        mRecord.resize(size);
+        for (size_t done = 0; done < size;) {
+            if (mPosition == mEnd && !refill()) {
+                throw GAnyException("SortedExternal: Corrupt run " + mPath.string());
+            }
+            const size_t n = std::min<size_t>(size - done, mEnd - mPosition);
+            std::copy_n(mBuffer.data() + mPosition, n, mRecord.data() + done);
+            mPosition += n;
+            done += n;
+        }
+        value = codec.decode(mRecord);
+        return true;
+    }
+
+private:
+    bool refill()
+    {
+        mPosition = 0;
+        mEnd = std::fread(mBuffer.data(), 1, mBuffer.size(), mFile);
+        if (mEnd == 0 && std::ferror(mFile)) {
+            throw GAnyException("SortedExternal: Cannot read " + mPath.string());
+        }
+        return mEnd > 0;
+    }
+
+    bool readByte(char &byte)
+    {
+        if (mPosition == mEnd && !refill()) {
+            return false;
+        }
+        byte = mBuffer[mPosition++];
+        return true;
+    }
+
+private:
+    std::filesystem::path mPath;
+    std::FILE *mFile;
+    std::vector<char> mBuffer;
+    size_t mPosition = 0;
+    size_t mEnd = 0;
+    std::string mRecord;
+};
+
+// Buffers values until their estimated footprint reaches the memory budget, then sorts the buffer and spills it
+// to a run file. On completion the runs, plus whatever is still buffered, are merged through a min-heap and
+// emitted on the upstream thread. Equal values keep their upstream order.
+// At most MaxMergeWidth files are open at once: while there are more runs, consecutive groups of them are first
+// merged into longer runs, and the read buffers share the memory budget.
+// The upstream thread holds mWip while it touches the buffer or the run files; dispose() takes it too, so
+// whichever side gets there last removes the files.
+class SortedExternalObserver : public Observer, public Disposable,
+                               public std::enable_shared_from_this<SortedExternalObserver>
+{
+public:
+    SortedExternalObserver(const ObserverPtr &downstream, const ComparatorFunction &comparator, uint64_t memoryBudget,
+                           const std::string &tmpDir, const SpillCodecPtr &codec)
+        : mDownstream(downstream),
+          mComparator(comparator),
+          mMemoryBudget(memoryBudget),
+          mTmpDir(tmpDir),
+          mCodec(codec)
+    {
+        LeakObserver::make<SortedExternalObserver>();
+    }
+
+    ~SortedExternalObserver() override
+    {
+        LeakObserver::release<SortedExternalObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mDone || !enter()) {
+            return;
+        }
+        mBytes += approximateBytes(value);
+        mValues.push_back(value);
+        if (mBytes >= mMemoryBudget) {
+            try {
+                spill();
+            } catch (...) {
+                fail(ExceptionHelper::fromCurrentException("SortedExternal: Spill failed"));
+            }
+        }
+        leave();
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone || !enter()) {
+            return;
+        }
+        mDone = true;
+        removeRuns();
+        if (const auto ds = std::move(mDownstream)) {
+            ds->onError(e);
+        }
+        leave();
+    }
+
+    void onComplete() override
+    {
+        if (mDone || !enter()) {
+            return;
+        }
+        mDone = true;
+        try {
+            merge();
+        } catch (...) {
+            fail(ExceptionHelper::fromCurrentException("SortedExternal: Merge failed"));
+        }
+        leave();
+    }
+
+    void dispose() override
+    {
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto up = mUpstream) {
+            up->dispose();
+        }
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Head
+    {
+        GAny value;
+        size_t run;
+    };
+
+    static constexpr size_t MaxMergeWidth = 16;
+    static constexpr size_t MinReadBufferSize = 4 * 1024;
+    static constexpr size_t MaxReadBufferSize = 64 * 1024;
+
+    // Fails once dispose() has taken over, the count then never drops back to zero
+    bool enter()
+    {
+        return mWip.fetch_add(1, std::memory_order_acq_rel) == 0;
+    }
+
+    // A dispose() that arrived in between left the cleanup to this thread
+    void leave()
+    {
+        if (mWip.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            clear();
+        }
+    }
+
+    // Rough heap footprint of a value: the GAny and its holder, plus string bytes or array items
+    static uint64_t approximateBytes(const GAny &value)
+    {
+        constexpr uint64_t holderBytes = sizeof(GAny) + 64;
+        if (value.isString() || value.isArray()) {
+            return holderBytes + value.size() * (value.isArray() ? holderBytes : 1);
+        }
+        return holderBytes;
+    }
+
+    bool less(const GAny &a, const GAny &b) const
+    {
+        if (mComparator) {
+            return mComparator(a, b);
+        }
+        return a < b;
+    }
+
+    void sortBuffer()
+    {
+        std::stable_sort(mValues.begin(), mValues.end(), [this](const GAny &a, const GAny &b) {
+            return less(a, b);
+        });
+    }
+
+    void spill()
+    {
+        if (mRuns.empty()) {
+            if (mTmpDir.empty()) {
+                mTmpDir = std::filesystem::temp_directory_path();
+            }
+            mRunPrefix = "rx-sort-" + std::to_string(std::random_device()()) + "-";
+        }
+        sortBuffer();
+        SpillRunWriter writer(newRun());
+        for (const auto &value: mValues) {
+            writer.write(value, *mCodec);
+        }
+        writer.close();
+        mValues.clear();
+        mBytes = 0;
+    }
+
+    // The still buffered values act as the last run, they arrived after every spilled one
+    bool advance(size_t run, GAny &value)
+    {
+        if (run == mReaders.size()) {
+            if (mBufferPosition == mValues.size()) {
+                return false;
+            }
+            value = std::move(mValues[mBufferPosition++]);
+            return true;
+        }
+        return mReaders[run]->next(value, *mCodec);
+    }
+
+    // Appends a fresh path to mRuns, so the file is removed with the others whatever happens next
+    const std::filesystem::path &newRun()
+    {
+        mRuns.push_back(mTmpDir / (mRunPrefix + std::to_string(mRunCount++) + ".run"));
+        return mRuns.back();
+    }
+
+    size_t readBufferSize() const
+    {
+        return static_cast<size_t>(std::clamp<uint64_t>(mMemoryBudget / MaxMergeWidth, MinReadBufferSize,
+                                                        MaxReadBufferSize));
+    }
+
+    // Merges the open readers, then the buffer when withBuffer is set, handing each value to sink in order.
+    // False when disposed midway
+    template<typename Sink>
+    bool mergeReaders(bool withBuffer, const Sink &sink)
+    {
+        // Min-heap on top of std's max-heap, ties go to the earlier run
+        const auto after = [this](const Head &a, const Head &b) {
+            if (less(b.value, a.value)) {
+                return true;
+            }
+            return !less(a.value, b.value) && a.run > b.run;
+        };
+        const size_t runCount = mReaders.size() + (withBuffer ? 1 : 0);
+        std::vector<Head> heap;
+        heap.reserve(runCount);
+        for (size_t run = 0; run < runCount; ++run) {
+            Head head{GAny(), run};
+            if (advance(run, head.value)) {
+                heap.push_back(std::move(head));
+                std::push_heap(heap.begin(), heap.end(), after);
+            }
+        }
+
+        while (!heap.empty()) {
+            if (isDisposed()) {
+                return false;
+            }
+            std::pop_heap(heap.begin(), heap.end(), after);
+            Head head = std::move(heap.back());
+            heap.pop_back();
+            sink(head.value);
+            if (advance(head.run, head.value)) {
+                heap.push_back(std::move(head));
+                std::push_heap(heap.begin(), heap.end(), after);
+            }
+        }
+        return true;
+    }
+
+    // Merges consecutive groups of MaxMergeWidth runs into one longer run each, so the earlier runs stay first
+    // and the merge stays stable. Repeats until at most MaxMergeWidth runs are left, the final merge opens those
+    // and takes the buffer straight from memory
+    bool mergePasses()
+    {
+        while (mRuns.size() > MaxMergeWidth) {
+            const size_t passRuns = mRuns.size();
+            for (size_t merged = 0; merged < passRuns;) {
+                const size_t width = std::min(MaxMergeWidth, passRuns - merged);
+                merged += width;
+                if (width == 1) {
+                    std::rotate(mRuns.begin(), mRuns.begin() + 1, mRuns.end());
+                    continue;
+                }
+                for (size_t run = 0; run < width; ++run) {
+                    mReaders.push_back(std::make_unique<SpillRunReader>(mRuns[run], readBufferSize()));
+                }
+                SpillRunWriter writer(newRun());
+                const bool finished = mergeReaders(false, [this, &writer](const GAny &value) {
+                    writer.write(value, *mCodec);
+                });
+                if (!finished) {
+                    return false;
+                }
+                writer.close();
+                mReaders.clear();
+                for (size_t run = 0; run < width; ++run) {
+                    std::error_code ec;
+                    std::filesystem::remove(mRuns[run], ec);
+                }
+                mRuns.erase(mRuns.begin(), mRuns.begin() + static_cast<std::ptrdiff_t>(width));
+            }
+        }
+        return true;
+    }
+
+    void merge()
+    {
+        sortBuffer();
+        if (!mergePasses()) {
+            return;
+        }
+        mReaders.reserve(mRuns.size());
+        for (const auto &path: mRuns) {
+            mReaders.push_back(std::make_unique<SpillRunReader>(path, readBufferSize()));
+        }
+        if (!mergeReaders(true, [this](const GAny &value) { mDownstream->onNext(value); })) {
+            return;
+        }
+
+        removeRuns();
+        mValues.clear();
+        if (const auto ds = std::move(mDownstream)) {
+            if (!isDisposed()) {
+                ds->onComplete();
+            }
+        }
+    }
+
+    void fail(const GAnyException &e)
+    {
+        mDone = true;
+        if (const auto up = mUpstream) {
+            up->dispose();
+        }
+        removeRuns();
+        mValues.clear();
+        if (const auto ds = std::move(mDownstream)) {
+            if (!isDisposed()) {
+                ds->onError(e);
+            }
+        }
+    }
+
+    // Readers are closed before their files go away
+    void removeRuns()
+    {
+        mReaders.clear();
+        for (const auto &path: mRuns) {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+        mRuns.clear();
+    }
+
+    void clear()
+    {
+        removeRuns();
+        mValues.clear();
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    ComparatorFunction mComparator;
+    uint64_t mMemoryBudget;
+    std::filesystem::path mTmpDir;
+    SpillCodecPtr mCodec;
+
+    // Owned by whoever holds mWip
+    bool mDone = false;
+    std::vector<GAny> mValues;
+    uint64_t mBytes = 0;
+    size_t mBufferPosition = 0;
+    std::string mRunPrefix;
+    uint64_t mRunCount = 0;
+    std::vector<std::filesystem::path> mRuns;
+    std::vector<std::unique_ptr<SpillRunReader> > mReaders;
+
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mCancelled = false;
+};
+
+class ObservableSortedExternal : public Observable
+{
+public:
+    ObservableSortedExternal(ObservableSourcePtr source, ComparatorFunction comparator, uint64_t memoryBudget,
+                             std::string tmpDir, SpillCodecPtr codec)
+        : mSource(std::move(source)),
+          mComparator(std::move(comparator)),
+          mMemoryBudget(memoryBudget),
+          mTmpDir(std::move(tmpDir)),
+          mCodec(std::move(codec))
+    {
+        LeakObserver::make<ObservableSortedExternal>();
+    }
+
+    ~ObservableSortedExternal() override
+    {
+        LeakObserver::release<ObservableSortedExternal>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<SortedExternalObserver>(observer, mComparator, mMemoryBudget, mTmpDir,
+                                                                    mCodec));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    ComparatorFunction mComparator;
+    uint64_t mMemoryBudget;
+    std::string mTmpDir;
+    SpillCodecPtr mCodec;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_SORTED_EXTERNAL_H
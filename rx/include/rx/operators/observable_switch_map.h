@@ -8,11 +8,11 @@
 #include "../observable.h"
 #include "../exception_helper.h"
 #include "../observer.h"
-#include "../disposables/atomic_disposable.h"
-#include "../disposables/sequential_disposable.h"
 #include "../disposables/disposable_helper.h"
 #include "../leak_observer.h"
+#include "../spsc_queue.h"
 #include <atomic>
+#include <memory>
 #include <gx/gmutex.h>
 
 
@@ -20,7 +20,8 @@ namespace rx
 {
 class SwitchMapObserver;
 
-class SwitchMapInnerObserver : public Observer
+// Buffers what its source emits in an SPSC queue, only the draining thread of the parent reads it
+class SwitchMapInnerObserver : public Observer, public Disposable
 {
 public:
     SwitchMapInnerObserver(const std::shared_ptr<SwitchMapObserver> &parent, uint64_t id);
@@ -36,11 +37,44 @@ public:
 
     void onComplete() override;
 
+    void dispose() override;
+
+    bool isDisposed() const override;
+
+    uint64_t id() const
+    {
+        return mId;
+    }
+
+    SpscQueue &queue()
+    {
+        return mQueue;
+    }
+
+    // Set after the last offer, so a drain that sees it also sees every queued value
+    void setDone()
+    {
+        mDone.store(true, std::memory_order_release);
+    }
+
+    bool isDone() const
+    {
+        return mDone.load(std::memory_order_acquire);
+    }
+
 private:
     std::weak_ptr<SwitchMapObserver> mParent;
     uint64_t mId;
+    DisposablePtr mUpstream;
+    GMutex mLock;
+    SpscQueue mQueue{0, 16};
+    std::atomic<bool> mDone = false;
 };
 
+// Every downstream signal goes through drain(), whichever thread wins the WIP counter emits,
+// so inners on different threads never overlap each other or the terminal.
+// Inner signals are matched against the generation in mIndex without locking, a stale inner is dropped.
+// A switched-away inner is parked on a retired list and cancelled by the drain, not on the upstream thread.
 class SwitchMapObserver : public Observer, public Disposable, public std::enable_shared_from_this<SwitchMapObserver>
 {
 public:
@@ -62,28 +96,55 @@ public:
     bool isDisposed() const override;
 
     // Inner callbacks
-    void innerSubscribe(uint64_t id, const DisposablePtr &d);
+    void innerSubscribe(SwitchMapInnerObserver &inner, const DisposablePtr &d);
+
+    void innerNext(SwitchMapInnerObserver &inner, const GAny &value);
+
+    void innerError(SwitchMapInnerObserver &inner, const GAnyException &e);
+
+    void innerComplete(SwitchMapInnerObserver &inner);
+
+private:
+    struct Retired
+    {
+        std::shared_ptr<SwitchMapInnerObserver> inner;
+        std::shared_ptr<Retired> next;
+    };
+
+    bool isCurrent(const SwitchMapInnerObserver &inner) const
+    {
+        return mIndex.load(std::memory_order_acquire) == inner.id();
+    }
+
+    void setError(const GAnyException &e);
+
+    void retire(std::shared_ptr<SwitchMapInnerObserver> inner);
+
+    void cancelInners();
 
-    void innerNext(uint64_t id, const GAny &value);
+    void drain();
 
-    void innerError(uint64_t id, const GAnyException &e);
+    bool drainActive(std::shared_ptr<SwitchMapInnerObserver> active);
 
-    void innerComplete(uint64_t id);
+    template<typename Signal>
+    void terminate(const Signal &signal);
 
 private:
     ObserverPtr mDownstream;
     FlatMapFunction mMapper;
     DisposablePtr mUpstream;
-    std::shared_ptr<SequentialDisposable> mInnerDisposable;
 
-    std::atomic<bool> mDone{false};
-    std::atomic<bool> mDisposed{false};
-    std::atomic<uint64_t> mIndex{0};
-
-    // We assume only one active inner observer, but we need to track if it's active for onComplete logic
-    std::atomic<bool> mInnerActive{false};
-
-    GMutex mLock; // Protects against race between main onNext/onComplete and inner events
+    std::atomic<uint64_t> mIndex = 0;
+    std::atomic<std::shared_ptr<SwitchMapInnerObserver> > mActive;
+    std::atomic<std::shared_ptr<Retired> > mRetired;    // Switched-away inners waiting for the drain to cancel them
+    std::unique_ptr<GAnyException> mError;             // Written once under mLock, read after mErrored
+
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mDone = false;
+    std::atomic<bool> mErrored = false;
+    std::atomic<bool> mTerminated = false;
+    std::atomic<bool> mDisposed = false;
+    GMutex mLock;
 };
 
 class ObservableSwitchMap : public Observable
@@ -129,38 +190,52 @@ inline SwitchMapInnerObserver::~SwitchMapInnerObserver()
 
 inline void SwitchMapInnerObserver::onSubscribe(const DisposablePtr &d)
 {
+    if (!DisposableHelper::setOnce(mUpstream, d, mLock)) {
+        return;
+    }
     if (const auto p = mParent.lock()) {
-        p->innerSubscribe(mId, d);
+        p->innerSubscribe(*this, d);
+    } else {
+        dispose();
     }
 }
 
 inline void SwitchMapInnerObserver::onNext(const GAny &value)
 {
     if (const auto p = mParent.lock()) {
-        p->innerNext(mId, value);
+        p->innerNext(*this, value);
     }
 }
 
 inline void SwitchMapInnerObserver::onError(const GAnyException &e)
 {
     if (const auto p = mParent.lock()) {
-        p->innerError(mId, e);
+        p->innerError(*this, e);
     }
 }
 
 inline void SwitchMapInnerObserver::onComplete()
 {
     if (const auto p = mParent.lock()) {
-        p->innerComplete(mId);
+        p->innerComplete(*this);
     }
 }
 
+inline void SwitchMapInnerObserver::dispose()
+{
+    DisposableHelper::dispose(mUpstream, mLock);
+}
+
+inline bool SwitchMapInnerObserver::isDisposed() const
+{
+    return DisposableHelper::isDisposed(mUpstream);
+}
+
 // SwitchMapObserver
 inline SwitchMapObserver::SwitchMapObserver(const ObserverPtr &downstream, const FlatMapFunction &mapper)
     : mDownstream(downstream), mMapper(mapper)
 {
     LeakObserver::make<SwitchMapObserver>();
-    mInnerDisposable = std::make_shared<SequentialDisposable>();
 }
 
 inline SwitchMapObserver::~SwitchMapObserver()
@@ -178,20 +253,18 @@ inline void SwitchMapObserver::onSubscribe(const DisposablePtr &d)
 
 inline void SwitchMapObserver::onNext(const GAny &value)
 {
-    if (mDone || mDisposed)
+    if (mDone || mTerminated || mDisposed)
         return;
 
-    uint64_t id;
-    //
-    {
-        GLockerGuard lock(mLock);
-        id = ++mIndex;
-        mInnerActive = true;
-    }
+    // Bumping the generation first makes the previous inner stale before anything else,
+    // so whatever it still emits is dropped by the id check instead of waiting on a lock.
+    const uint64_t id = mIndex.fetch_add(1, std::memory_order_acq_rel) + 1;
 
     // A new upstream value switches away from the previous inner immediately,
-    // even if the mapper fails or returns a null Observable.
-    mInnerDisposable->update(std::make_shared<AtomicDisposable>());
+    // even if the mapper fails or returns a null Observable. The drain cancels it.
+    if (auto previous = mActive.exchange(nullptr)) {
+        retire(std::move(previous));
+    }
 
     std::shared_ptr<Observable> p;
     try {
@@ -207,7 +280,11 @@ inline void SwitchMapObserver::onNext(const GAny &value)
     }
 
     const auto inner = std::make_shared<SwitchMapInnerObserver>(shared_from_this(), id);
-    p->subscribe(inner);
+    mActive.store(inner);
+    if (!mDisposed) {
+        p->subscribe(inner);
+    }
+    drain();
 }
 
 inline void SwitchMapObserver::onError(const GAnyException &e)
@@ -215,38 +292,27 @@ inline void SwitchMapObserver::onError(const GAnyException &e)
     if (mDone || mDisposed)
         return;
     mDone = true;
-    const auto downstream = mDownstream;
-    dispose();
-    if (downstream) {
-        downstream->onError(e);
-    }
+    setError(e);
 }
 
 inline void SwitchMapObserver::onComplete()
 {
     if (mDone || mDisposed)
         return;
-
-    ObserverPtr downstream;
-    {
-        GLockerGuard lock(mLock);
-        mDone = true;
-        if (!mInnerActive) {
-            downstream = mDownstream;
-        }
-    }
-    if (downstream) {
-        downstream->onComplete();
-    }
+    mDone.store(true, std::memory_order_release);
+    drain();
 }
 
 inline void SwitchMapObserver::dispose()
 {
-    if (!mDisposed.exchange(true)) {
-        if (mUpstream)
-            mUpstream->dispose();
-        if (mInnerDisposable)
-            mInnerDisposable->dispose();
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (mUpstream)
+        mUpstream->dispose();
+    cancelInners();
+    if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        mDownstream = nullptr;
     }
 }
 
@@ -255,60 +321,150 @@ inline bool SwitchMapObserver::isDisposed() const
     return mDisposed;
 }
 
-inline void SwitchMapObserver::innerSubscribe(uint64_t id, const DisposablePtr &d)
+inline void SwitchMapObserver::innerSubscribe(SwitchMapInnerObserver &inner, const DisposablePtr &d)
 {
-    bool current = false;
-    {
-        GLockerGuard lock(mLock);
-        current = !mDisposed && mIndex == id;
-    }
-    if (current) {
-        mInnerDisposable->update(d);
-    } else {
+    // The inner owns d, only an inner that is already stale has to be cancelled here
+    if (mDisposed || mTerminated || !isCurrent(inner)) {
         d->dispose();
     }
 }
 
-inline void SwitchMapObserver::innerNext(uint64_t id, const GAny &value)
+inline void SwitchMapObserver::innerNext(SwitchMapInnerObserver &inner, const GAny &value)
+{
+    if (mDisposed || !isCurrent(inner)) {
+        return;
+    }
+    inner.queue().offer(value);
+    drain();
+}
+
+inline void SwitchMapObserver::innerError(SwitchMapInnerObserver &inner, const GAnyException &e)
+{
+    // The current inner may still fail after the main source completed
+    if (isCurrent(inner)) {
+        setError(e);
+    }
+}
+
+inline void SwitchMapObserver::innerComplete(SwitchMapInnerObserver &inner)
+{
+    if (mDisposed || !isCurrent(inner)) {
+        return;
+    }
+    inner.setDone();
+    drain();
+}
+
+inline void SwitchMapObserver::setError(const GAnyException &e)
 {
-    ObserverPtr downstream;
     {
         GLockerGuard lock(mLock);
-        if (!mDisposed && mIndex == id) {
-            downstream = mDownstream;
+        if (mDisposed || mError) {
+            return;
         }
+        mError = std::make_unique<GAnyException>(e);
+    }
+    mErrored.store(true, std::memory_order_release);
+    drain();
+}
+
+inline void SwitchMapObserver::retire(std::shared_ptr<SwitchMapInnerObserver> inner)
+{
+    auto node = std::make_shared<Retired>(Retired{std::move(inner), mRetired.load()});
+    while (!mRetired.compare_exchange_weak(node->next, node)) {
     }
-    if (downstream) {
-        downstream->onNext(value);
+}
+
+inline void SwitchMapObserver::cancelInners()
+{
+    if (const auto active = mActive.exchange(nullptr)) {
+        active->dispose();
+    }
+    for (auto node = mRetired.exchange(nullptr); node; node = node->next) {
+        node->inner->dispose();
     }
 }
 
-inline void SwitchMapObserver::innerError(uint64_t id, const GAnyException &e)
+inline void SwitchMapObserver::drain()
 {
-    bool current = false;
-    {
-        GLockerGuard lock(mLock);
-        current = !mDisposed && mIndex == id;
+    if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+        return;
     }
-    if (current) {
-        onError(e);
+    uint32_t missed = 1;
+    while (true) {
+        while (true) {
+            for (auto node = mRetired.exchange(nullptr); node; node = node->next) {
+                node->inner->dispose();
+            }
+            if (mDisposed) {
+                cancelInners();
+                mDownstream = nullptr;
+                return;
+            }
+            if (mErrored.load(std::memory_order_acquire)) {
+                const GAnyException error = *mError;
+                terminate([&error](const ObserverPtr &downstream) { downstream->onError(error); });
+                return;
+            }
+
+            // Read done before the active inner, onNext never runs again once the main source is done
+            const bool done = mDone.load(std::memory_order_acquire);
+            const auto active = mActive.load();
+            if (!active) {
+                if (done) {
+                    terminate([](const ObserverPtr &downstream) { downstream->onComplete(); });
+                    return;
+                }
+                break;
+            }
+            if (!drainActive(active)) {
+                break;
+            }
+        }
+
+        missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+        if (missed == 0) {
+            return;
+        }
     }
 }
 
-inline void SwitchMapObserver::innerComplete(uint64_t id)
+// Emits what the active inner has queued, true when the caller has to re-check the terminal state
+inline bool SwitchMapObserver::drainActive(std::shared_ptr<SwitchMapInnerObserver> active)
 {
-    ObserverPtr downstream;
-    {
-        GLockerGuard lock(mLock);
-        if (!mDisposed && mIndex == id) {
-            mInnerActive = false;
-            if (mDone) {
-                downstream = mDownstream;
+    SpscQueue &queue = active->queue();
+    GAny value;
+    while (true) {
+        if (mDisposed || mErrored.load(std::memory_order_acquire)) {
+            return true;
+        }
+        // Switched away, the onNext that did it drains again once the new inner is in place
+        if (!isCurrent(*active)) {
+            return false;
+        }
+        const bool innerDone = active->isDone();
+        if (!queue.poll(value)) {
+            if (innerDone) {
+                mActive.compare_exchange_strong(active, nullptr);
+                return true;
             }
+            return false;
         }
+        mDownstream->onNext(value);
     }
-    if (downstream) {
-        downstream->onComplete();
+}
+
+// Cancels the upstream and the inner sources, the terminal itself is skipped after an explicit dispose()
+template<typename Signal>
+void SwitchMapObserver::terminate(const Signal &signal)
+{
+    mTerminated.store(true, std::memory_order_release);
+    if (mUpstream)
+        mUpstream->dispose();
+    cancelInners();
+    const ObserverPtr downstream = std::move(mDownstream);
+    if (downstream && !mDisposed) {
+        signal(downstream);
     }
 }
 } // rx
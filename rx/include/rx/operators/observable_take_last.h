@@ -8,8 +8,7 @@
 #include "../observable.h"
 #include "../disposables/disposable_helper.h"
 #include "../leak_observer.h"
-
-#include <deque>
+#include "../ring_buffer.h"
 
 
 namespace rx
@@ -18,7 +17,7 @@ class TakeLastObserver : public Observer, public Disposable, public std::enable_
 {
 public:
     explicit TakeLastObserver(const ObserverPtr &observer, uint64_t count)
-        : mDownstream(observer), mCount(count)
+        : mDownstream(observer), mCount(count), mBuffer(count)
     {
         LeakObserver::make<TakeLastObserver>();
     }
@@ -45,7 +44,7 @@ public:
             return;
         }
 
-        if (mCount == mBuffer.size()) {
+        if (mBuffer.full()) {
             mBuffer.pop_front();
         }
         mBuffer.push_back(value);
@@ -62,11 +61,11 @@ public:
 
     void onComplete() override
     {
-        for (const auto &item : mBuffer) {
+        while (!mBuffer.empty()) {
             if (mCancelled.load(std::memory_order_acquire)) {
                 break;
             }
-            mDownstream->onNext(item);
+            mDownstream->onNext(mBuffer.pop_front());
         }
         mBuffer.clear();
 
@@ -98,7 +97,7 @@ private:
     ObserverPtr mDownstream;
     DisposablePtr mUpstream;
     uint64_t mCount;
-    std::deque<GAny> mBuffer;
+    RingBuffer<GAny> mBuffer;
     std::atomic<bool> mCancelled = false;
 };
 
@@ -126,6 +125,137 @@ private:
     ObservableSourcePtr mSource;
     uint64_t mCount;
 };
+
+// Keeps at most count values that are younger than time milliseconds, timestamped by the worker clock
+class TakeLastTimedObserver : public Observer, public Disposable, public std::enable_shared_from_this<TakeLastTimedObserver>
+{
+public:
+    TakeLastTimedObserver(const ObserverPtr &observer, uint64_t count, uint64_t time, WorkerPtr worker)
+        : mDownstream(observer), mTime(time * 1000000), mWorker(std::move(worker)), mBuffer(count)
+    {
+        LeakObserver::make<TakeLastTimedObserver>();
+    }
+
+    ~TakeLastTimedObserver() override
+    {
+        LeakObserver::release<TakeLastTimedObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(this->shared_from_this());
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mBuffer.capacity() == 0) {
+            return;
+        }
+
+        const uint64_t now = mWorker->now();
+        evict(now);
+        if (mBuffer.full()) {
+            mBuffer.pop_front();
+        }
+        mBuffer.push_back({now, value});
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        mBuffer.clear();
+        mWorker->dispose();
+        mDownstream->onError(e);
+
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    void onComplete() override
+    {
+        evict(mWorker->now());
+        mWorker->dispose();
+        while (!mBuffer.empty()) {
+            if (mCancelled.load(std::memory_order_acquire)) {
+                break;
+            }
+            mDownstream->onNext(mBuffer.pop_front().second);
+        }
+        mBuffer.clear();
+
+        if (!mCancelled.load(std::memory_order_acquire)) {
+            mDownstream->onComplete();
+        }
+
+        mDownstream = nullptr;
+        mUpstream = nullptr;
+    }
+
+    void dispose() override
+    {
+        if (!mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            if (const auto d = mUpstream) {
+                d->dispose();
+                mUpstream = nullptr;
+            }
+            mWorker->dispose();
+            mDownstream = nullptr;
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    void evict(uint64_t now)
+    {
+        while (!mBuffer.empty() && now - mBuffer.front().first >= mTime) {
+            mBuffer.pop_front();
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    uint64_t mTime;
+    WorkerPtr mWorker;
+    RingBuffer<std::pair<uint64_t, GAny> > mBuffer;
+    std::atomic<bool> mCancelled = false;
+};
+
+class ObservableTakeLastTimed : public Observable
+{
+public:
+    ObservableTakeLastTimed(ObservableSourcePtr source, uint64_t count, uint64_t time, SchedulerPtr scheduler)
+        : mSource(std::move(source)), mCount(count), mTime(time), mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableTakeLastTimed>();
+    }
+
+    ~ObservableTakeLastTimed() override
+    {
+        LeakObserver::release<ObservableTakeLastTimed>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<TakeLastTimedObserver>(observer, mCount, mTime, mScheduler->createWorker()));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    uint64_t mCount;
+    uint64_t mTime;
+    SchedulerPtr mScheduler;
+};
 } // rx
 
 #endif //RX_OBSERVABLE_TAKE_LAST_H
@@ -8,6 +8,7 @@
 #include "../observable.h"
 #include "../disposables/disposable_helper.h"
 #include "../leak_observer.h"
+#include "../array_view.h"
 
 
 namespace rx
@@ -15,8 +16,8 @@ namespace rx
 class ToArrayObserver : public Observer, public Disposable, public std::enable_shared_from_this<ToArrayObserver>
 {
 public:
-    explicit ToArrayObserver(const ObserverPtr &observer)
-        : mDownstream(observer)
+    explicit ToArrayObserver(const ObserverPtr &observer, bool view = false)
+        : mDownstream(observer), mView(view)
     {
         LeakObserver::make<ToArrayObserver>();
     }
@@ -56,7 +57,12 @@ public:
     void onComplete() override
     {
         if (const auto d = mDownstream) {
-            d->onNext(mList);
+            // The collected list is moved out, not copied, since nothing else reads it afterwards
+            if (mView) {
+                d->onNext(ArrayView::of(std::move(mList)));
+            } else {
+                d->onNext(std::move(mList));
+            }
             mList.clear();
             d->onComplete();
         }
@@ -85,14 +91,15 @@ public:
 private:
     ObserverPtr mDownstream;
     DisposablePtr mUpstream;
+    bool mView;
     std::vector<GAny> mList;
 };
 
 class ObservableToArray : public Observable
 {
 public:
-    explicit ObservableToArray(ObservableSourcePtr source)
-        : mSource(std::move(source))
+    explicit ObservableToArray(ObservableSourcePtr source, bool view = false)
+        : mSource(std::move(source)), mView(view)
     {
         LeakObserver::make<ObservableToArray>();
     }
@@ -105,11 +112,12 @@ public:
 protected:
     void subscribeActual(const ObserverPtr &observer) override
     {
-        mSource->subscribe(std::make_shared<ToArrayObserver>(observer));
+        mSource->subscribe(std::make_shared<ToArrayObserver>(observer, mView));
     }
 
 private:
     ObservableSourcePtr mSource;
+    bool mView;
 };
 } // rx
 
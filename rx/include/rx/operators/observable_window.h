@@ -7,117 +7,14 @@
 
 #include "../observable.h"
 #include "../disposables/disposable_helper.h"
+#include "../subjects/unicast_subject.h"
 #include "../leak_observer.h"
 #include <atomic>
 #include <deque>
-#include <vector>
-#include <optional>
 
 
 namespace rx
 {
-class WindowSubject
-{
-public:
-    WindowSubject()
-        : mState(std::make_shared<State>())
-    {
-        LeakObserver::make<WindowSubject>();
-
-        const auto state = mState;
-        mObservable = Observable::create([state](const ObservableEmitterPtr &emitter) {
-            std::optional<GAnyException> error;
-            bool completed = false;
-            {
-                GLockerGuard lock(state->lock);
-                error = state->error;
-                completed = state->completed;
-                if (!error && !completed) {
-                    state->emitters.push_back(emitter);
-                    return;
-                }
-            }
-            if (error) {
-                emitter->onError(error.value());
-            } else {
-                emitter->onComplete();
-            }
-        });
-    }
-
-    ~WindowSubject()
-    {
-        LeakObserver::release<WindowSubject>();
-    }
-
-public:
-    std::shared_ptr<Observable> getObservable() const { return mObservable; }
-
-    void onNext(const GAny &value)
-    {
-        std::vector<ObservableEmitterPtr> emitters;
-        {
-            GLockerGuard lock(mState->lock);
-            auto it = mState->emitters.begin();
-            while (it != mState->emitters.end()) {
-                if ((*it)->isDisposed()) {
-                    it = mState->emitters.erase(it);
-                } else {
-                    emitters.push_back(*it);
-                    ++it;
-                }
-            }
-        }
-        for (const auto &emitter: emitters) {
-            emitter->onNext(value);
-        }
-    }
-
-    void onError(const GAnyException &e)
-    {
-        std::vector<ObservableEmitterPtr> emitters;
-        {
-            GLockerGuard lock(mState->lock);
-            mState->error = e;
-            emitters = std::move(mState->emitters);
-            mState->emitters.clear();
-        }
-        for (const auto &emitter: emitters) {
-            if (!emitter->isDisposed()) {
-                emitter->onError(e);
-            }
-        }
-    }
-
-    void onComplete()
-    {
-        std::vector<ObservableEmitterPtr> emitters;
-        {
-            GLockerGuard lock(mState->lock);
-            mState->completed = true;
-            emitters = std::move(mState->emitters);
-            mState->emitters.clear();
-        }
-        for (const auto &emitter: emitters) {
-            if (!emitter->isDisposed()) {
-                emitter->onComplete();
-            }
-        }
-    }
-
-private:
-    struct State
-    {
-        std::vector<ObservableEmitterPtr> emitters;
-        std::optional<GAnyException> error;
-        bool completed = false;
-        GMutex lock;
-    };
-
-    std::shared_ptr<Observable> mObservable;
-    std::shared_ptr<State> mState;
-};
-
 class ObservableWindow;
 
 class WindowObserver : public Observer, public Disposable, public std::enable_shared_from_this<WindowObserver>
@@ -153,9 +50,9 @@ public:
 
         // 1. Check if we need to start a new window
         if (mIndex % mSkip == 0) {
-            const auto window = std::make_shared<WindowSubject>();
+            const auto window = std::make_shared<UnicastSubject>();
             mWindows.push_back({window, 0});
-            mDownstream->onNext(window->getObservable());
+            mDownstream->onNext(std::static_pointer_cast<Observable>(window));
             if (mDone.load(std::memory_order_acquire)) {
                 return;
             }
@@ -210,6 +107,7 @@ public:
 
     void dispose() override
     {
+        mDisposed.store(true, std::memory_order_release);
         if (mDone.exchange(true, std::memory_order_acq_rel)) {
             return;
         }
@@ -226,13 +124,13 @@ public:
 
     bool isDisposed() const override
     {
-        return mDone.load(std::memory_order_acquire);
+        return mDisposed.load(std::memory_order_acquire);
     }
 
 private:
     struct ActiveWindow
     {
-        std::shared_ptr<WindowSubject> subject;
+        std::shared_ptr<UnicastSubject> subject;
         int32_t count = 0;
     };
 
@@ -240,7 +138,8 @@ private:
     int32_t mCount;
     int32_t mSkip;
     DisposablePtr mUpstream;
-    std::atomic<bool> mDone{false};
+    std::atomic<bool> mDone{false}; // Terminated or disposed
+    std::atomic<bool> mDisposed{false};
 
     int64_t mIndex = 0;
     std::deque<ActiveWindow> mWindows;
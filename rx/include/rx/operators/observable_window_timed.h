@@ -0,0 +1,369 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_OBSERVABLE_WINDOW_TIMED_H
+#define RX_OBSERVABLE_WINDOW_TIMED_H
+
+#include "observable_window.h"
+#include "../scheduler.h"
+#include "../disposables/sequential_disposable.h"
+
+#include <algorithm>
+
+
+namespace rx
+{
+// Time-bounded windows driven by a single timer task per subscription.
+// Exact mode (timeskip == 0): one window at a time, replaced every timespan or as soon as it received maxCount
+// values, a size rollover restarts the timer. Skip mode: a window opens every timeskip and closes timespan
+// after it opened.
+// Upstream values and timer ticks are queued as signals and handled by whichever thread wins the WIP counter,
+// so window state is only touched by one thread at a time and needs no lock of its own.
+class WindowTimedObserver : public Observer, public Disposable, public std::enable_shared_from_this<WindowTimedObserver>
+{
+public:
+    WindowTimedObserver(const ObserverPtr &downstream, uint64_t timespan, uint64_t timeskip, uint64_t maxCount,
+                        const WorkerPtr &worker)
+        : mDownstream(downstream),
+          mTimespan(timespan),
+          mTimeskip(timeskip),
+          mMaxCount(maxCount),
+          mWorker(worker),
+          mTimer(std::make_shared<SequentialDisposable>())
+    {
+        LeakObserver::make<WindowTimedObserver>();
+    }
+
+    ~WindowTimedObserver() override
+    {
+        LeakObserver::release<WindowTimedObserver>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (DisposableHelper::validate(mUpstream, d)) {
+            if (const auto ds = mDownstream) {
+                mUpstream = d;
+                ds->onSubscribe(shared_from_this());
+                // The first drain opens the initial window(s) and starts the timer
+                drain();
+            }
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            mSignals.push_back({value, false, 0});
+        }
+        drain();
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            mTerminated = true;
+            mError = std::make_unique<GAnyException>(e);
+            mSignals.clear();
+        }
+        mTimer->dispose();
+        drain();
+    }
+
+    void onComplete() override
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            mTerminated = true;
+        }
+        mTimer->dispose();
+        drain();
+    }
+
+    void dispose() override
+    {
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto d = mUpstream) {
+            d->dispose();
+        }
+        mTimer->dispose();
+        mWorker->dispose();
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Signal
+    {
+        GAny value;
+        bool tick = false;
+        uint64_t generation = 0;
+    };
+
+    void tick(uint64_t generation)
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (mTerminated) {
+                return;
+            }
+            mSignals.push_back({GAny(), true, generation});
+        }
+        drain();
+    }
+
+    // Only called from the drain loop, so there is never more than one timer being replaced at a time
+    void schedule(uint64_t delay, uint64_t generation)
+    {
+        std::weak_ptr<WindowTimedObserver> weakSelf = shared_from_this();
+        mTimer->update(mWorker->schedule([weakSelf, generation] {
+            if (const auto self = weakSelf.lock()) {
+                self->tick(generation);
+            }
+        }, delay));
+    }
+
+    std::shared_ptr<UnicastSubject> openWindow()
+    {
+        auto window = std::make_shared<UnicastSubject>();
+        mDownstream->onNext(std::static_pointer_cast<Observable>(window));
+        return window;
+    }
+
+    void start()
+    {
+        mStart = mWorker->now();
+        if (mTimeskip == 0) {
+            mWindow = openWindow();
+            schedule(mTimespan, mGeneration);
+        } else {
+            mOpen.push_back({mTimespan, openWindow()});
+            mNextOpen = mTimeskip;
+            schedule(std::min(mTimespan, mTimeskip), 0);
+        }
+    }
+
+    // Exact mode only: closes the current window and opens the next one on a fresh timer
+    void rollover()
+    {
+        mWindow->onComplete();
+        mCount = 0;
+        mWindow = openWindow();
+        schedule(mTimespan, ++mGeneration);
+    }
+
+    void handleValue(const GAny &value)
+    {
+        if (mTimeskip > 0) {
+            for (const auto &[closeAt, window]: mOpen) {
+                window->onNext(value);
+            }
+            return;
+        }
+        mWindow->onNext(value);
+        if (mMaxCount > 0 && ++mCount >= mMaxCount) {
+            rollover();
+        }
+    }
+
+    void handleTick(uint64_t generation)
+    {
+        if (mTimeskip == 0) {
+            // A size rollover restarted the timer, this tick belongs to the previous window
+            if (generation == mGeneration) {
+                rollover();
+            }
+            return;
+        }
+        const uint64_t elapsed = (mWorker->now() - mStart) / 1000000;
+        while (!mOpen.empty() && mOpen.front().first <= elapsed) {
+            mOpen.front().second->onComplete();
+            mOpen.pop_front();
+        }
+        while (mNextOpen <= elapsed) {
+            mOpen.push_back({mNextOpen + mTimespan, openWindow()});
+            mNextOpen += mTimeskip;
+        }
+        const uint64_t next = mOpen.empty() ? mNextOpen : std::min(mNextOpen, mOpen.front().first);
+        schedule(std::max<uint64_t>(next - elapsed, 1), 0);
+    }
+
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        while (true) {
+            while (true) {
+                if (mCancelled.load(std::memory_order_acquire)) {
+                    clear();
+                    return;
+                }
+                if (!mStarted) {
+                    mStarted = true;
+                    start();
+                    continue;
+                }
+
+                Signal signal;
+                bool hasSignal = false;
+                bool terminated;
+                {
+                    GLockerGuard lock(mLock);
+                    if (!mSignals.empty()) {
+                        signal = std::move(mSignals.front());
+                        mSignals.pop_front();
+                        hasSignal = true;
+                    }
+                    terminated = mTerminated;
+                }
+
+                if (hasSignal) {
+                    if (signal.tick) {
+                        handleTick(signal.generation);
+                    } else {
+                        handleValue(signal.value);
+                    }
+                    continue;
+                }
+                if (terminated) {
+                    terminate();
+                    return;
+                }
+                break;
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    // Disposes the worker first so no timer opens a window behind the terminal, the open windows end with the
+    // same signal as the outer stream
+    void terminate()
+    {
+        mWorker->dispose();
+        const auto downstream = std::move(mDownstream);
+        mUpstream = nullptr;
+        closeWindows();
+        if (downstream) {
+            if (mError) {
+                downstream->onError(*mError);
+            } else {
+                downstream->onComplete();
+            }
+        }
+    }
+
+    void closeWindows()
+    {
+        if (mWindow) {
+            mOpen.push_back({0, std::move(mWindow)});
+        }
+        for (const auto &[closeAt, window]: mOpen) {
+            if (mError) {
+                window->onError(*mError);
+            } else {
+                window->onComplete();
+            }
+        }
+        mOpen.clear();
+    }
+
+    void clear()
+    {
+        closeWindows();
+        {
+            GLockerGuard lock(mLock);
+            mSignals.clear();
+        }
+        mDownstream = nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    DisposablePtr mUpstream;
+    uint64_t mTimespan;
+    uint64_t mTimeskip;
+    uint64_t mMaxCount;
+    WorkerPtr mWorker;
+    std::shared_ptr<SequentialDisposable> mTimer;
+
+    GMutex mLock;
+    std::deque<Signal> mSignals;
+    bool mTerminated = false;
+    std::unique_ptr<GAnyException> mError;
+
+    // Owned by the draining thread
+    bool mStarted = false;
+    uint64_t mStart = 0;
+    std::shared_ptr<UnicastSubject> mWindow;                                 // Exact mode
+    uint64_t mCount = 0;                                                    // Exact mode
+    uint64_t mGeneration = 0;                                               // Exact mode, bumped whenever the timer restarts
+    std::deque<std::pair<uint64_t, std::shared_ptr<UnicastSubject> > > mOpen; // Skip mode, (close time in ms since start, window)
+    uint64_t mNextOpen = 0;                                                 // Skip mode, ms since start
+
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mCancelled = false;
+};
+
+class ObservableWindowTimed : public Observable
+{
+public:
+    ObservableWindowTimed(ObservableSourcePtr source, uint64_t timespan, uint64_t timeskip, uint64_t maxCount,
+                          SchedulerPtr scheduler)
+        : mSource(std::move(source)),
+          mTimespan(timespan),
+          mTimeskip(timeskip),
+          mMaxCount(maxCount),
+          mScheduler(std::move(scheduler))
+    {
+        LeakObserver::make<ObservableWindowTimed>();
+    }
+
+    ~ObservableWindowTimed() override
+    {
+        LeakObserver::release<ObservableWindowTimed>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        mSource->subscribe(std::make_shared<WindowTimedObserver>(observer, mTimespan, mTimeskip, mMaxCount,
+                                                                 mScheduler->createWorker()));
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    uint64_t mTimespan;
+    uint64_t mTimeskip;
+    uint64_t mMaxCount;
+    SchedulerPtr mScheduler;
+};
+} // rx
+
+#endif //RX_OBSERVABLE_WINDOW_TIMED_H
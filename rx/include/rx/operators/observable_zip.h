@@ -8,9 +8,11 @@
 #include "../observable.h"
 #include "../exception_helper.h"
 #include "../leak_observer.h"
+#include "../spsc_queue.h"
+#include "multi_source_drain.h"
+#include <memory>
+#include <string>
 #include <vector>
-#include <deque>
-#include <mutex>
 
 
 namespace rx
@@ -39,16 +41,21 @@ private:
     size_t mIndex;
 };
 
-class ZipCoordinator : public Disposable, public std::enable_shared_from_this<ZipCoordinator>
+// Each source feeds its own SPSC queue, whichever thread wins the WIP counter drains complete rows,
+// so sources on different threads never block each other.
+class ZipCoordinator : public MultiSourceDrain, public std::enable_shared_from_this<ZipCoordinator>
 {
 public:
-    ZipCoordinator(const ObserverPtr &downstream, CombineLatestFunction zipper, size_t count)
-        : mDownstream(downstream), mZipper(std::move(zipper)), mObservers(count), mCompleted(count, false)
+    ZipCoordinator(const ObserverPtr &downstream, CombineLatestFunction zipper, size_t count,
+                   size_t capacity, OverflowStrategy strategy)
+        : MultiSourceDrain(downstream), mZipper(std::move(zipper)), mObservers(count), mDone(count),
+          mRow(count), mStrategy(strategy)
     {
         LeakObserver::make<ZipCoordinator>();
-        mRows.resize(count);
+        mQueues.reserve(count);
         for (size_t i = 0; i < count; ++i) {
             mObservers[i] = std::make_shared<ZipInnerObserver>(nullptr, i);
+            mQueues.push_back(std::make_unique<SpscQueue>(capacity));
         }
     }
 
@@ -65,205 +72,95 @@ public:
         }
 
         for (size_t i = 0; i < sources.size(); ++i) {
-            if (isDisposed()) {
+            if (isCancelled()) {
                 break;
             }
             sources[i]->subscribe(mObservers[i]);
         }
     }
 
-    void onSubscribe(size_t /*index*/, const DisposablePtr &d)
-    {
-        bool disposeNow = false;
-        {
-            GLockerGuard lock(mLock);
-            if (mCancelled) {
-                disposeNow = true;
-            } else {
-                mDisposables.push_back(d);
-            }
-        }
-        if (disposeNow) {
-            d->dispose();
-        }
-    }
-
     void onNext(size_t index, const GAny &value)
     {
-        std::lock_guard<std::recursive_mutex> signalLock(mSignalLock);
-        std::vector<GAny> args;
-        ObserverPtr downstream;
-        {
-            GLockerGuard lock(mLock);
-            if (mCancelled) {
-                return;
-            }
-            mRows[index].push_back(value);
-            if (!takeRow(args)) {
-                return;
-            }
-            ++mInFlight;
-            downstream = mDownstream;
-        }
-        if (!mCancelled) {
-            emit(args, downstream);
+        if (isCancelled() || mDone[index].load(std::memory_order_acquire)) {
+            return;
         }
-    }
-
-    void onError(const GAnyException &e)
-    {
-        std::lock_guard<std::recursive_mutex> signalLock(mSignalLock);
-        ObserverPtr downstream;
-        std::vector<DisposablePtr> disposables;
-        {
-            GLockerGuard lock(mLock);
-            if (mCancelled) {
+        if (!mQueues[index]->offer(value)) {
+            if (mStrategy == OverflowStrategy::DropLatest) {
                 return;
             }
-            downstream = mDownstream;
-            cancelAll(disposables);
-        }
-        disposeAll(disposables);
-        if (downstream) {
-            downstream->onError(e);
+            onError(GAnyException("Zip: Source buffer exceeded its capacity of " +
+                                  std::to_string(mQueues[index]->capacity())));
+            return;
         }
+        drain();
     }
 
     void onComplete(size_t index)
     {
-        std::lock_guard<std::recursive_mutex> signalLock(mSignalLock);
-        ObserverPtr downstream;
-        std::vector<DisposablePtr> disposables;
-        {
-            GLockerGuard lock(mLock);
-            if (mCancelled) {
-                return;
-            }
-            mCompleted[index] = true;
-            if (!hasCompleteEmptySource() || mInFlight != 0) {
-                return;
-            }
-            downstream = mDownstream;
-            cancelAll(disposables);
-        }
-        disposeAll(disposables);
-        if (downstream) {
-            downstream->onComplete();
-        }
-    }
-
-    void dispose() override
-    {
-        std::lock_guard<std::recursive_mutex> signalLock(mSignalLock);
-        std::vector<DisposablePtr> disposables;
-        {
-            GLockerGuard lock(mLock);
-            if (mCancelled) {
-                return;
-            }
-            cancelAll(disposables);
-        }
-        disposeAll(disposables);
-    }
-
-    bool isDisposed() const override
-    {
-        return mCancelled;
+        mDone[index].store(true, std::memory_order_release);
+        drain();
     }
 
-private:
-    bool takeRow(std::vector<GAny> &args)
-    {
-        for (const auto &row: mRows) {
-            if (row.empty()) {
-                return false;
+protected:
+    bool drainNext() override
+    {
+        // Scan every source, a finished and drained one completes the zip even behind an idle one
+        bool ready = true;
+        for (size_t i = 0; i < mQueues.size(); ++i) {
+            // Read done before emptiness, the last offer happens before the done flag
+            const bool done = mDone[i].load(std::memory_order_acquire);
+            if (mQueues[i]->isEmpty()) {
+                if (done) {
+                    complete();
+                    return true;
+                }
+                ready = false;
             }
         }
-        args.reserve(mRows.size());
-        for (auto &row: mRows) {
-            args.push_back(row.front());
-            row.pop_front();
+        if (!ready) {
+            return false;
         }
-        return true;
-    }
 
-    bool hasCompleteEmptySource() const
-    {
-        for (size_t i = 0; i < mRows.size(); ++i) {
-            if (mCompleted[i] && mRows[i].empty()) {
-                return true;
-            }
+        for (size_t i = 0; i < mQueues.size(); ++i) {
+            mQueues[i]->poll(mRow[i]);
         }
-        return false;
-    }
-
-    void emit(const std::vector<GAny> &args, const ObserverPtr &downstream)
-    {
         GAny result;
         try {
-            result = mZipper(args);
+            result = mZipper(mRow);
         } catch (...) {
-            onError(ExceptionHelper::fromCurrentException("Zip: Zipper failed"));
-            return;
+            fail(ExceptionHelper::fromCurrentException("Zip: Zipper failed"));
+            return true;
         }
-        if (!isDisposed() && downstream) {
-            downstream->onNext(result);
+        for (auto &value: mRow) {
+            value = GAny();
         }
-        ObserverPtr completionDownstream;
-        std::vector<DisposablePtr> disposables;
-        {
-            GLockerGuard lock(mLock);
-            if (!mCancelled) {
-                --mInFlight;
-            }
-            if (!mCancelled && mInFlight == 0 && hasCompleteEmptySource()) {
-                completionDownstream = mDownstream;
-                cancelAll(disposables);
-            }
-        }
-        disposeAll(disposables);
-        if (completionDownstream) {
-            completionDownstream->onComplete();
-        }
-    }
-
-    void cancelAll(std::vector<DisposablePtr> &disposables)
-    {
-        mCancelled = true;
-        disposables = std::move(mDisposables);
-        mDisposables.clear();
-        mRows.clear();
-        mObservers.clear();     // Clear observer references
-        mDownstream = nullptr;   // Release downstream reference
+        emit(result);
+        return true;
     }
 
-    static void disposeAll(const std::vector<DisposablePtr> &disposables)
+    void clearQueues() override
     {
-        for (const auto &disposable: disposables) {
-            if (disposable) {
-                disposable->dispose();
-            }
+        for (const auto &queue: mQueues) {
+            queue->clear();
+        }
+        for (auto &value: mRow) {
+            value = GAny();
         }
     }
 
 private:
-    ObserverPtr mDownstream;
     CombineLatestFunction mZipper;
     std::vector<std::shared_ptr<ZipInnerObserver> > mObservers;
-    std::vector<DisposablePtr> mDisposables;
-    std::vector<std::deque<GAny> > mRows;
-    std::vector<bool> mCompleted;
-    size_t mInFlight = 0;
-
-    std::atomic<bool> mCancelled = false;
-    GMutex mLock;
-    std::recursive_mutex mSignalLock;
+    std::vector<std::unique_ptr<SpscQueue> > mQueues;
+    std::vector<std::atomic<bool> > mDone;
+    std::vector<GAny> mRow; // Reused tuple buffer handed to the zipper
+    OverflowStrategy mStrategy;
 };
 
 inline void ZipInnerObserver::onSubscribe(const DisposablePtr &d)
 {
     if (const auto p = mParent.lock()) {
-        p->onSubscribe(mIndex, d);
+        p->onSubscribe(d);
     }
 }
 
@@ -291,8 +188,9 @@ inline void ZipInnerObserver::onComplete()
 class ObservableZip : public Observable
 {
 public:
-    ObservableZip(std::vector<std::shared_ptr<Observable> > sources, CombineLatestFunction zipper)
-        : mSources(std::move(sources)), mZipper(std::move(zipper))
+    ObservableZip(std::vector<std::shared_ptr<Observable> > sources, CombineLatestFunction zipper,
+                  size_t capacity = 0, OverflowStrategy strategy = OverflowStrategy::Error)
+        : mSources(std::move(sources)), mZipper(std::move(zipper)), mCapacity(capacity), mStrategy(strategy)
     {
         LeakObserver::make<ObservableZip>();
     }
@@ -310,7 +208,7 @@ protected:
             observer->onComplete();
             return;
         }
-        const auto coordinator = std::make_shared<ZipCoordinator>(observer, mZipper, mSources.size());
+        const auto coordinator = std::make_shared<ZipCoordinator>(observer, mZipper, mSources.size(), mCapacity, mStrategy);
         observer->onSubscribe(coordinator);
         coordinator->subscribe(mSources);
     }
@@ -318,6 +216,8 @@ protected:
 private:
     std::vector<std::shared_ptr<Observable> > mSources;
     CombineLatestFunction mZipper;
+    size_t mCapacity;
+    OverflowStrategy mStrategy;
 };
 } // rx
 
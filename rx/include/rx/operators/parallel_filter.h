@@ -0,0 +1,134 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_FILTER_H
+#define RX_PARALLEL_FILTER_H
+
+#include "../parallel_observable.h"
+#include "../exception_helper.h"
+#include "../leak_observer.h"
+
+
+namespace rx
+{
+// Filters the values of one rail on the thread that rail runs on, the kept values keep their source index and
+// a dropped one is reported through onSkip() so an ordered merge does not wait for it
+class ParallelFilterRail : public RailObserver
+{
+public:
+    ParallelFilterRail(const RailObserverPtr &downstream, const FilterFunction &predicate)
+        : mDownstream(downstream), mFunction(predicate)
+    {
+        LeakObserver::make<ParallelFilterRail>();
+    }
+
+    ~ParallelFilterRail() override
+    {
+        LeakObserver::release<ParallelFilterRail>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        mUpstream = d;
+        mDownstream->onSubscribe(d);
+    }
+
+    void onNext(uint64_t index, const GAny &value) override
+    {
+        if (mDone) {
+            return;
+        }
+        bool keep;
+        try {
+            keep = mFunction(value);
+        } catch (...) {
+            mUpstream->dispose();
+            onError(ExceptionHelper::fromCurrentException("ParallelFilter: Predicate failed"));
+            return;
+        }
+        if (keep) {
+            mDownstream->onNext(index, value);
+        } else {
+            mDownstream->onSkip(index);
+        }
+    }
+
+    void onSkip(uint64_t index) override
+    {
+        if (!mDone) {
+            mDownstream->onSkip(index);
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone) {
+            return;
+        }
+        mDone = true;
+        mDownstream->onError(e);
+    }
+
+    void onComplete() override
+    {
+        if (mDone) {
+            return;
+        }
+        mDone = true;
+        mDownstream->onComplete();
+    }
+
+private:
+    RailObserverPtr mDownstream;
+    FilterFunction mFunction;
+    DisposablePtr mUpstream;
+    bool mDone = false; // Signals of one rail are serialized
+};
+
+class ParallelFilter : public ParallelObservable
+{
+public:
+    ParallelFilter(ParallelObservablePtr source, FilterFunction function)
+        : mSource(std::move(source)), mFunction(std::move(function))
+    {
+        LeakObserver::make<ParallelFilter>();
+    }
+
+    ~ParallelFilter() override
+    {
+        LeakObserver::release<ParallelFilter>();
+    }
+
+public:
+    uint32_t parallelism() const override
+    {
+        return mSource->parallelism();
+    }
+
+    bool runsOnWorkers() const override
+    {
+        return mSource->runsOnWorkers();
+    }
+
+    void subscribe(const std::vector<RailObserverPtr> &rails) override
+    {
+        if (!validate(rails)) {
+            return;
+        }
+        std::vector<RailObserverPtr> upstreamRails;
+        upstreamRails.reserve(rails.size());
+        for (const auto &rail: rails) {
+            upstreamRails.push_back(std::make_shared<ParallelFilterRail>(rail, mFunction));
+        }
+        mSource->subscribe(upstreamRails);
+    }
+
+private:
+    ParallelObservablePtr mSource;
+    FilterFunction mFunction;
+};
+} // rx
+
+#endif //RX_PARALLEL_FILTER_H
@@ -0,0 +1,218 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_FROM_H
+#define RX_PARALLEL_FROM_H
+
+#include "../parallel_observable.h"
+#include "../disposables/disposable_helper.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+namespace rx
+{
+class ParallelFromObserver;
+
+// Handle of one rail, the upstream is disposed once every rail disposed its handle
+class ParallelRailDisposable : public Disposable
+{
+public:
+    ParallelRailDisposable(const std::shared_ptr<ParallelFromObserver> &parent, size_t rail)
+        : mParent(parent), mRail(rail)
+    {
+        LeakObserver::make<ParallelRailDisposable>();
+    }
+
+    ~ParallelRailDisposable() override
+    {
+        LeakObserver::release<ParallelRailDisposable>();
+    }
+
+public:
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    std::weak_ptr<ParallelFromObserver> mParent;
+    size_t mRail;
+    std::atomic<bool> mDisposed = false;
+};
+
+// Deals the upstream out to the rails in runs of batchSize consecutive values. A run is collected on the
+// upstream thread and handed to its rail in one onNextBatch() call, so a rail that runs on its own worker
+// publishes and schedules once per run. A partial run waits for the rest of it or for the upstream terminal.
+class ParallelFromObserver : public Observer, public std::enable_shared_from_this<ParallelFromObserver>
+{
+public:
+    ParallelFromObserver(const std::vector<RailObserverPtr> &rails, uint32_t batchSize)
+        : mRails(rails),
+          mRailCount(rails.size()),
+          mCancelled(std::make_unique<std::atomic<bool>[]>(rails.size())),
+          mBatchSize(batchSize)
+    {
+        LeakObserver::make<ParallelFromObserver>();
+        mBatch.reserve(batchSize);
+    }
+
+    ~ParallelFromObserver() override
+    {
+        LeakObserver::release<ParallelFromObserver>();
+    }
+
+public:
+    void cancelRail(size_t rail)
+    {
+        if (mCancelled[rail].exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (mCancelledCount.fetch_add(1, std::memory_order_acq_rel) + 1 == mRailCount) {
+            DisposableHelper::dispose(mUpstream, mLock);
+        }
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (!DisposableHelper::setOnce(mUpstream, d, mLock)) {
+            return;
+        }
+        const auto self = shared_from_this();
+        for (size_t i = 0; i < mRails.size(); ++i) {
+            mRails[i]->onSubscribe(std::make_shared<ParallelRailDisposable>(self, i));
+        }
+    }
+
+    void onNext(const GAny &value) override
+    {
+        if (mDone) {
+            return;
+        }
+        const uint64_t index = mIndex++;
+        if (mBatchSize == 1) {
+            const size_t rail = index % mRailCount;
+            if (!mCancelled[rail].load(std::memory_order_acquire)) {
+                mRails[rail]->onNext(index, value);
+            }
+            return;
+        }
+        mBatch.push_back(value);
+        if (mBatch.size() == mBatchSize) {
+            flush();
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone) {
+            return;
+        }
+        mDone = true;
+        flush();
+        for (size_t i = 0; i < mRails.size(); ++i) {
+            if (!mCancelled[i].load(std::memory_order_acquire)) {
+                mRails[i]->onError(e);
+            }
+        }
+        mRails.clear();
+    }
+
+    void onComplete() override
+    {
+        if (mDone) {
+            return;
+        }
+        mDone = true;
+        flush();
+        for (size_t i = 0; i < mRails.size(); ++i) {
+            if (!mCancelled[i].load(std::memory_order_acquire)) {
+                mRails[i]->onComplete();
+            }
+        }
+        mRails.clear();
+    }
+
+private:
+    // Hands the collected run to its rail, the run starts at mIndex - mBatch.size()
+    void flush()
+    {
+        if (mBatch.empty()) {
+            return;
+        }
+        const uint64_t firstIndex = mIndex - mBatch.size();
+        const size_t rail = (firstIndex / mBatchSize) % mRailCount;
+        auto batch = std::move(mBatch);
+        mBatch = {};
+        mBatch.reserve(mBatchSize);
+        if (!mCancelled[rail].load(std::memory_order_acquire)) {
+            mRails[rail]->onNextBatch(firstIndex, std::move(batch));
+        }
+    }
+
+private:
+    std::vector<RailObserverPtr> mRails; // Released on termination
+    const size_t mRailCount;
+    std::unique_ptr<std::atomic<bool>[]> mCancelled;
+    std::atomic<size_t> mCancelledCount = 0;
+    uint32_t mBatchSize;
+    uint64_t mIndex = 0;      // Upstream thread only
+    std::vector<GAny> mBatch; // Upstream thread only, the run being collected
+    bool mDone = false;       // Upstream thread only
+
+    DisposablePtr mUpstream;
+    GMutex mLock;
+};
+
+inline void ParallelRailDisposable::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (const auto parent = mParent.lock()) {
+        parent->cancelRail(mRail);
+    }
+}
+
+class ParallelFrom : public ParallelObservable
+{
+public:
+    ParallelFrom(ObservableSourcePtr source, uint32_t parallelism, uint32_t batchSize)
+        : mSource(std::move(source)), mParallelism(parallelism), mBatchSize(batchSize)
+    {
+        LeakObserver::make<ParallelFrom>();
+    }
+
+    ~ParallelFrom() override
+    {
+        LeakObserver::release<ParallelFrom>();
+    }
+
+public:
+    uint32_t parallelism() const override
+    {
+        return mParallelism;
+    }
+
+    void subscribe(const std::vector<RailObserverPtr> &rails) override
+    {
+        if (validate(rails)) {
+            mSource->subscribe(std::make_shared<ParallelFromObserver>(rails, mBatchSize));
+        }
+    }
+
+private:
+    ObservableSourcePtr mSource;
+    uint32_t mParallelism;
+    uint32_t mBatchSize;
+};
+} // rx
+
+#endif //RX_PARALLEL_FROM_H
@@ -0,0 +1,373 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_JOIN_H
+#define RX_PARALLEL_JOIN_H
+
+#include "parallel_merge.h"
+#include "../spsc_queue.h"
+#include "../producer_park.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+
+namespace rx
+{
+// Common part of sequential() and sequentialOrdered(): rails queue their values and whichever thread wins the
+// WIP counter moves them to the downstream. Each rail queues at most capacity values; with parkRails a rail
+// that finds its queue full waits on its worker until the drain took one of them.
+class ParallelJoinBase : public ParallelMergeState
+{
+public:
+    ParallelJoinBase(const ObserverPtr &downstream, size_t rails, uint64_t capacity, bool parkRails)
+        : ParallelMergeState(rails), mDownstream(downstream), mCapacity(capacity), mParkRails(parkRails)
+    {
+    }
+
+    ~ParallelJoinBase() override = default;
+
+public:
+    void railNext(size_t rail, uint64_t index, const GAny &value) override
+    {
+        if (mParkRails && !holdBack(rail)) {
+            return;
+        }
+        enqueue(rail, index, value);
+        drain();
+    }
+
+    void railError(size_t, const GAnyException &e) override
+    {
+        {
+            GLockerGuard lock(mErrorLock);
+            if (mError) {
+                return;
+            }
+            mError = std::make_unique<GAnyException>(e);
+        }
+        mFailed.store(true, std::memory_order_release);
+        cancelUpstreams();
+        mPark.wake();
+        drain();
+    }
+
+    void dispose() override
+    {
+        mDisposeRequested.store(true, std::memory_order_release);
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        cancelUpstreams();
+        mPark.wake();
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+protected:
+    enum class Step
+    {
+        Value,   // The next item for the downstream was written to value
+        Empty,   // Nothing can go out until a rail delivers more
+        Finished // Every rail completed and was emptied
+    };
+
+    virtual void enqueue(size_t rail, uint64_t index, const GAny &value) = 0;
+
+    virtual size_t queued(size_t rail) = 0;
+
+    // Only called by the thread that owns the WIP count, like clearQueues()
+    virtual Step next(GAny &value) = 0;
+
+    virtual void clearQueues() = 0;
+
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        GAny value;
+        while (true) {
+            while (true) {
+                if (isDone()) {
+                    clear();
+                    return;
+                }
+                if (mFailed.load(std::memory_order_acquire)) {
+                    terminate();
+                    return;
+                }
+                const Step step = next(value);
+                if (step == Step::Empty) {
+                    break;
+                }
+                if (step == Step::Finished) {
+                    terminate();
+                    return;
+                }
+                if (mParkRails) {
+                    mPark.wake();
+                }
+                mDownstream->onNext(value);
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+private:
+    // Parks the rail's worker while its queue is full, false once the join is done
+    bool holdBack(size_t rail)
+    {
+        while (queued(rail) >= mCapacity) {
+            if (isDone() || mFailed.load(std::memory_order_acquire)) {
+                return false;
+            }
+            mPark.parkWhile([this, rail] {
+                return queued(rail) >= mCapacity && !isDone() && !mFailed.load(std::memory_order_acquire);
+            });
+        }
+        return true;
+    }
+
+    // Delivers the first rail error, or the completion once every rail completed and was emptied. Parked rails
+    // are woken so they see the join is done
+    void terminate()
+    {
+        mDisposed.store(true, std::memory_order_release);
+        mPark.wake();
+        const auto downstream = std::move(mDownstream);
+        clear();
+        if (mError) {
+            downstream->onError(*mError);
+        } else {
+            downstream->onComplete();
+        }
+    }
+
+    void clear()
+    {
+        clearQueues();
+        mDownstream = nullptr;
+    }
+
+private:
+    ObserverPtr mDownstream;
+    const uint64_t mCapacity;
+    const bool mParkRails;
+    GMutex mErrorLock;
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mFailed = false;
+    std::atomic<uint32_t> mWip = 0;
+    ProducerPark mPark;
+};
+
+// sequential(): every rail feeds its own SPSC queue and the drain takes from them in turn
+class ParallelJoinState : public ParallelJoinBase
+{
+public:
+    ParallelJoinState(const ObserverPtr &downstream, size_t rails, uint64_t capacity, bool parkRails)
+        : ParallelJoinBase(downstream, rails, capacity, parkRails)
+    {
+        LeakObserver::make<ParallelJoinState>();
+        mQueues.reserve(rails);
+        for (size_t i = 0; i < rails; ++i) {
+            mQueues.push_back(std::make_unique<SpscQueue>());
+        }
+    }
+
+    ~ParallelJoinState() override
+    {
+        LeakObserver::release<ParallelJoinState>();
+    }
+
+public:
+    void railComplete(size_t) override
+    {
+        mCompletedRails.fetch_add(1, std::memory_order_acq_rel);
+        drain();
+    }
+
+protected:
+    void enqueue(size_t rail, uint64_t, const GAny &value) override
+    {
+        mQueues[rail]->offer(value);
+    }
+
+    size_t queued(size_t rail) override
+    {
+        return mQueues[rail]->size();
+    }
+
+    Step next(GAny &value) override
+    {
+        // Read before polling, every value a completed rail produced is then already queued
+        const bool allCompleted = mCompletedRails.load(std::memory_order_acquire) == railCount();
+        for (size_t i = 0; i < mQueues.size(); ++i) {
+            const size_t rail = mNextRail;
+            mNextRail = (mNextRail + 1) % mQueues.size();
+            if (mQueues[rail]->poll(value)) {
+                return Step::Value;
+            }
+        }
+        return allCompleted ? Step::Finished : Step::Empty;
+    }
+
+    void clearQueues() override
+    {
+        for (const auto &queue: mQueues) {
+            queue->clear();
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<SpscQueue> > mQueues;
+    size_t mNextRail = 0; // Where the next poll starts, so a busy rail cannot starve the others
+    std::atomic<size_t> mCompletedRails = 0;
+};
+
+// sequentialOrdered(): rails queue their values with the source index, the drain only emits the smallest
+// head once every rail that may still produce a smaller index has a head of its own. A rail without a head
+// is passed over once its position, the index after the last value it produced or skipped, is past that head.
+class ParallelJoinOrderedState : public ParallelJoinBase
+{
+public:
+    ParallelJoinOrderedState(const ObserverPtr &downstream, size_t rails, uint64_t capacity, bool parkRails)
+        : ParallelJoinBase(downstream, rails, capacity, parkRails), mRails(rails)
+    {
+        LeakObserver::make<ParallelJoinOrderedState>();
+    }
+
+    ~ParallelJoinOrderedState() override
+    {
+        LeakObserver::release<ParallelJoinOrderedState>();
+    }
+
+public:
+    void railSkip(size_t rail, uint64_t index) override
+    {
+        mRails[rail].position.store(index + 1, std::memory_order_release);
+        drain();
+    }
+
+    void railComplete(size_t rail) override
+    {
+        mRails[rail].completed.store(true, std::memory_order_release);
+        drain();
+    }
+
+protected:
+    void enqueue(size_t rail, uint64_t index, const GAny &value) override
+    {
+        auto &r = mRails[rail];
+        {
+            GLockerGuard lock(r.lock);
+            r.queue.emplace_back(index, value);
+        }
+        r.position.store(index + 1, std::memory_order_release);
+    }
+
+    size_t queued(size_t rail) override
+    {
+        auto &r = mRails[rail];
+        GLockerGuard lock(r.lock);
+        return r.queue.size();
+    }
+
+    Step next(GAny &value) override
+    {
+        Rail *head = nullptr;
+        uint64_t headIndex = 0;
+        bool pending = false;
+        uint64_t pendingPosition = UINT64_MAX; // Lowest index an empty rail may still produce
+        for (auto &rail: mRails) {
+            // Read before the queue, a completed rail has queued everything it will produce and a
+            // position only moves once the value before it is queued
+            const bool completed = rail.completed.load(std::memory_order_acquire);
+            const uint64_t position = rail.position.load(std::memory_order_acquire);
+            GLockerGuard lock(rail.lock);
+            if (rail.queue.empty()) {
+                if (!completed) {
+                    pending = true;
+                    pendingPosition = std::min(pendingPosition, position);
+                }
+                continue;
+            }
+            if (!head || rail.queue.front().first < headIndex) {
+                head = &rail;
+                headIndex = rail.queue.front().first;
+            }
+        }
+        if (!head) {
+            return pending ? Step::Empty : Step::Finished;
+        }
+        if (pending && pendingPosition <= headIndex) {
+            return Step::Empty;
+        }
+
+        GLockerGuard lock(head->lock);
+        value = std::move(head->queue.front().second);
+        head->queue.pop_front();
+        return Step::Value;
+    }
+
+    void clearQueues() override
+    {
+        for (auto &rail: mRails) {
+            GLockerGuard lock(rail.lock);
+            rail.queue.clear();
+        }
+    }
+
+private:
+    struct alignas(64) Rail
+    {
+        GMutex lock;
+        std::deque<std::pair<uint64_t, GAny> > queue;
+        std::atomic<uint64_t> position = 0; // No index below it is still to come, stored after the queue
+        std::atomic<bool> completed = false;
+    };
+
+private:
+    std::vector<Rail> mRails;
+};
+
+template<typename State>
+class ParallelJoin : public Observable
+{
+public:
+    ParallelJoin(ParallelObservablePtr source, uint64_t capacity)
+        : mSource(std::move(source)), mCapacity(capacity)
+    {
+        LeakObserver::make<ParallelJoin>();
+    }
+
+    ~ParallelJoin() override
+    {
+        LeakObserver::release<ParallelJoin>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const size_t rails = mSource->parallelism();
+        const auto state = std::make_shared<State>(observer, rails, mCapacity, mSource->runsOnWorkers());
+        observer->onSubscribe(state);
+        mSource->subscribe(ParallelMergeRail<State>::create(state, rails));
+    }
+
+private:
+    ParallelObservablePtr mSource;
+    uint64_t mCapacity;
+};
+} // rx
+
+#endif //RX_PARALLEL_JOIN_H
@@ -0,0 +1,129 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_MAP_H
+#define RX_PARALLEL_MAP_H
+
+#include "../parallel_observable.h"
+#include "../exception_helper.h"
+#include "../leak_observer.h"
+
+
+namespace rx
+{
+// Maps the values of one rail on the thread that rail runs on, the source index is kept
+class ParallelMapRail : public RailObserver
+{
+public:
+    ParallelMapRail(const RailObserverPtr &downstream, const MapFunction &function)
+        : mDownstream(downstream), mFunction(function)
+    {
+        LeakObserver::make<ParallelMapRail>();
+    }
+
+    ~ParallelMapRail() override
+    {
+        LeakObserver::release<ParallelMapRail>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        mUpstream = d;
+        mDownstream->onSubscribe(d);
+    }
+
+    void onNext(uint64_t index, const GAny &value) override
+    {
+        if (mDone) {
+            return;
+        }
+        GAny r;
+        try {
+            r = mFunction(value);
+        } catch (...) {
+            mUpstream->dispose();
+            onError(ExceptionHelper::fromCurrentException("ParallelMap: Mapper failed"));
+            return;
+        }
+        mDownstream->onNext(index, r);
+    }
+
+    void onSkip(uint64_t index) override
+    {
+        if (!mDone) {
+            mDownstream->onSkip(index);
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone) {
+            return;
+        }
+        mDone = true;
+        mDownstream->onError(e);
+    }
+
+    void onComplete() override
+    {
+        if (mDone) {
+            return;
+        }
+        mDone = true;
+        mDownstream->onComplete();
+    }
+
+private:
+    RailObserverPtr mDownstream;
+    MapFunction mFunction;
+    DisposablePtr mUpstream;
+    bool mDone = false; // Signals of one rail are serialized
+};
+
+class ParallelMap : public ParallelObservable
+{
+public:
+    ParallelMap(ParallelObservablePtr source, MapFunction function)
+        : mSource(std::move(source)), mFunction(std::move(function))
+    {
+        LeakObserver::make<ParallelMap>();
+    }
+
+    ~ParallelMap() override
+    {
+        LeakObserver::release<ParallelMap>();
+    }
+
+public:
+    uint32_t parallelism() const override
+    {
+        return mSource->parallelism();
+    }
+
+    bool runsOnWorkers() const override
+    {
+        return mSource->runsOnWorkers();
+    }
+
+    void subscribe(const std::vector<RailObserverPtr> &rails) override
+    {
+        if (!validate(rails)) {
+            return;
+        }
+        std::vector<RailObserverPtr> upstreamRails;
+        upstreamRails.reserve(rails.size());
+        for (const auto &rail: rails) {
+            upstreamRails.push_back(std::make_shared<ParallelMapRail>(rail, mFunction));
+        }
+        mSource->subscribe(upstreamRails);
+    }
+
+private:
+    ParallelObservablePtr mSource;
+    MapFunction mFunction;
+};
+} // rx
+
+#endif //RX_PARALLEL_MAP_H
@@ -0,0 +1,159 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_MERGE_H
+#define RX_PARALLEL_MERGE_H
+
+#include "../parallel_observable.h"
+#include "../leak_observer.h"
+
+#include <gx/gmutex.h>
+
+#include <atomic>
+#include <vector>
+
+
+namespace rx
+{
+// Common part of the operators that merge rails back into one Observable. It keeps the upstream handle of
+// every rail, so disposing the result or a failing rail cancels all of them.
+class ParallelMergeState : public Disposable
+{
+public:
+    explicit ParallelMergeState(size_t rails)
+        : mUpstreams(rails), mRailCount(rails)
+    {
+    }
+
+    ~ParallelMergeState() override = default;
+
+public:
+    void setUpstream(size_t rail, const DisposablePtr &d)
+    {
+        {
+            GLockerGuard lock(mLock);
+            if (!mCancelled) {
+                mUpstreams[rail] = d;
+                return;
+            }
+        }
+        d->dispose();
+    }
+
+    virtual void railNext(size_t rail, uint64_t index, const GAny &value) = 0;
+
+    // Only sequentialOrdered() needs to know how far a rail got without producing a value
+    virtual void railSkip(size_t /*rail*/, uint64_t /*index*/)
+    {
+    }
+
+    virtual void railError(size_t rail, const GAnyException &e) = 0;
+
+    virtual void railComplete(size_t rail) = 0;
+
+    bool isDisposed() const override
+    {
+        return mDisposeRequested.load(std::memory_order_acquire);
+    }
+
+protected:
+    void cancelUpstreams()
+    {
+        std::vector<DisposablePtr> upstreams;
+        {
+            GLockerGuard lock(mLock);
+            if (mCancelled) {
+                return;
+            }
+            mCancelled = true;
+            upstreams.swap(mUpstreams);
+        }
+        for (const auto &d: upstreams) {
+            if (d) {
+                d->dispose();
+            }
+        }
+    }
+
+    size_t railCount() const
+    {
+        return mRailCount;
+    }
+
+    bool isDone() const
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+protected:
+    std::atomic<bool> mDisposed = false;         // Set by whoever took over the downstream, a terminal event or dispose()
+    std::atomic<bool> mDisposeRequested = false; // Set by dispose() only
+
+private:
+    GMutex mLock;
+    std::vector<DisposablePtr> mUpstreams;
+    const size_t mRailCount;
+    bool mCancelled = false;
+};
+
+// Forwards the signals of one rail to the merging operator
+template<typename Parent>
+class ParallelMergeRail : public RailObserver
+{
+public:
+    ParallelMergeRail(const std::shared_ptr<Parent> &parent, size_t rail)
+        : mParent(parent), mRail(rail)
+    {
+        LeakObserver::make<ParallelMergeRail>();
+    }
+
+    ~ParallelMergeRail() override
+    {
+        LeakObserver::release<ParallelMergeRail>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        mParent->setUpstream(mRail, d);
+    }
+
+    void onNext(uint64_t index, const GAny &value) override
+    {
+        mParent->railNext(mRail, index, value);
+    }
+
+    void onSkip(uint64_t index) override
+    {
+        mParent->railSkip(mRail, index);
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        mParent->railError(mRail, e);
+    }
+
+    void onComplete() override
+    {
+        mParent->railComplete(mRail);
+    }
+
+    // One forwarding observer per rail of parent
+    static std::vector<RailObserverPtr> create(const std::shared_ptr<Parent> &parent, size_t rails)
+    {
+        std::vector<RailObserverPtr> observers;
+        observers.reserve(rails);
+        for (size_t i = 0; i < rails; ++i) {
+            observers.push_back(std::make_shared<ParallelMergeRail>(parent, i));
+        }
+        return observers;
+    }
+
+private:
+    std::shared_ptr<Parent> mParent;
+    size_t mRail;
+};
+} // rx
+
+#endif //RX_PARALLEL_MERGE_H
@@ -0,0 +1,153 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_REDUCE_H
+#define RX_PARALLEL_REDUCE_H
+
+#include "parallel_merge.h"
+#include "../exception_helper.h"
+
+#include <memory>
+
+
+namespace rx
+{
+// Every rail folds into its own slot on its own thread, the rail that completes last folds the slots in rail
+// order and emits the result.
+class ParallelReduceState : public ParallelMergeState
+{
+public:
+    ParallelReduceState(const ObserverPtr &downstream, size_t rails, const BiFunction &accumulator)
+        : ParallelMergeState(rails),
+          mDownstream(downstream),
+          mAccumulator(accumulator),
+          mSlots(std::make_unique<Slot[]>(rails)),
+          mRemaining(rails)
+    {
+        LeakObserver::make<ParallelReduceState>();
+    }
+
+    ~ParallelReduceState() override
+    {
+        LeakObserver::release<ParallelReduceState>();
+    }
+
+public:
+    void railNext(size_t rail, uint64_t, const GAny &value) override
+    {
+        if (isDone()) {
+            return;
+        }
+        auto &slot = mSlots[rail];
+        if (!slot.hasValue) {
+            slot.value = value;
+            slot.hasValue = true;
+            return;
+        }
+        try {
+            slot.value = mAccumulator(slot.value, value);
+        } catch (...) {
+            railError(rail, ExceptionHelper::fromCurrentException("ParallelReduce: Accumulator failed"));
+        }
+    }
+
+    void railError(size_t, const GAnyException &e) override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        cancelUpstreams();
+        const auto downstream = std::move(mDownstream);
+        downstream->onError(e);
+    }
+
+    void railComplete(size_t) override
+    {
+        if (mRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        // Every rail has completed, the acquire above makes all slots visible to this thread
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const auto downstream = std::move(mDownstream);
+        GAny result;
+        bool hasValue = false;
+        try {
+            for (size_t i = 0; i < railCount(); ++i) {
+                auto &slot = mSlots[i];
+                if (!slot.hasValue) {
+                    continue;
+                }
+                result = hasValue ? mAccumulator(result, slot.value) : slot.value;
+                hasValue = true;
+                slot.value = GAny();
+            }
+        } catch (...) {
+            downstream->onError(ExceptionHelper::fromCurrentException("ParallelReduce: Accumulator failed"));
+            return;
+        }
+        if (hasValue) {
+            downstream->onNext(result);
+            downstream->onComplete();
+        } else {
+            downstream->onError(GAnyException("No elements in sequence"));
+        }
+    }
+
+    void dispose() override
+    {
+        mDisposeRequested.store(true, std::memory_order_release);
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        cancelUpstreams();
+        mDownstream = nullptr;
+    }
+
+private:
+    // Running fold of one rail, read by the rail that completes last
+    struct alignas(64) Slot
+    {
+        GAny value;
+        bool hasValue = false;
+    };
+
+private:
+    ObserverPtr mDownstream;
+    BiFunction mAccumulator;
+    std::unique_ptr<Slot[]> mSlots;
+    std::atomic<size_t> mRemaining;
+};
+
+class ParallelReduce : public Observable
+{
+public:
+    ParallelReduce(ParallelObservablePtr source, BiFunction accumulator)
+        : mSource(std::move(source)), mAccumulator(std::move(accumulator))
+    {
+        LeakObserver::make<ParallelReduce>();
+    }
+
+    ~ParallelReduce() override
+    {
+        LeakObserver::release<ParallelReduce>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const size_t rails = mSource->parallelism();
+        const auto state = std::make_shared<ParallelReduceState>(observer, rails, mAccumulator);
+        observer->onSubscribe(state);
+        mSource->subscribe(ParallelMergeRail<ParallelReduceState>::create(state, rails));
+    }
+
+private:
+    ParallelObservablePtr mSource;
+    BiFunction mAccumulator;
+};
+} // rx
+
+#endif //RX_PARALLEL_REDUCE_H
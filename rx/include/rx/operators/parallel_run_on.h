@@ -0,0 +1,315 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_RUN_ON_H
+#define RX_PARALLEL_RUN_ON_H
+
+#include "../parallel_observable.h"
+#include "../scheduler.h"
+#include "../producer_park.h"
+#include "../leak_observer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <utility>
+#include <vector>
+
+
+namespace rx
+{
+// Bounded single-producer single-consumer ring of rail runs, values whose indices count up from the first one.
+// It holds at most capacity values, a run larger than that still goes into an empty ring. An empty run stands
+// for a skipped index and counts as one value, so every slot in use counts against the capacity.
+class RailQueue
+{
+public:
+    explicit RailQueue(size_t capacity)
+        : mCapacity(std::max<size_t>(capacity, 1)),
+          mSlots(std::bit_ceil(mCapacity)),
+          mMask(mSlots.size() - 1)
+    {
+    }
+
+public:
+    bool canOffer(size_t count) const
+    {
+        const uint64_t queued = mOfferedValues - mPolledValues.load(std::memory_order_acquire);
+        return queued == 0 || queued + weight(count) <= mCapacity;
+    }
+
+    // Takes values only when the run fits
+    bool offer(uint64_t firstIndex, std::vector<GAny> &values)
+    {
+        if (!canOffer(values.size())) {
+            return false;
+        }
+        const uint64_t p = mProducerIndex.load(std::memory_order_relaxed);
+        auto &slot = mSlots[p & mMask];
+        slot.first = firstIndex;
+        slot.second = std::move(values);
+        mOfferedValues += weight(slot.second.size());
+        mProducerIndex.store(p + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool poll(uint64_t &firstIndex, std::vector<GAny> &values)
+    {
+        const uint64_t c = mConsumerIndex.load(std::memory_order_relaxed);
+        if (c == mProducerIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto &slot = mSlots[c & mMask];
+        firstIndex = slot.first;
+        values = std::move(slot.second);
+        slot.second = {};
+        mConsumerIndex.store(c + 1, std::memory_order_release);
+        mPolledValues.fetch_add(weight(values.size()), std::memory_order_acq_rel);
+        return true;
+    }
+
+    void clear()
+    {
+        uint64_t firstIndex;
+        std::vector<GAny> values;
+        while (poll(firstIndex, values)) {
+        }
+    }
+
+private:
+    static size_t weight(size_t count)
+    {
+        return std::max<size_t>(count, 1);
+    }
+
+private:
+    const size_t mCapacity;
+    std::vector<std::pair<uint64_t, std::vector<GAny> > > mSlots;
+    const size_t mMask;
+    alignas(64) std::atomic<uint64_t> mProducerIndex = 0;
+    uint64_t mOfferedValues = 0; // Producer only
+    alignas(64) std::atomic<uint64_t> mConsumerIndex = 0;
+    std::atomic<uint64_t> mPolledValues = 0;
+};
+
+// Moves one rail onto its own worker through a bounded RailQueue, a run handed over by onNextBatch() costs
+// one queue publish and at most one worker task
+class RunOnRail : public RailObserver, public Disposable, public std::enable_shared_from_this<RunOnRail>
+{
+public:
+    RunOnRail(const RailObserverPtr &downstream, const WorkerPtr &worker, uint64_t capacity)
+        : mDownstream(downstream), mWorker(worker), mQueue(capacity)
+    {
+        LeakObserver::make<RunOnRail>();
+    }
+
+    ~RunOnRail() override
+    {
+        LeakObserver::release<RunOnRail>();
+    }
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        mUpstream = d;
+        mDownstream->onSubscribe(shared_from_this());
+    }
+
+    void onNext(uint64_t index, const GAny &value) override
+    {
+        onNextBatch(index, {value});
+    }
+
+    void onNextBatch(uint64_t firstIndex, std::vector<GAny> values) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        // A full queue parks the upstream thread until this rail catches up
+        while (!mQueue.offer(firstIndex, values)) {
+            if (isDisposed()) {
+                return;
+            }
+            mPark.parkWhile([this, &values] { return !mQueue.canOffer(values.size()) && !isDisposed(); });
+        }
+        drain();
+    }
+
+    // Queued as an empty run, so the skip reaches the downstream in order with the values around it
+    void onSkip(uint64_t index) override
+    {
+        onNextBatch(index, {});
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        mDone.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void onComplete() override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mDone.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void dispose() override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        // The terminal went out already and run() released everything
+        if (mTerminated.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (const auto d = mUpstream) {
+            d->dispose();
+        }
+        mPark.wake();
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        std::weak_ptr<RunOnRail> weakSelf = shared_from_this();
+        mWorker->schedule([weakSelf] {
+            if (const auto self = weakSelf.lock()) {
+                self->run();
+            }
+        });
+    }
+
+    void run()
+    {
+        uint32_t missed = 1;
+        uint64_t index;
+        std::vector<GAny> values;
+        while (true) {
+            while (true) {
+                if (isDisposed()) {
+                    clear();
+                    return;
+                }
+                const bool done = mDone.load(std::memory_order_acquire);
+                if (mQueue.poll(index, values)) {
+                    mPark.wake();
+                    if (values.empty()) {
+                        mDownstream->onSkip(index);
+                        continue;
+                    }
+                    for (const auto &value: values) {
+                        if (isDisposed()) {
+                            break;
+                        }
+                        mDownstream->onNext(index++, value);
+                    }
+                    continue;
+                }
+                if (done) {
+                    // The WIP count stays held, so a dispose() racing with the terminal cannot clear() under it
+                    mTerminated.store(true, std::memory_order_release);
+                    const auto downstream = std::move(mDownstream);
+                    mWorker->dispose();
+                    if (mError) {
+                        downstream->onError(*mError);
+                    } else {
+                        downstream->onComplete();
+                    }
+                    return;
+                }
+                break;
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    void clear()
+    {
+        mQueue.clear();
+        mDownstream = nullptr;
+        mWorker->dispose();
+    }
+
+private:
+    RailObserverPtr mDownstream;
+    WorkerPtr mWorker;
+    RailQueue mQueue;
+    DisposablePtr mUpstream;
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mTerminated = false;
+    std::atomic<bool> mDisposed = false;
+
+    ProducerPark mPark;
+};
+
+class ParallelRunOn : public ParallelObservable
+{
+public:
+    ParallelRunOn(ParallelObservablePtr source, SchedulerPtr scheduler, uint64_t capacity)
+        : mSource(std::move(source)), mScheduler(std::move(scheduler)), mCapacity(capacity)
+    {
+        LeakObserver::make<ParallelRunOn>();
+    }
+
+    ~ParallelRunOn() override
+    {
+        LeakObserver::release<ParallelRunOn>();
+    }
+
+public:
+    uint32_t parallelism() const override
+    {
+        return mSource->parallelism();
+    }
+
+    void subscribe(const std::vector<RailObserverPtr> &rails) override
+    {
+        if (!validate(rails)) {
+            return;
+        }
+        std::vector<RailObserverPtr> upstreamRails;
+        upstreamRails.reserve(rails.size());
+        for (const auto &rail: rails) {
+            upstreamRails.push_back(std::make_shared<RunOnRail>(rail, mScheduler->createWorker(), mCapacity));
+        }
+        mSource->subscribe(upstreamRails);
+    }
+
+    bool runsOnWorkers() const override
+    {
+        return true;
+    }
+
+private:
+    ParallelObservablePtr mSource;
+    SchedulerPtr mScheduler;
+    uint64_t mCapacity;
+};
+} // rx
+
+#endif //RX_PARALLEL_RUN_ON_H
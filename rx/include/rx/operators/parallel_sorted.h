@@ -0,0 +1,174 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_SORTED_H
+#define RX_PARALLEL_SORTED_H
+
+#include "parallel_merge.h"
+#include "../exception_helper.h"
+
+#include <algorithm>
+#include <memory>
+
+
+namespace rx
+{
+// Every rail collects and sorts its values on its own thread when it completes, the rail that finishes last
+// merges the sorted rails.
+class ParallelSortedState : public ParallelMergeState
+{
+public:
+    ParallelSortedState(const ObserverPtr &downstream, size_t rails, const ComparatorFunction &comparator)
+        : ParallelMergeState(rails),
+          mDownstream(downstream),
+          mComparator(comparator),
+          mSlots(std::make_unique<Slot[]>(rails)),
+          mRemaining(rails)
+    {
+        LeakObserver::make<ParallelSortedState>();
+    }
+
+    ~ParallelSortedState() override
+    {
+        LeakObserver::release<ParallelSortedState>();
+    }
+
+public:
+    void railNext(size_t rail, uint64_t, const GAny &value) override
+    {
+        if (!isDone()) {
+            mSlots[rail].values.push_back(value);
+        }
+    }
+
+    void railError(size_t, const GAnyException &e) override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        cancelUpstreams();
+        const auto downstream = std::move(mDownstream);
+        downstream->onError(e);
+    }
+
+    void railComplete(size_t rail) override
+    {
+        if (isDone()) {
+            return;
+        }
+        try {
+            std::stable_sort(mSlots[rail].values.begin(), mSlots[rail].values.end(),
+                             [this](const GAny &a, const GAny &b) {
+                                 return less(a, b);
+                             });
+        } catch (...) {
+            railError(rail, ExceptionHelper::fromCurrentException("ParallelSorted: Comparator failed"));
+            return;
+        }
+        if (mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            merge();
+        }
+    }
+
+    void dispose() override
+    {
+        mDisposeRequested.store(true, std::memory_order_release);
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        cancelUpstreams();
+        mDownstream = nullptr;
+    }
+
+private:
+    // Sorted values of one rail, walked by the final merge
+    struct alignas(64) Slot
+    {
+        std::vector<GAny> values;
+        size_t position = 0; // Read position of the final merge
+    };
+
+    bool less(const GAny &a, const GAny &b) const
+    {
+        if (mComparator) {
+            return mComparator(a, b);
+        }
+        return a < b;
+    }
+
+    // Linear scan for the smallest head, rails are few so a heap would not pay off
+    void merge()
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const auto downstream = std::move(mDownstream);
+        try {
+            while (true) {
+                Slot *next = nullptr;
+                for (size_t i = 0; i < railCount(); ++i) {
+                    auto &slot = mSlots[i];
+                    if (slot.position == slot.values.size()) {
+                        continue;
+                    }
+                    // Ties go to the lower rail
+                    if (!next || less(slot.values[slot.position], next->values[next->position])) {
+                        next = &slot;
+                    }
+                }
+                if (!next) {
+                    break;
+                }
+                // A downstream that disposed part way through gets neither the rest nor the completion
+                if (isDisposed()) {
+                    return;
+                }
+                downstream->onNext(next->values[next->position++]);
+            }
+        } catch (...) {
+            downstream->onError(ExceptionHelper::fromCurrentException("ParallelSorted: Comparator failed"));
+            return;
+        }
+        if (!isDisposed()) {
+            downstream->onComplete();
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    ComparatorFunction mComparator;
+    std::unique_ptr<Slot[]> mSlots;
+    std::atomic<size_t> mRemaining;
+};
+
+class ParallelSorted : public Observable
+{
+public:
+    ParallelSorted(ParallelObservablePtr source, ComparatorFunction comparator)
+        : mSource(std::move(source)), mComparator(std::move(comparator))
+    {
+        LeakObserver::make<ParallelSorted>();
+    }
+
+    ~ParallelSorted() override
+    {
+        LeakObserver::release<ParallelSorted>();
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const size_t rails = mSource->parallelism();
+        const auto state = std::make_shared<ParallelSortedState>(observer, rails, mComparator);
+        observer->onSubscribe(state);
+        mSource->subscribe(ParallelMergeRail<ParallelSortedState>::create(state, rails));
+    }
+
+private:
+    ParallelObservablePtr mSource;
+    ComparatorFunction mComparator;
+};
+} // rx
+
+#endif //RX_PARALLEL_SORTED_H
@@ -0,0 +1,94 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_SCHEDULED_EMISSION_H
+#define RX_SCHEDULED_EMISSION_H
+
+#include "../observable.h"
+#include "../scheduler.h"
+#include "../sized_source.h"
+#include "../leak_observer.h"
+
+#include <algorithm>
+
+
+namespace rx
+{
+// Scheduled form of range() and fromArray(): emits the source's items chunkSize at a time on a worker and
+// reschedules itself between chunks, so a long source takes turns with other tasks on the same thread.
+// Cancellation is checked for every item, the source is held until the walk ends.
+class ScheduledEmissionDisposable : public Disposable, public std::enable_shared_from_this<ScheduledEmissionDisposable>
+{
+public:
+    explicit ScheduledEmissionDisposable(const ObserverPtr &observer, std::shared_ptr<const SizedSource> items,
+                                         WorkerPtr worker, uint64_t chunkSize)
+        : mDownstream(observer), mItems(std::move(items)), mCount(mItems->itemCount()), mWorker(std::move(worker)),
+          mChunkSize(chunkSize)
+    {
+        LeakObserver::make<ScheduledEmissionDisposable>();
+    }
+
+    ~ScheduledEmissionDisposable() override
+    {
+        LeakObserver::release<ScheduledEmissionDisposable>();
+    }
+
+public:
+    void start()
+    {
+        const auto self = shared_from_this();
+        mWorker->schedule([self] { self->runChunk(); });
+    }
+
+    void dispose() override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        mWorker->dispose();
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    void runChunk()
+    {
+        const auto o = mDownstream;
+        if (!o) {
+            return;
+        }
+        const uint64_t end = std::min(mCount, mEmitted + mChunkSize);
+        for (; mEmitted < end && !isDisposed(); ++mEmitted) {
+            o->onNext(mItems->itemAt(mEmitted));
+        }
+        if (isDisposed()) {
+            mDownstream = nullptr;
+            mItems = nullptr;
+            return;
+        }
+        if (mEmitted < mCount) {
+            start();
+            return;
+        }
+        mDownstream = nullptr;
+        mItems = nullptr;
+        o->onComplete();
+        mWorker->dispose();
+    }
+
+private:
+    ObserverPtr mDownstream; // Only touched from the worker, like mItems
+    std::shared_ptr<const SizedSource> mItems;
+    uint64_t mCount;
+    uint64_t mEmitted = 0;
+    WorkerPtr mWorker;
+    uint64_t mChunkSize;
+    std::atomic<bool> mDisposed = false;
+};
+} // rx
+
+#endif //RX_SCHEDULED_EMISSION_H
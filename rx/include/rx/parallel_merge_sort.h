@@ -0,0 +1,214 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_MERGE_SORT_H
+#define RX_PARALLEL_MERGE_SORT_H
+
+#include "scheduler.h"
+#include "exception_helper.h"
+#include "leak_observer.h"
+
+#include <gx/gmutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace rx
+{
+// Stable merge sort spread over the workers of a scheduler: the data is cut into one run per worker, every run
+// is sorted on its own worker, then neighbouring runs are merged pairwise, one level at a time, with the merges
+// of a level running in parallel. The task that finishes a level starts the next one, the last level hands
+// the sorted data to the callback on its worker. Disposing drops the callback, running tasks stop early.
+template<typename T, typename Less>
+class ParallelMergeSort : public Disposable, public std::enable_shared_from_this<ParallelMergeSort<T, Less> >
+{
+public:
+    using Callback = std::function<void(std::vector<T> &sorted, const GAnyException *error)>;
+
+    // Inputs below this many elements per worker are not worth splitting
+    static constexpr size_t MinRunSize = 4096;
+
+    ParallelMergeSort(std::vector<T> data, Less less, const SchedulerPtr &scheduler, uint32_t runs, Callback callback,
+                      const char *errorMessage)
+        : mData(std::move(data)),
+          mScratch(mData.size()),
+          mLess(std::move(less)),
+          mCallback(std::move(callback)),
+          mErrorMessage(errorMessage)
+    {
+        LeakObserver::make<ParallelMergeSort>();
+        mBounds.reserve(runs + 1);
+        for (uint32_t i = 0; i <= runs; ++i) {
+            mBounds.push_back(mData.size() * i / runs);
+        }
+        mWorkers.reserve(runs);
+        for (uint32_t i = 0; i < runs; ++i) {
+            mWorkers.push_back(scheduler->createWorker());
+        }
+    }
+
+    ~ParallelMergeSort() override
+    {
+        LeakObserver::release<ParallelMergeSort>();
+    }
+
+    // How many runs to split size elements into, below 2 the caller should sort inline
+    static uint32_t runsFor(size_t size)
+    {
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<uint32_t>(std::min(cores, size / MinRunSize));
+    }
+
+public:
+    void start()
+    {
+        const size_t runs = mBounds.size() - 1;
+        mRemaining.store(runs, std::memory_order_relaxed);
+        const auto self = this->shared_from_this();
+        for (size_t i = 0; i < runs; ++i) {
+            mWorkers[i]->schedule([self, i] { self->sortRun(i); });
+        }
+    }
+
+    void dispose() override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        {
+            GLockerGuard lock(mLock);
+            mCallback = nullptr;
+        }
+        for (const auto &worker: mWorkers) {
+            worker->dispose();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    bool stopped() const
+    {
+        return isDisposed() || mFailed.load(std::memory_order_acquire);
+    }
+
+    void sortRun(size_t run)
+    {
+        if (!stopped()) {
+            try {
+                std::stable_sort(mData.begin() + mBounds[run], mData.begin() + mBounds[run + 1], mLess);
+            } catch (...) {
+                fail();
+            }
+        }
+        taskDone();
+    }
+
+    // Merges runs 2 * pair and 2 * pair + 1 into mScratch, a lone last run is moved over as is
+    void mergePair(size_t pair)
+    {
+        if (!stopped()) {
+            const auto begin = mData.begin() + mBounds[2 * pair];
+            const auto middle = mData.begin() + mBounds[std::min(2 * pair + 1, mBounds.size() - 1)];
+            const auto end = mData.begin() + mBounds[std::min(2 * pair + 2, mBounds.size() - 1)];
+            try {
+                std::merge(std::make_move_iterator(begin), std::make_move_iterator(middle),
+                           std::make_move_iterator(middle), std::make_move_iterator(end),
+                           mScratch.begin() + mBounds[2 * pair], mLess);
+            } catch (...) {
+                fail();
+            }
+        }
+        taskDone();
+    }
+
+    void taskDone()
+    {
+        if (mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            nextLevel();
+        }
+    }
+
+    // Runs on the task that finished the previous level, the acq_rel countdown makes its writes visible
+    void nextLevel()
+    {
+        if (mMerging) {
+            mData.swap(mScratch);
+            std::vector<size_t> bounds;
+            for (size_t i = 0; i < mBounds.size(); i += 2) {
+                bounds.push_back(mBounds[i]);
+            }
+            if (bounds.back() != mData.size()) {
+                bounds.push_back(mData.size());
+            }
+            mBounds.swap(bounds);
+        }
+        const size_t runs = mBounds.size() - 1;
+        if (runs <= 1 || stopped()) {
+            finish();
+            return;
+        }
+        mMerging = true;
+        const size_t pairs = (runs + 1) / 2;
+        mRemaining.store(pairs, std::memory_order_relaxed);
+        const auto self = this->shared_from_this();
+        for (size_t i = 0; i < pairs; ++i) {
+            mWorkers[i % mWorkers.size()]->schedule([self, i] { self->mergePair(i); });
+        }
+    }
+
+    void fail()
+    {
+        GLockerGuard lock(mLock);
+        if (!mError) {
+            mError = std::make_unique<GAnyException>(ExceptionHelper::fromCurrentException(mErrorMessage));
+        }
+        mFailed.store(true, std::memory_order_release);
+    }
+
+    void finish()
+    {
+        Callback callback;
+        {
+            GLockerGuard lock(mLock);
+            callback = std::move(mCallback);
+            mCallback = nullptr;
+        }
+        for (const auto &worker: mWorkers) {
+            worker->dispose();
+        }
+        if (callback) {
+            callback(mData, mError.get());
+        }
+    }
+
+private:
+    std::vector<T> mData;
+    std::vector<T> mScratch;
+    std::vector<size_t> mBounds; // Run i is [mBounds[i], mBounds[i + 1])
+    Less mLess;
+    std::vector<WorkerPtr> mWorkers;
+    bool mMerging = false; // Only touched by the task that finishes a level
+
+    GMutex mLock;
+    Callback mCallback;
+    std::unique_ptr<GAnyException> mError;
+    const char *mErrorMessage;
+
+    std::atomic<size_t> mRemaining = 0;
+    std::atomic<bool> mFailed = false;
+    std::atomic<bool> mDisposed = false;
+};
+} // rx
+
+#endif //RX_PARALLEL_MERGE_SORT_H
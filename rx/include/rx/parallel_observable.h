@@ -0,0 +1,107 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PARALLEL_OBSERVABLE_H
+#define RX_PARALLEL_OBSERVABLE_H
+
+#include "observable.h"
+
+#include <vector>
+
+
+namespace rx
+{
+// Consumer of one rail of a ParallelObservable.
+// Every value carries its position in the source stream, which is how sequentialOrdered() restores the order.
+class RailObserver
+{
+public:
+    virtual ~RailObserver() = default;
+
+public:
+    virtual void onSubscribe(const DisposablePtr &d) = 0;
+
+    virtual void onNext(uint64_t index, const GAny &value) = 0;
+
+    // A run of values whose indices count up from firstIndex, rails that hand values over to another thread
+    // override it to publish the whole run at once
+    virtual void onNextBatch(uint64_t firstIndex, std::vector<GAny> values)
+    {
+        for (const auto &value: values) {
+            onNext(firstIndex++, value);
+        }
+    }
+
+    // The value at index left the rail without reaching this observer, a filter dropped it. Indices of a rail
+    // only grow, so sequentialOrdered() stops waiting for this rail to produce anything before index
+    virtual void onSkip(uint64_t /*index*/)
+    {
+    }
+
+    virtual void onError(const GAnyException &e) = 0;
+
+    virtual void onComplete() = 0;
+};
+
+using RailObserverPtr = std::shared_ptr<RailObserver>;
+
+// A stream split over a fixed number of rails, created by Observable::parallel().
+// Rails run on the upstream thread until runOn() moves each of them onto its own worker; map and filter
+// then run per rail, and sequential()/sequentialOrdered()/reduce()/sorted() merge the rails back.
+class GX_API ParallelObservable : public std::enable_shared_from_this<ParallelObservable>
+{
+public:
+    virtual ~ParallelObservable() = default;
+
+public:
+    virtual uint32_t parallelism() const = 0;
+
+    // Subscribes one observer per rail, rails.size() must equal parallelism()
+    virtual void subscribe(const std::vector<RailObserverPtr> &rails) = 0;
+
+    // True once runOn() moved every rail onto a worker of its own, a merge may then park one rail while it
+    // waits for another
+    virtual bool runsOnWorkers() const
+    {
+        return false;
+    }
+
+    // Each rail gets a worker from scheduler and a bounded queue of capacity values, a full queue parks the
+    // upstream thread until that rail catches up. The workers must not run on the thread that emits the
+    // upstream, a parked upstream would then wait on itself forever. Defaults to a NewThreadScheduler, one
+    // thread per rail
+    std::shared_ptr<ParallelObservable> runOn(SchedulerPtr scheduler, uint64_t capacity = 128);
+
+    std::shared_ptr<ParallelObservable> map(const MapFunction &function);
+
+    std::shared_ptr<ParallelObservable> filter(const FilterFunction &filter);
+
+    // Reduces every rail on its own thread, then the rail results in rail order
+    std::shared_ptr<Observable> reduce(const BiFunction &accumulator);
+
+    // Sorts every rail on its own thread and merges the sorted rails, comparator(a, b) returns true when a goes
+    // before b and defaults to operator<
+    std::shared_ptr<Observable> sorted(const ComparatorFunction &comparator = nullptr);
+
+    // Merges the rails in whatever order their values arrive. Each rail queues at most capacity values that
+    // the downstream has not taken yet, a rail that runs on its own worker is parked once its queue is full.
+    // Rails still on the upstream thread are never parked, the drain runs on that thread and empties their
+    // queues before the next value comes
+    std::shared_ptr<Observable> sequential(uint64_t capacity = 128);
+
+    // Merges the rails back into the order the values had in the source. Each rail queues at most capacity
+    // values that wait for an earlier index on another rail; a rail that runs on its own worker is parked once
+    // its queue is full. Rails still on the upstream thread are never parked, since the rail they wait for can
+    // only be fed by that same thread, their queues are instead bounded by the batch size of parallel()
+    std::shared_ptr<Observable> sequentialOrdered(uint64_t capacity = 128);
+
+protected:
+    // Checks the rail count handed to subscribe()
+    bool validate(const std::vector<RailObserverPtr> &rails) const;
+};
+
+using ParallelObservablePtr = std::shared_ptr<ParallelObservable>;
+} // rx
+
+#endif //RX_PARALLEL_OBSERVABLE_H
@@ -0,0 +1,55 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PRODUCER_PARK_H
+#define RX_PRODUCER_PARK_H
+
+#include <gx/gmutex.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+
+
+namespace rx
+{
+// Where a producer thread waits while the queue or ring it feeds is full. The producer calls parkWhile() in its
+// retry loop, the consumer calls wake() after it freed room.
+// Both sides put a seq_cst fence between their own write (the parked count, the consumer's progress) and the
+// read of the other side's, so either the consumer sees the producer parked or the producer sees the room.
+// The 1ms timeout only covers stop conditions, such as a dispose(), that are raised without calling wake().
+class ProducerPark
+{
+public:
+    // Waits once, for a wake() or the timeout, unless blocked() is already false after registering
+    template<typename Blocked>
+    void parkWhile(const Blocked &blocked)
+    {
+        GLocker lock(mLock);
+        mParked.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (blocked()) {
+            mCv.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        mParked.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void wake()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mParked.load(std::memory_order_relaxed) > 0) {
+            GLockerGuard lock(mLock);
+            mCv.notify_all();
+        }
+    }
+
+private:
+    GMutex mLock;
+    std::condition_variable mCv;
+    std::atomic<uint32_t> mParked = 0;
+};
+} // rx
+
+#endif //RX_PRODUCER_PARK_H
@@ -0,0 +1,250 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_REPLAY_BUFFER_H
+#define RX_REPLAY_BUFFER_H
+
+#include "scheduler.h"
+
+#include <gx/gany.h>
+#include <gx/gmutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+namespace rx
+{
+// Values kept for replaying observers, stored in a linked list of fixed-size segments.
+// A single producer appends (add/complete/error are not called concurrently), readers walk the list with
+// their own Cursor and never copy or lock per value. Size and age bounds only move the head forward,
+// a segment is freed once the head and every reader cursor have left it. Whoever drops a segment goes
+// through release(), which unlinks the chain behind it in a loop instead of through nested destructors.
+class ReplayBuffer
+{
+public:
+    struct Segment
+    {
+        Segment(size_t capacity, bool timed)
+            : values(capacity)
+        {
+            if (timed) {
+                times.resize(capacity);
+            }
+        }
+
+        std::vector<GAny> values;
+        std::vector<uint64_t> times; // Only for age-bounded buffers
+        std::atomic<size_t> count = 0;
+        std::atomic<std::shared_ptr<Segment> > next;
+    };
+
+    struct Cursor
+    {
+        std::shared_ptr<Segment> segment;
+        size_t offset = 0;
+    };
+
+    // Small size bounds still fill a segment of this many values before allocating the next one
+    static constexpr size_t MinSegmentSize = 16;
+
+    // maxSize == 0 and maxAge == 0 keep everything, maxAge is in milliseconds and read from clock
+    explicit ReplayBuffer(size_t maxSize = 0, uint64_t maxAge = 0, SchedulerPtr clock = nullptr,
+                          size_t segmentSize = 64)
+        : mMaxSize(maxSize),
+          mMaxAge(maxAge),
+          mClock(std::move(clock)),
+          mSegmentSize(maxSize > 0 ? std::clamp(maxSize, std::min(MinSegmentSize, segmentSize), segmentSize)
+                                   : segmentSize),
+          mTail(std::make_shared<Segment>(mSegmentSize, mMaxAge > 0)),
+          mHead{mTail, 0}
+    {
+    }
+
+    ~ReplayBuffer()
+    {
+        mTail = nullptr;
+        release(mHead.segment);
+    }
+
+public:
+    void add(const GAny &value)
+    {
+        size_t index = mTail->count.load(std::memory_order_relaxed);
+        if (index == mSegmentSize) {
+            auto segment = std::make_shared<Segment>(mSegmentSize, mMaxAge > 0);
+            mTail->next.store(segment, std::memory_order_release);
+            mTail = std::move(segment);
+            index = 0;
+        }
+        mTail->values[index] = value;
+        if (mMaxAge > 0) {
+            mTail->times[index] = now();
+        }
+        mTail->count.store(index + 1, std::memory_order_release);
+        ++mSize;
+        trim();
+    }
+
+    void complete()
+    {
+        mDone.store(true, std::memory_order_release);
+    }
+
+    void error(const GAnyException &e)
+    {
+        mError = std::make_unique<GAnyException>(e);
+        mDone.store(true, std::memory_order_release);
+    }
+
+    bool isDone() const
+    {
+        return mDone.load(std::memory_order_acquire);
+    }
+
+    // Valid once isDone() returned true
+    const std::unique_ptr<GAnyException> &getError() const
+    {
+        return mError;
+    }
+
+    // Cursor at the oldest value a new observer should see, stale values of an age-bounded buffer are skipped
+    Cursor head() const
+    {
+        Cursor cursor;
+        {
+            GLockerGuard lock(mHeadLock);
+            cursor = mHead;
+        }
+        if (mMaxAge > 0) {
+            const uint64_t limit = cutoff();
+            while (normalize(cursor) && cursor.offset < cursor.segment->count.load(std::memory_order_acquire)
+                   && cursor.segment->times[cursor.offset] < limit) {
+                ++cursor.offset;
+            }
+        }
+        return cursor;
+    }
+
+    // Reads the next value visible to the cursor, returns false when the reader caught up with the producer
+    bool read(Cursor &cursor, GAny &value) const
+    {
+        if (!normalize(cursor) || cursor.offset >= cursor.segment->count.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = cursor.segment->values[cursor.offset++];
+        return true;
+    }
+
+    // Drops a reference to segment and unlinks every following segment nothing else refers to, a long
+    // trimmed chain would otherwise be freed by one nested destructor per segment
+    static void release(std::shared_ptr<Segment> &segment)
+    {
+        auto current = std::move(segment);
+        segment = nullptr;
+        // Held only here, so no reader can reach it any more and its link can be taken
+        while (current && current.use_count() == 1) {
+            current = current->next.exchange(nullptr, std::memory_order_acq_rel);
+        }
+    }
+
+    // Current contents, only meant for inspection
+    std::vector<GAny> snapshot() const
+    {
+        std::vector<GAny> values;
+        Cursor cursor = head();
+        GAny value;
+        while (read(cursor, value)) {
+            values.push_back(std::move(value));
+        }
+        return values;
+    }
+
+private:
+    // Moves a cursor sitting at the end of a full segment onto the next one, if any
+    static bool normalize(Cursor &cursor)
+    {
+        while (cursor.offset == cursor.segment->values.size()) {
+            auto next = cursor.segment->next.load(std::memory_order_acquire);
+            if (!next) {
+                return false;
+            }
+            cursor.segment = std::move(next);
+            cursor.offset = 0;
+        }
+        return true;
+    }
+
+    uint64_t now() const
+    {
+        return mClock ? mClock->now() / 1000000 : 0;
+    }
+
+    uint64_t cutoff() const
+    {
+        const uint64_t time = now();
+        return time > mMaxAge ? time - mMaxAge : 0;
+    }
+
+    void trim()
+    {
+        size_t drop = 0;
+        if (mMaxSize > 0 && mSize > mMaxSize) {
+            drop = mSize - mMaxSize;
+        }
+        Cursor head;
+        {
+            GLockerGuard lock(mHeadLock);
+            head = mHead;
+        }
+        if (mMaxAge > 0) {
+            // Values are appended in time order, so only the oldest ones can have expired
+            const uint64_t limit = cutoff();
+            Cursor cursor = head;
+            for (size_t i = 0; i < drop; ++i) {
+                normalize(cursor);
+                ++cursor.offset;
+            }
+            while (drop < mSize && normalize(cursor) && cursor.segment->times[cursor.offset] < limit) {
+                ++cursor.offset;
+                ++drop;
+            }
+        }
+        if (drop == 0) {
+            return;
+        }
+        // Slots are not cleared, a reader that started before the trim may still be on them
+        for (size_t i = 0; i < drop; ++i) {
+            normalize(head);
+            ++head.offset;
+        }
+        mSize -= drop;
+        {
+            GLockerGuard lock(mHeadLock);
+            std::swap(mHead, head);
+        }
+        // head now holds the old head segment, released outside the lock
+        release(head.segment);
+    }
+
+private:
+    const size_t mMaxSize;
+    const uint64_t mMaxAge;
+    const SchedulerPtr mClock;
+    const size_t mSegmentSize;
+
+    // Producer side
+    std::shared_ptr<Segment> mTail;
+    size_t mSize = 0;
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+
+    mutable GMutex mHeadLock;
+    Cursor mHead;
+};
+} // rx
+
+#endif //RX_REPLAY_BUFFER_H
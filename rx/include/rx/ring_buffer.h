@@ -0,0 +1,107 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_RING_BUFFER_H
+#define RX_RING_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace rx
+{
+// Single-threaded circular buffer holding at most capacity elements.
+// Storage starts at min(capacity, initialCapacity) slots and doubles until it reaches capacity,
+// after that push/pop never touch the allocator again.
+template<typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(size_t capacity, size_t initialCapacity = 64)
+        : mCapacity(capacity)
+    {
+        mSlots.resize(std::min(capacity, initialCapacity));
+    }
+
+public:
+    size_t size() const
+    {
+        return mSize;
+    }
+
+    size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+    bool empty() const
+    {
+        return mSize == 0;
+    }
+
+    bool full() const
+    {
+        return mSize == mCapacity;
+    }
+
+    // Caller makes room with pop_front() first when full()
+    void push_back(T value)
+    {
+        if (mSize == mSlots.size()) {
+            grow();
+        }
+        mSlots[(mHead + mSize) % mSlots.size()] = std::move(value);
+        ++mSize;
+    }
+
+    T pop_front()
+    {
+        T value = std::move(mSlots[mHead]);
+        mSlots[mHead] = T();
+        mHead = (mHead + 1) % mSlots.size();
+        --mSize;
+        return value;
+    }
+
+    T &front()
+    {
+        return mSlots[mHead];
+    }
+
+    T &operator[](size_t index)
+    {
+        return mSlots[(mHead + index) % mSlots.size()];
+    }
+
+    void clear()
+    {
+        while (mSize > 0) {
+            pop_front();
+        }
+        mHead = 0;
+    }
+
+private:
+    void grow()
+    {
+        const size_t size = std::min(mCapacity, std::max<size_t>(1, mSlots.size() * 2));
+        std::vector<T> slots(size);
+        for (size_t i = 0; i < mSize; ++i) {
+            slots[i] = std::move((*this)[i]);
+        }
+        mSlots = std::move(slots);
+        mHead = 0;
+    }
+
+private:
+    std::vector<T> mSlots;
+    size_t mCapacity;
+    size_t mHead = 0;
+    size_t mSize = 0;
+};
+} // rx
+
+#endif //RX_RING_BUFFER_H
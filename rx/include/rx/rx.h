@@ -7,6 +7,16 @@
 
 #include "observer.h"
 #include "observable.h"
+#include "connectable_observable.h"
+#include "parallel_observable.h"
+#include "array_view.h"
+#include "spill_codec.h"
+
+#include "subjects/publish_subject.h"
+#include "subjects/behavior_subject.h"
+#include "subjects/replay_subject.h"
+#include "subjects/async_subject.h"
+#include "subjects/unicast_subject.h"
 
 #include "schedulers/task_system_scheduler.h"
 #include "schedulers/job_system_scheduler.h"
@@ -29,7 +29,7 @@ public:
 
     virtual DisposablePtr schedule(const WorkerRunnable &run, uint64_t delay) = 0;
 
-    uint64_t now() const
+    virtual uint64_t now() const
     {
         return GTime::currentSteadyTime().nanosecond();
     }
@@ -113,6 +113,12 @@ public:
     }
 
     virtual WorkerPtr createWorker() = 0;
+
+    // Same clock as the workers of this scheduler, in nanoseconds
+    virtual uint64_t now() const
+    {
+        return GTime::currentSteadyTime().nanosecond();
+    }
 };
 
 using SchedulerPtr = std::shared_ptr<Scheduler>;
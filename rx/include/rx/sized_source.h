@@ -0,0 +1,29 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_SIZED_SOURCE_H
+#define RX_SIZED_SOURCE_H
+
+#include <gx/gany.h>
+
+#include <cstdint>
+
+
+namespace rx
+{
+// Implemented by sources whose items are known up front and can be read by index from any thread,
+// so operators such as reduceParallel() can split them instead of subscribing
+class SizedSource
+{
+public:
+    virtual ~SizedSource() = default;
+
+public:
+    virtual uint64_t itemCount() const = 0;
+
+    virtual GAny itemAt(uint64_t index) const = 0;
+};
+} // rx
+
+#endif //RX_SIZED_SOURCE_H
@@ -0,0 +1,175 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_SPILL_CODEC_H
+#define RX_SPILL_CODEC_H
+
+#include <gx/gany.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace rx
+{
+// Turns values into bytes and back for operators that spill to disk, such as sortedExternal().
+// Records are framed by the caller, so decode() always receives exactly what one encode() call appended
+class SpillCodec
+{
+public:
+    virtual ~SpillCodec() = default;
+
+public:
+    // Appends the encoding of value to out, throws for values the codec cannot represent
+    virtual void encode(const GAny &value, std::string &out) const = 0;
+
+    virtual GAny decode(std::string_view record) const = 0;
+};
+
+using SpillCodecPtr = std::shared_ptr<SpillCodec>;
+
+// Compact tagged encoding of plain values: undefined, null, booleans, integers as zigzag varints, doubles,
+// strings and arrays of these. User objects cannot be spilled with it and need a codec of their own
+class BinarySpillCodec : public SpillCodec
+{
+public:
+    void encode(const GAny &value, std::string &out) const override
+    {
+        if (value.isUndefined()) {
+            out.push_back(TagUndefined);
+        } else if (value.isNull()) {
+            out.push_back(TagNull);
+        } else if (value.isBoolean()) {
+            out.push_back(value.toBool() ? TagTrue : TagFalse);
+        } else if (value.is<double>() || value.is<float>()) {
+            const double d = value.toDouble();
+            char bytes[sizeof(double)];
+            std::memcpy(bytes, &d, sizeof(double));
+            out.push_back(TagDouble);
+            out.append(bytes, sizeof(double));
+        } else if (value.isNumber()) {
+            const int64_t i = value.toInt64();
+            out.push_back(TagInt);
+            writeVarint((static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63), out);
+        } else if (value.isString()) {
+            const std::string s = value.toString();
+            out.push_back(TagString);
+            writeVarint(s.size(), out);
+            out.append(s);
+        } else if (value.isArray()) {
+            const auto items = value.castAs<std::vector<GAny> >();
+            out.push_back(TagArray);
+            writeVarint(items.size(), out);
+            for (const auto &item: items) {
+                encode(item, out);
+            }
+        } else {
+            throw GAnyException("BinarySpillCodec cannot encode " + value.typeInfo().getDemangleName());
+        }
+    }
+
+    GAny decode(std::string_view record) const override
+    {
+        const char *cursor = record.data();
+        return decodeValue(cursor, record.data() + record.size());
+    }
+
+public:
+    static void writeVarint(uint64_t v, std::string &out)
+    {
+        while (v >= 0x80) {
+            out.push_back(static_cast<char>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    static uint64_t readVarint(const char *&cursor, const char *end)
+    {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (cursor == end) {
+                break;
+            }
+            const auto byte = static_cast<uint8_t>(*cursor++);
+            v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return v;
+            }
+        }
+        throw GAnyException("BinarySpillCodec: Truncated varint");
+    }
+
+private:
+    enum Tag : char
+    {
+        TagUndefined = 0,
+        TagNull,
+        TagFalse,
+        TagTrue,
+        TagInt,
+        TagDouble,
+        TagString,
+        TagArray,
+    };
+
+    static void require(const char *cursor, const char *end, uint64_t size)
+    {
+        if (static_cast<uint64_t>(end - cursor) < size) {
+            throw GAnyException("BinarySpillCodec: Truncated record");
+        }
+    }
+
+    GAny decodeValue(const char *&cursor, const char *end) const
+    {
+        require(cursor, end, 1);
+        switch (*cursor++) {
+            case TagUndefined:
+                return GAny();
+            case TagNull:
+                return GAny(nullptr);
+            case TagFalse:
+                return false;
+            case TagTrue:
+                return true;
+            case TagInt: {
+                const uint64_t v = readVarint(cursor, end);
+                return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+            }
+            case TagDouble: {
+                require(cursor, end, sizeof(double));
+                double d;
+                std::memcpy(&d, cursor, sizeof(double));
+                cursor += sizeof(double);
+                return d;
+            }
+            case TagString: {
+                const uint64_t size = readVarint(cursor, end);
+                require(cursor, end, size);
+                std::string s(cursor, size);
+                cursor += size;
+                return s;
+            }
+            case TagArray: {
+                const uint64_t count = readVarint(cursor, end);
+                std::vector<GAny> items;
+                items.reserve(std::min<uint64_t>(count, static_cast<uint64_t>(end - cursor)));
+                for (uint64_t i = 0; i < count; ++i) {
+                    items.push_back(decodeValue(cursor, end));
+                }
+                return items;
+            }
+            default:
+                throw GAnyException("BinarySpillCodec: Unknown tag");
+        }
+    }
+};
+} // rx
+
+#endif //RX_SPILL_CODEC_H
@@ -0,0 +1,162 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_SPSC_QUEUE_H
+#define RX_SPSC_QUEUE_H
+
+#include <gx/gany.h>
+
+#include <atomic>
+#include <vector>
+
+
+namespace rx
+{
+// Single-producer single-consumer queue of GAny.
+// With a capacity it is a fixed power-of-two ring and offer() fails when full,
+// with capacity 0 it grows by linking fixed-size chunks and offer() always succeeds.
+// offer() may only be called by one producer thread at a time, poll()/peek()/clear() by one consumer.
+class SpscQueue
+{
+private:
+    struct Chunk
+    {
+        explicit Chunk(size_t size)
+            : slots(size)
+        {
+        }
+
+        std::vector<GAny> slots;
+        std::atomic<Chunk *> next = nullptr;
+    };
+
+public:
+    explicit SpscQueue(size_t capacity = 0, size_t chunkSize = 128)
+        : mCapacity(capacity)
+    {
+        size_t size = chunkSize;
+        if (mCapacity > 0) {
+            size = 1;
+            while (size < mCapacity) {
+                size <<= 1;
+            }
+        }
+        mMask = size - 1;
+        mProducerChunk = mConsumerChunk = new Chunk(size);
+    }
+
+    ~SpscQueue()
+    {
+        Chunk *chunk = mConsumerChunk;
+        while (chunk) {
+            Chunk *next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+public:
+    bool offer(const GAny &value)
+    {
+        const uint64_t p = mProducerIndex.load(std::memory_order_relaxed);
+        if (mCapacity > 0) {
+            if (p - mConsumerIndex.load(std::memory_order_acquire) >= mCapacity) {
+                return false;
+            }
+            mProducerChunk->slots[p & mMask] = value;
+        } else {
+            if (mProducerOffset == mProducerChunk->slots.size()) {
+                auto *chunk = new Chunk(mProducerChunk->slots.size());
+                mProducerChunk->next.store(chunk, std::memory_order_release);
+                mProducerChunk = chunk;
+                mProducerOffset = 0;
+            }
+            mProducerChunk->slots[mProducerOffset++] = value;
+        }
+        mProducerIndex.store(p + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool poll(GAny &out)
+    {
+        GAny *slot = consumerSlot();
+        if (!slot) {
+            return false;
+        }
+        out = std::move(*slot);
+        *slot = GAny();
+        if (mCapacity == 0) {
+            ++mConsumerOffset;
+        }
+        mConsumerIndex.store(mConsumerIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    const GAny *peek()
+    {
+        return consumerSlot();
+    }
+
+    bool isEmpty() const
+    {
+        return mConsumerIndex.load(std::memory_order_acquire) == mProducerIndex.load(std::memory_order_acquire);
+    }
+
+    size_t size() const
+    {
+        const uint64_t c = mConsumerIndex.load(std::memory_order_acquire);
+        return static_cast<size_t>(mProducerIndex.load(std::memory_order_acquire) - c);
+    }
+
+    size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+    void clear()
+    {
+        GAny value;
+        while (poll(value)) {
+        }
+    }
+
+private:
+    // Slot of the next element for the consumer, stepping into the next chunk when needed
+    GAny *consumerSlot()
+    {
+        const uint64_t c = mConsumerIndex.load(std::memory_order_relaxed);
+        if (c == mProducerIndex.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        if (mCapacity > 0) {
+            return &mConsumerChunk->slots[c & mMask];
+        }
+        if (mConsumerOffset == mConsumerChunk->slots.size()) {
+            Chunk *next = mConsumerChunk->next.load(std::memory_order_acquire);
+            delete mConsumerChunk;
+            mConsumerChunk = next;
+            mConsumerOffset = 0;
+        }
+        return &mConsumerChunk->slots[mConsumerOffset];
+    }
+
+private:
+    size_t mCapacity;
+    size_t mMask = 0;
+
+    alignas(64) std::atomic<uint64_t> mProducerIndex = 0;
+    Chunk *mProducerChunk;
+    size_t mProducerOffset = 0;
+
+    alignas(64) std::atomic<uint64_t> mConsumerIndex = 0;
+    Chunk *mConsumerChunk;
+    size_t mConsumerOffset = 0;
+};
+} // rx
+
+#endif //RX_SPSC_QUEUE_H
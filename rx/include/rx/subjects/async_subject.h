@@ -0,0 +1,139 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_ASYNC_SUBJECT_H
+#define RX_ASYNC_SUBJECT_H
+
+#include "subject.h"
+#include "../subscriber_array.h"
+
+
+namespace rx
+{
+// Emits only the last value, and only once the subject completes, to current and later observers.
+// An error is forwarded without a value.
+class AsyncSubject : public Subject
+{
+public:
+    using Inner = SubjectDisposable<AsyncSubject>;
+
+    AsyncSubject()
+    {
+        LeakObserver::make<AsyncSubject>();
+    }
+
+    ~AsyncSubject() override
+    {
+        LeakObserver::release<AsyncSubject>();
+    }
+
+    static std::shared_ptr<AsyncSubject> create()
+    {
+        return std::make_shared<AsyncSubject>();
+    }
+
+public:
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mValue = value;
+        mHasValue = true;
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        mHasValue = false;
+        mValue = GAny();
+        mError = std::make_unique<GAnyException>(e);
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            inner->onError(e);
+        }
+    }
+
+    void onComplete() override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            emitTo(*inner);
+        }
+    }
+
+    bool hasObservers() const override
+    {
+        return !mObservers.isEmpty();
+    }
+
+    bool hasComplete() const override
+    {
+        return mObservers.isTerminated() && !mError;
+    }
+
+    bool hasThrowable() const override
+    {
+        return mObservers.isTerminated() && mError;
+    }
+
+    // The last value, only meaningful once the subject completed
+    bool hasValue() const
+    {
+        return mObservers.isTerminated() && mHasValue;
+    }
+
+    GAny getValue() const
+    {
+        return hasValue() ? mValue : GAny();
+    }
+
+    void remove(const Inner *inner)
+    {
+        mObservers.remove(inner);
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const auto inner = std::make_shared<Inner>(
+            observer, std::static_pointer_cast<AsyncSubject>(shared_from_this()));
+        observer->onSubscribe(inner);
+        if (mObservers.add(inner)) {
+            if (inner->isDisposed()) {
+                remove(inner.get());
+            }
+            return;
+        }
+        if (mError) {
+            inner->onError(*mError);
+        } else {
+            emitTo(*inner);
+        }
+    }
+
+private:
+    void emitTo(Inner &inner) const
+    {
+        if (mHasValue) {
+            inner.onNext(mValue);
+        }
+        inner.onComplete();
+    }
+
+private:
+    SubscriberArray<Inner> mObservers;
+    GAny mValue;                           // Written by the producer only, read after termination
+    bool mHasValue = false;
+    std::unique_ptr<GAnyException> mError; // Written before the array is terminated
+    std::atomic<bool> mDone = false;
+};
+} // rx
+
+#endif //RX_ASYNC_SUBJECT_H
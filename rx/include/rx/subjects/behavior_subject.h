@@ -0,0 +1,329 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_BEHAVIOR_SUBJECT_H
+#define RX_BEHAVIOR_SUBJECT_H
+
+#include "subject.h"
+#include "../subscriber_array.h"
+
+#include <vector>
+
+
+namespace rx
+{
+class BehaviorSubject;
+
+// Observer handle of a BehaviorSubject.
+// The current value is delivered by emitFirst() while the producer may already be pushing newer ones,
+// values arriving during that window are queued and the stale first value is skipped by index. Once the
+// first emission is done, later values take the fast path straight to the observer.
+class BehaviorDisposable : public Disposable
+{
+public:
+    struct Signal
+    {
+        GAny value;
+        std::shared_ptr<const GAnyException> error;
+        bool complete = false;
+    };
+
+    BehaviorDisposable(const ObserverPtr &downstream, const std::shared_ptr<BehaviorSubject> &parent)
+        : mDownstream(downstream), mParent(parent)
+    {
+        LeakObserver::make<BehaviorDisposable>();
+    }
+
+    ~BehaviorDisposable() override
+    {
+        LeakObserver::release<BehaviorDisposable>();
+    }
+
+public:
+    void emitFirst(BehaviorSubject &parent);
+
+    void emitNext(const Signal &signal, uint64_t index)
+    {
+        if (isDisposed()) {
+            return;
+        }
+        if (!mFastPath.load(std::memory_order_acquire)) {
+            {
+                GLockerGuard lock(mLock);
+                if (isDisposed() || mIndex == index) {
+                    return;
+                }
+                if (mEmitting) {
+                    mQueue.push_back(signal);
+                    return;
+                }
+                mNext = true;
+            }
+            mFastPath.store(true, std::memory_order_release);
+        }
+        test(signal);
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    // Delivers one signal, returns true once the observer is finished
+    bool test(const Signal &signal)
+    {
+        if (isDisposed()) {
+            return true;
+        }
+        const auto d = mDownstream;
+        if (!d) {
+            return true;
+        }
+        if (signal.error) {
+            mDownstream = nullptr;
+            d->onError(*signal.error);
+            return true;
+        }
+        if (signal.complete) {
+            mDownstream = nullptr;
+            d->onComplete();
+            return true;
+        }
+        d->onNext(signal.value);
+        return false;
+    }
+
+    void emitLoop()
+    {
+        std::vector<Signal> queue;
+        while (true) {
+            {
+                GLockerGuard lock(mLock);
+                if (mQueue.empty()) {
+                    mEmitting = false;
+                    return;
+                }
+                queue.swap(mQueue);
+            }
+            for (const auto &signal: queue) {
+                if (test(signal)) {
+                    return;
+                }
+            }
+            queue.clear();
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::weak_ptr<BehaviorSubject> mParent;
+    std::atomic<bool> mDisposed = false;
+    std::atomic<bool> mFastPath = false;
+
+    GMutex mLock;
+    bool mNext = false;
+    bool mEmitting = false;
+    uint64_t mIndex = 0;
+    std::vector<Signal> mQueue;
+};
+
+// Emits the most recent value (or the initial one) to each new observer, then every later value.
+// Observers arriving after termination only receive the terminal event.
+class BehaviorSubject : public Subject
+{
+public:
+    using Signal = BehaviorDisposable::Signal;
+
+    BehaviorSubject()
+    {
+        LeakObserver::make<BehaviorSubject>();
+    }
+
+    explicit BehaviorSubject(const GAny &initialValue)
+        : BehaviorSubject()
+    {
+        mCurrent.value = initialValue;
+        mHasValue = true;
+    }
+
+    ~BehaviorSubject() override
+    {
+        LeakObserver::release<BehaviorSubject>();
+    }
+
+    static std::shared_ptr<BehaviorSubject> create()
+    {
+        return std::make_shared<BehaviorSubject>();
+    }
+
+    static std::shared_ptr<BehaviorSubject> createDefault(const GAny &initialValue)
+    {
+        return std::make_shared<BehaviorSubject>(initialValue);
+    }
+
+public:
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        uint64_t index;
+        {
+            GLockerGuard lock(mLock);
+            mCurrent.value = value;
+            mHasValue = true;
+            index = ++mIndex;
+        }
+        const Signal signal{value, nullptr, false};
+        const auto observers = mObservers.load();
+        for (const auto &inner: *observers) {
+            inner->emitNext(signal, index);
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        terminate(Signal{GAny(), std::make_shared<const GAnyException>(e), false});
+    }
+
+    void onComplete() override
+    {
+        terminate(Signal{GAny(), nullptr, true});
+    }
+
+    bool hasObservers() const override
+    {
+        return !mObservers.isEmpty();
+    }
+
+    bool hasComplete() const override
+    {
+        GLockerGuard lock(mLock);
+        return mCurrent.complete;
+    }
+
+    bool hasThrowable() const override
+    {
+        GLockerGuard lock(mLock);
+        return mCurrent.error != nullptr;
+    }
+
+    bool hasValue() const
+    {
+        GLockerGuard lock(mLock);
+        return mHasValue && !mCurrent.complete && !mCurrent.error;
+    }
+
+    GAny getValue() const
+    {
+        GLockerGuard lock(mLock);
+        return mHasValue && !mCurrent.complete && !mCurrent.error ? mCurrent.value : GAny();
+    }
+
+    void remove(const BehaviorDisposable *inner)
+    {
+        mObservers.remove(inner);
+    }
+
+    // Current signal and its index for an observer's first emission
+    bool current(Signal &signal, uint64_t &index) const
+    {
+        GLockerGuard lock(mLock);
+        index = mIndex;
+        if (!mHasValue && !mCurrent.complete && !mCurrent.error) {
+            return false;
+        }
+        signal = mCurrent;
+        return true;
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const auto inner = std::make_shared<BehaviorDisposable>(
+            observer, std::static_pointer_cast<BehaviorSubject>(shared_from_this()));
+        observer->onSubscribe(inner);
+        if (mObservers.add(inner)) {
+            if (inner->isDisposed()) {
+                remove(inner.get());
+            } else {
+                inner->emitFirst(*this);
+            }
+            return;
+        }
+        Signal terminal;
+        uint64_t index;
+        current(terminal, index);
+        terminal.value = GAny();
+        inner->emitNext(terminal, index + 1);
+    }
+
+private:
+    void terminate(const Signal &terminal)
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        uint64_t index;
+        {
+            GLockerGuard lock(mLock);
+            mCurrent = terminal;
+            index = ++mIndex;
+        }
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            inner->emitNext(terminal, index);
+        }
+    }
+
+private:
+    SubscriberArray<BehaviorDisposable> mObservers;
+    mutable GMutex mLock;
+    Signal mCurrent; // Latest value, or the terminal signal once terminated
+    bool mHasValue = false;
+    uint64_t mIndex = 0;
+    std::atomic<bool> mDone = false;
+};
+
+inline void BehaviorDisposable::emitFirst(BehaviorSubject &parent)
+{
+    if (isDisposed()) {
+        return;
+    }
+    Signal signal;
+    bool hasSignal;
+    {
+        GLockerGuard lock(mLock);
+        if (mNext) {
+            return;
+        }
+        hasSignal = parent.current(signal, mIndex);
+        mEmitting = hasSignal;
+        mNext = true;
+    }
+    if (hasSignal) {
+        if (test(signal)) {
+            return;
+        }
+        emitLoop();
+    }
+}
+
+inline void BehaviorDisposable::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (const auto parent = mParent.lock()) {
+        parent->remove(this);
+    }
+    GLockerGuard lock(mLock);
+    mQueue.clear();
+}
+} // rx
+
+#endif //RX_BEHAVIOR_SUBJECT_H
@@ -0,0 +1,121 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_PUBLISH_SUBJECT_H
+#define RX_PUBLISH_SUBJECT_H
+
+#include "subject.h"
+#include "../subscriber_array.h"
+
+
+namespace rx
+{
+// Emits to each observer only the values pushed after it subscribed.
+// Observers arriving after termination receive the terminal event.
+class PublishSubject : public Subject
+{
+public:
+    using Inner = SubjectDisposable<PublishSubject>;
+
+    PublishSubject()
+    {
+        LeakObserver::make<PublishSubject>();
+    }
+
+    ~PublishSubject() override
+    {
+        LeakObserver::release<PublishSubject>();
+    }
+
+    static std::shared_ptr<PublishSubject> create()
+    {
+        return std::make_shared<PublishSubject>();
+    }
+
+public:
+    void onNext(const GAny &value) override
+    {
+        const auto observers = mObservers.load();
+        for (const auto &inner: *observers) {
+            inner->onNext(value);
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            inner->onError(e);
+        }
+    }
+
+    void onComplete() override
+    {
+        if (mDone.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            inner->onComplete();
+        }
+    }
+
+    bool hasObservers() const override
+    {
+        return !mObservers.isEmpty();
+    }
+
+    bool hasComplete() const override
+    {
+        return mObservers.isTerminated() && !mError;
+    }
+
+    bool hasThrowable() const override
+    {
+        return mObservers.isTerminated() && mError;
+    }
+
+    void remove(const Inner *inner)
+    {
+        if (mObservers.remove(inner)) {
+            onObserversEmpty();
+        }
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        const auto inner = std::make_shared<Inner>(
+            observer, std::static_pointer_cast<PublishSubject>(shared_from_this()));
+        observer->onSubscribe(inner);
+        if (mObservers.add(inner)) {
+            if (inner->isDisposed()) {
+                remove(inner.get());
+            }
+            return;
+        }
+        if (mError) {
+            inner->onError(*mError);
+        } else {
+            inner->onComplete();
+        }
+    }
+
+    // Called when disposing an observer left the subject without any, not after termination
+    virtual void onObserversEmpty()
+    {
+    }
+
+private:
+    SubscriberArray<Inner> mObservers;
+    std::unique_ptr<GAnyException> mError; // Written before the array is terminated
+    std::atomic<bool> mDone = false;
+};
+} // rx
+
+#endif //RX_PUBLISH_SUBJECT_H
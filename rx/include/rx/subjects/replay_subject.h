@@ -0,0 +1,229 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_REPLAY_SUBJECT_H
+#define RX_REPLAY_SUBJECT_H
+
+#include "subject.h"
+#include "../replay_buffer.h"
+#include "../subscriber_array.h"
+
+
+namespace rx
+{
+class ReplaySubject;
+
+// Observer handle of a ReplaySubject, walks the shared buffer with its own cursor.
+// replay() is entered by both the subscribing thread and the producer, the WIP counter lets one of them drain.
+class ReplayDisposable : public Disposable
+{
+public:
+    ReplayDisposable(const ObserverPtr &downstream, const std::shared_ptr<ReplaySubject> &parent,
+                     const std::shared_ptr<ReplayBuffer> &buffer)
+        : mDownstream(downstream), mParent(parent), mBuffer(buffer), mCursor(buffer->head())
+    {
+        LeakObserver::make<ReplayDisposable>();
+    }
+
+    ~ReplayDisposable() override
+    {
+        LeakObserver::release<ReplayDisposable>();
+        ReplayBuffer::release(mCursor.segment);
+    }
+
+public:
+    void replay()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        GAny value;
+        while (true) {
+            while (true) {
+                if (isDisposed()) {
+                    mDownstream = nullptr;
+                    ReplayBuffer::release(mCursor.segment);
+                    return;
+                }
+                // Read the terminal flag first, values added before it are then guaranteed to be visible
+                const bool done = mBuffer->isDone();
+                if (mBuffer->read(mCursor, value)) {
+                    mDownstream->onNext(value);
+                    continue;
+                }
+                if (done) {
+                    terminate();
+                    return;
+                }
+                break;
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    void dispose() override;
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    // Reached once the cursor caught up with a finished buffer, dropping its segment stops this observer from
+    // keeping trimmed segments alive
+    void terminate()
+    {
+        ReplayBuffer::release(mCursor.segment);
+        const auto downstream = std::move(mDownstream);
+        if (const auto &error = mBuffer->getError()) {
+            downstream->onError(*error);
+        } else {
+            downstream->onComplete();
+        }
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::weak_ptr<ReplaySubject> mParent;
+    std::shared_ptr<ReplayBuffer> mBuffer;
+    ReplayBuffer::Cursor mCursor;
+    std::atomic<uint32_t> mWip = 0;
+    std::atomic<bool> mDisposed = false;
+};
+
+// Replays the buffered values to each new observer, then relays live ones, terminal event included.
+// The buffer may be unbounded or keep only the last maxSize values and/or the values younger than maxAge.
+class ReplaySubject : public Subject
+{
+public:
+    explicit ReplaySubject(std::shared_ptr<ReplayBuffer> buffer)
+        : mBuffer(std::move(buffer))
+    {
+        LeakObserver::make<ReplaySubject>();
+    }
+
+    ~ReplaySubject() override
+    {
+        LeakObserver::release<ReplaySubject>();
+    }
+
+    static std::shared_ptr<ReplaySubject> create()
+    {
+        return std::make_shared<ReplaySubject>(std::make_shared<ReplayBuffer>());
+    }
+
+    static std::shared_ptr<ReplaySubject> createWithSize(size_t maxSize)
+    {
+        return std::make_shared<ReplaySubject>(std::make_shared<ReplayBuffer>(maxSize));
+    }
+
+    // maxAge in milliseconds, measured with the scheduler's clock
+    static std::shared_ptr<ReplaySubject> createWithTime(uint64_t maxAge, const SchedulerPtr &scheduler,
+                                                         size_t maxSize = 0)
+    {
+        return std::make_shared<ReplaySubject>(
+            std::make_shared<ReplayBuffer>(maxSize, maxAge, scheduler));
+    }
+
+public:
+    void onNext(const GAny &value) override
+    {
+        if (mBuffer->isDone()) {
+            return;
+        }
+        mBuffer->add(value);
+        const auto observers = mObservers.load();
+        for (const auto &inner: *observers) {
+            inner->replay();
+        }
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mBuffer->isDone()) {
+            return;
+        }
+        mBuffer->error(e);
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            inner->replay();
+        }
+    }
+
+    void onComplete() override
+    {
+        if (mBuffer->isDone()) {
+            return;
+        }
+        mBuffer->complete();
+        const auto observers = mObservers.terminate();
+        for (const auto &inner: *observers) {
+            inner->replay();
+        }
+    }
+
+    bool hasObservers() const override
+    {
+        return !mObservers.isEmpty();
+    }
+
+    bool hasComplete() const override
+    {
+        return mBuffer->isDone() && !mBuffer->getError();
+    }
+
+    bool hasThrowable() const override
+    {
+        return mBuffer->isDone() && mBuffer->getError();
+    }
+
+    // Values a new observer would currently receive
+    std::vector<GAny> getValues() const
+    {
+        return mBuffer->snapshot();
+    }
+
+    void remove(const ReplayDisposable *inner)
+    {
+        mObservers.remove(inner);
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        // The cursor is taken before the observer is registered, values added in between are still seen
+        const auto inner = std::make_shared<ReplayDisposable>(
+            observer, std::static_pointer_cast<ReplaySubject>(shared_from_this()), mBuffer);
+        observer->onSubscribe(inner);
+        if (mObservers.add(inner) && inner->isDisposed()) {
+            remove(inner.get());
+            return;
+        }
+        inner->replay();
+    }
+
+private:
+    std::shared_ptr<ReplayBuffer> mBuffer;
+    SubscriberArray<ReplayDisposable> mObservers;
+};
+
+inline void ReplayDisposable::dispose()
+{
+    if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (const auto parent = mParent.lock()) {
+        parent->remove(this);
+    }
+    // Let the drain, or this call if none is running, release the downstream and the cursor
+    replay();
+}
+} // rx
+
+#endif //RX_REPLAY_SUBJECT_H
@@ -0,0 +1,109 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_SUBJECT_H
+#define RX_SUBJECT_H
+
+#include "../observable.h"
+#include "../leak_observer.h"
+
+#include <atomic>
+
+
+namespace rx
+{
+// Both ends of a stream: values pushed in through the Observer side are multicast to the observers
+// subscribed on the Observable side. onNext/onError/onComplete must not be called concurrently.
+class Subject : public Observable, public Observer
+{
+public:
+    ~Subject() override = default;
+
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        if (hasComplete() || hasThrowable()) {
+            d->dispose();
+        }
+    }
+
+    virtual bool hasObservers() const = 0;
+
+    virtual bool hasComplete() const = 0;
+
+    virtual bool hasThrowable() const = 0;
+};
+
+using SubjectPtr = std::shared_ptr<Subject>;
+
+// Per-observer handle of a multicasting subject, disposing it removes the observer from Parent
+template<typename Parent>
+class SubjectDisposable : public Disposable
+{
+public:
+    SubjectDisposable(const ObserverPtr &downstream, const std::shared_ptr<Parent> &parent)
+        : mDownstream(downstream), mParent(parent)
+    {
+        LeakObserver::make<SubjectDisposable>();
+    }
+
+    ~SubjectDisposable() override
+    {
+        LeakObserver::release<SubjectDisposable>();
+    }
+
+public:
+    void onNext(const GAny &value) const
+    {
+        if (!isDisposed()) {
+            if (const auto d = mDownstream) {
+                d->onNext(value);
+            }
+        }
+    }
+
+    void onError(const GAnyException &e)
+    {
+        if (!isDisposed()) {
+            if (const auto d = mDownstream) {
+                d->onError(e);
+            }
+        }
+        mDownstream = nullptr;
+    }
+
+    void onComplete()
+    {
+        if (!isDisposed()) {
+            if (const auto d = mDownstream) {
+                d->onComplete();
+            }
+        }
+        mDownstream = nullptr;
+    }
+
+    void dispose() override
+    {
+        if (mDisposed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (const auto parent = mParent.lock()) {
+            parent->remove(this);
+        }
+        mDownstream = nullptr;
+    }
+
+    bool isDisposed() const override
+    {
+        return mDisposed.load(std::memory_order_acquire);
+    }
+
+private:
+    ObserverPtr mDownstream;
+    std::weak_ptr<Parent> mParent;
+    std::atomic<bool> mDisposed = false;
+};
+} // rx
+
+#endif //RX_SUBJECT_H
@@ -0,0 +1,176 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_UNICAST_SUBJECT_H
+#define RX_UNICAST_SUBJECT_H
+
+#include "subject.h"
+#include "../spsc_queue.h"
+#include "../operators/observable_empty.h"
+
+
+namespace rx
+{
+// Single-consumer subject: values are queued until its one observer subscribes and then drained straight to it,
+// so pushing a value never copies an emitter list. A second observer receives an error.
+// Backs the windows of window/windowTimed, disposing the subject itself drops the queued values.
+class UnicastSubject : public Subject, public Disposable
+{
+public:
+    UnicastSubject()
+    {
+        LeakObserver::make<UnicastSubject>();
+    }
+
+    ~UnicastSubject() override
+    {
+        LeakObserver::release<UnicastSubject>();
+    }
+
+    static std::shared_ptr<UnicastSubject> create()
+    {
+        return std::make_shared<UnicastSubject>();
+    }
+
+public:
+    void onNext(const GAny &value) override
+    {
+        if (mDone.load(std::memory_order_acquire) || mCancelled.load(std::memory_order_acquire)) {
+            return;
+        }
+        mQueue.offer(value);
+        drain();
+    }
+
+    void onError(const GAnyException &e) override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mError = std::make_unique<GAnyException>(e);
+        mDone.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void onComplete() override
+    {
+        if (mDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        mDone.store(true, std::memory_order_release);
+        drain();
+    }
+
+    void dispose() override
+    {
+        if (mCancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            clear();
+        }
+    }
+
+    bool isDisposed() const override
+    {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+    bool hasObservers() const override
+    {
+        return mAttached.load(std::memory_order_acquire) && !mCancelled.load(std::memory_order_acquire);
+    }
+
+    bool hasComplete() const override
+    {
+        return mDone.load(std::memory_order_acquire) && !mError;
+    }
+
+    bool hasThrowable() const override
+    {
+        return mDone.load(std::memory_order_acquire) && mError;
+    }
+
+protected:
+    void subscribeActual(const ObserverPtr &observer) override
+    {
+        if (mSubscribed.exchange(true, std::memory_order_acq_rel)) {
+            EmptyDisposable::error(observer.get(), GAnyException("UnicastSubject allows only a single observer"));
+            return;
+        }
+        mDownstream = observer;
+        observer->onSubscribe(std::static_pointer_cast<UnicastSubject>(shared_from_this()));
+        mAttached.store(true, std::memory_order_release);
+        drain();
+    }
+
+private:
+    void drain()
+    {
+        if (mWip.fetch_add(1, std::memory_order_acq_rel) != 0) {
+            return;
+        }
+        uint32_t missed = 1;
+        while (true) {
+            // Until the observer attaches, values simply stay queued
+            if (mAttached.load(std::memory_order_acquire)) {
+                while (true) {
+                    if (mCancelled.load(std::memory_order_acquire)) {
+                        clear();
+                        return;
+                    }
+                    const bool done = mDone.load(std::memory_order_acquire);
+                    GAny value;
+                    if (mQueue.poll(value)) {
+                        mDownstream->onNext(value);
+                        continue;
+                    }
+                    if (done) {
+                        terminate();
+                        return;
+                    }
+                    break;
+                }
+            } else if (mCancelled.load(std::memory_order_acquire)) {
+                clear();
+                return;
+            }
+
+            missed = mWip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    // Reached once the queue is empty, the observer gets the terminal after every value queued before it
+    void terminate()
+    {
+        const auto downstream = std::move(mDownstream);
+        if (mError) {
+            downstream->onError(*mError);
+        } else {
+            downstream->onComplete();
+        }
+    }
+
+    void clear()
+    {
+        mQueue.clear();
+        mDownstream = nullptr;
+    }
+
+private:
+    SpscQueue mQueue;
+    ObserverPtr mDownstream;
+    std::unique_ptr<GAnyException> mError;
+    std::atomic<bool> mDone = false;
+    std::atomic<bool> mSubscribed = false;
+    std::atomic<bool> mAttached = false;
+    std::atomic<bool> mCancelled = false;
+    std::atomic<uint32_t> mWip = 0;
+};
+} // rx
+
+#endif //RX_UNICAST_SUBJECT_H
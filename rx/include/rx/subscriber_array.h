@@ -0,0 +1,118 @@
+//
+// Created by Gxin on 2026/10/19.
+//
+
+#ifndef RX_SUBSCRIBER_ARRAY_H
+#define RX_SUBSCRIBER_ARRAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+namespace rx
+{
+// Copy-on-write array of subscribers for multicasting sources.
+// add()/remove() build a new immutable array and swap it in with CAS, so emitting only loads the current
+// array: no lock and no allocation per item. terminate() swaps in a sentinel after which add() fails.
+template<typename T>
+class SubscriberArray
+{
+public:
+    using Items = std::vector<std::shared_ptr<T> >;
+    using ItemsPtr = std::shared_ptr<const Items>;
+
+    SubscriberArray()
+        : mItems(empty())
+    {
+    }
+
+public:
+    ItemsPtr load() const
+    {
+        return mItems.load(std::memory_order_acquire);
+    }
+
+    // Fails once the array was terminated
+    bool add(const std::shared_ptr<T> &item)
+    {
+        ItemsPtr current = mItems.load(std::memory_order_acquire);
+        while (true) {
+            if (current == terminated()) {
+                return false;
+            }
+            auto next = std::make_shared<Items>();
+            next->reserve(current->size() + 1);
+            next->insert(next->end(), current->begin(), current->end());
+            next->push_back(item);
+            if (mItems.compare_exchange_weak(current, std::move(next), std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    // Returns true when this call removed the last subscriber
+    bool remove(const T *item)
+    {
+        ItemsPtr current = mItems.load(std::memory_order_acquire);
+        while (true) {
+            if (current == terminated() || current->empty()) {
+                return false;
+            }
+            const auto it = std::find_if(current->begin(), current->end(), [item](const std::shared_ptr<T> &e) {
+                return e.get() == item;
+            });
+            if (it == current->end()) {
+                return false;
+            }
+            ItemsPtr next = empty();
+            if (current->size() > 1) {
+                auto items = std::make_shared<Items>();
+                items->reserve(current->size() - 1);
+                items->insert(items->end(), current->begin(), it);
+                items->insert(items->end(), it + 1, current->end());
+                next = std::move(items);
+            }
+            if (mItems.compare_exchange_weak(current, next, std::memory_order_acq_rel)) {
+                return next->empty();
+            }
+        }
+    }
+
+    // Returns the subscribers present at termination, later calls return an empty array
+    ItemsPtr terminate()
+    {
+        const ItemsPtr previous = mItems.exchange(terminated(), std::memory_order_acq_rel);
+        return previous == terminated() ? empty() : previous;
+    }
+
+    bool isTerminated() const
+    {
+        return mItems.load(std::memory_order_acquire) == terminated();
+    }
+
+    bool isEmpty() const
+    {
+        return mItems.load(std::memory_order_acquire)->empty();
+    }
+
+private:
+    static const ItemsPtr &empty()
+    {
+        static const ItemsPtr instance = std::make_shared<const Items>();
+        return instance;
+    }
+
+    static const ItemsPtr &terminated()
+    {
+        static const ItemsPtr instance = std::make_shared<const Items>();
+        return instance;
+    }
+
+private:
+    std::atomic<ItemsPtr> mItems;
+};
+} // rx
+
+#endif //RX_SUBSCRIBER_ARRAY_H
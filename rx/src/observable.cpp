@@ -9,6 +9,7 @@
 #include "rx/observers/blocking_for_each_observer.h"
 #include "rx/observers/blocking_last_observer.h"
 #include "rx/operators/observable_buffer.h"
+#include "rx/operators/observable_buffer_timed.h"
 #include "rx/operators/observable_combine_latest.h"
 #include "rx/operators/observable_concat_map.h"
 #include "rx/operators/observable_create.h"
@@ -17,7 +18,9 @@
 #include "rx/operators/observable_skip_while.h"
 #include "rx/operators/observable_take_while.h"
 #include "rx/operators/observable_group_by.h"
+#include "rx/operators/observable_group_by_parallel.h"
 #include "rx/operators/observable_window.h"
+#include "rx/operators/observable_window_timed.h"
 #include "rx/operators/observable_defer.h"
 #include "rx/operators/observable_delay.h"
 #include "rx/operators/observable_element_at.h"
@@ -29,17 +32,33 @@
 #include "rx/operators/observable_ignore_elements.h"
 #include "rx/operators/observable_interval.h"
 #include "rx/operators/observable_join.h"
+#include "rx/operators/observable_join_on_key.h"
 #include "rx/operators/observable_just.h"
 #include "rx/operators/observable_last.h"
 #include "rx/operators/observable_map.h"
+#include "rx/operators/observable_map_async.h"
 #include "rx/operators/observable_never.h"
 #include "rx/operators/observable_observe_on.h"
+#include "rx/operators/observable_publish.h"
 #include "rx/operators/observable_range.h"
+#include "rx/operators/observable_ref_count.h"
+#include "rx/operators/observable_replay.h"
+#include "rx/operators/observable_auto_connect.h"
+#include "rx/operators/observable_balance.h"
+#include "rx/operators/observable_broadcast.h"
+#include "rx/operators/parallel_from.h"
+#include "rx/operators/parallel_run_on.h"
+#include "rx/operators/parallel_map.h"
+#include "rx/operators/parallel_filter.h"
+#include "rx/operators/parallel_join.h"
+#include "rx/operators/parallel_reduce.h"
+#include "rx/operators/parallel_sorted.h"
 #include "rx/operators/observable_repeat.h"
 #include "rx/operators/observable_do_on_each.h"
 #include "rx/operators/observable_retry.h"
 #include "rx/operators/observable_scan.h"
 #include "rx/operators/observable_reduce.h"
+#include "rx/operators/observable_reduce_parallel.h"
 #include "rx/operators/observable_skip.h"
 #include "rx/operators/observable_skip_last.h"
 #include "rx/operators/observable_start_with.h"
@@ -51,7 +70,10 @@
 #include "rx/operators/observable_timeout.h"
 #include "rx/operators/observable_timer.h"
 #include "rx/operators/observable_to_array.h"
+#include "rx/operators/observable_sorted.h"
+#include "rx/operators/observable_sorted_external.h"
 #include "rx/operators/observable_zip.h"
+#include "rx/operators/observable_merge_sorted.h"
 #include "rx/operators/observable_all.h"
 #include "rx/operators/observable_any.h"
 #include "rx/operators/observable_default_if_empty.h"
@@ -62,10 +84,22 @@
 #include "rx/operators/observable_distinct_until_changed.h"
 #include "rx/operators/observable_sample.h"
 #include "rx/schedulers/main_thread_scheduler.h"
+#include "rx/schedulers/new_thread_scheduler.h"
 
 
 namespace rx
 {
+static void checkRangeOverflow(int64_t start, uint64_t count)
+{
+    const uint64_t maxDistance = start >= 0
+                                     ? static_cast<uint64_t>(std::numeric_limits<int64_t>::max() - start)
+                                     : static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
+                                           + static_cast<uint64_t>(-(start + 1)) + 1;
+    if (count - 1 > maxDistance) {
+        throw GAnyException("Integer overflow");
+    }
+}
+
 std::shared_ptr<Observable> Observable::create(ObservableOnSubscribe source)
 {
     return std::make_shared<ObservableCreate>(std::move(source));
@@ -78,7 +112,37 @@ std::shared_ptr<Observable> Observable::empty()
 
 std::shared_ptr<Observable> Observable::fromArray(const std::vector<GAny> &array)
 {
-    return std::make_shared<ObservableFromArray>(array);
+    return fromIterable(std::make_shared<const std::vector<GAny> >(array));
+}
+
+std::shared_ptr<Observable> Observable::fromArray(std::vector<GAny> &&array)
+{
+    return fromIterable(std::make_shared<const std::vector<GAny> >(std::move(array)));
+}
+
+std::shared_ptr<Observable> Observable::fromIterable(std::shared_ptr<const std::vector<GAny> > items)
+{
+    if (!items) {
+        return empty();
+    }
+    return std::make_shared<ObservableFromArray>(std::move(items));
+}
+
+std::shared_ptr<Observable> Observable::fromIterable(std::span<const GAny> items, std::shared_ptr<const void> owner)
+{
+    return std::make_shared<ObservableFromArray>(items, std::move(owner));
+}
+
+std::shared_ptr<Observable> Observable::fromArray(std::vector<GAny> array, SchedulerPtr scheduler, uint64_t chunkSize)
+{
+    if (chunkSize == 0) {
+        throw GAnyException("Chunk size must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableFromArray>(std::make_shared<const std::vector<GAny> >(std::move(array)),
+                                                 scheduler, chunkSize);
 }
 
 std::shared_ptr<Observable> Observable::never()
@@ -116,15 +180,24 @@ std::shared_ptr<Observable> Observable::range(int64_t start, uint64_t count)
         return just(start);
     }
 
-    const uint64_t maxDistance = start >= 0
-                                     ? static_cast<uint64_t>(std::numeric_limits<int64_t>::max() - start)
-                                     : static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
-                                           + static_cast<uint64_t>(-(start + 1)) + 1;
-    if (count - 1 > maxDistance) {
-        throw GAnyException("Integer overflow");
+    checkRangeOverflow(start, count);
+    return std::make_shared<ObservableRange>(start, count);
+}
+
+std::shared_ptr<Observable> Observable::range(int64_t start, uint64_t count, SchedulerPtr scheduler, uint64_t chunkSize)
+{
+    if (chunkSize == 0) {
+        throw GAnyException("Chunk size must be greater than zero");
+    }
+    if (count == 0) {
+        return empty();
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
     }
 
-    return std::make_shared<ObservableRange>(start, count);
+    checkRangeOverflow(start, count);
+    return std::make_shared<ObservableRange>(start, count, scheduler, chunkSize);
 }
 
 std::shared_ptr<Observable> Observable::combineLatestArray(const std::vector<std::shared_ptr<Observable> > &sources,
@@ -133,6 +206,13 @@ std::shared_ptr<Observable> Observable::combineLatestArray(const std::vector<std
     return std::make_shared<ObservableCombineLatest>(sources, combiner);
 }
 
+std::shared_ptr<Observable> Observable::combineLatestArray(const std::vector<std::shared_ptr<Observable> > &sources,
+                                                           const CombineLatestFunction &combiner,
+                                                           CombineOptions options)
+{
+    return std::make_shared<ObservableCombineLatest>(sources, combiner, options);
+}
+
 std::shared_ptr<Observable> Observable::combineLatest(const std::shared_ptr<Observable> &source1, const std::shared_ptr<Observable> &source2, const BiFunction &combiner)
 {
     return combineLatestArray({source1, source2}, [combiner](const std::vector<GAny> &values) {
@@ -179,11 +259,19 @@ std::shared_ptr<Observable> Observable::mergeArray(const std::vector<std::shared
     for (const auto &s : sources) {
         items.emplace_back(s);
     }
-    return fromArray(items)->flatMap([](const GAny &v) {
+    return fromArray(std::move(items))->flatMap([](const GAny &v) {
         return v.castAs<std::shared_ptr<Observable> >();
     });
 }
 
+std::shared_ptr<Observable> Observable::mergeSorted(const std::vector<std::shared_ptr<Observable> > &sources,
+                                                    const ComparatorFunction &comparator,
+                                                    uint64_t prefetch,
+                                                    OverflowStrategy strategy)
+{
+    return std::make_shared<ObservableMergeSorted>(sources, comparator, prefetch, strategy);
+}
+
 std::shared_ptr<Observable> Observable::concatArray(const std::vector<std::shared_ptr<Observable> > &sources)
 {
     if (sources.empty()) {
@@ -194,7 +282,7 @@ std::shared_ptr<Observable> Observable::concatArray(const std::vector<std::share
     for (const auto &s : sources) {
         items.emplace_back(s);
     }
-    return fromArray(items)->concatMap([](const GAny &v) {
+    return fromArray(std::move(items))->concatMap([](const GAny &v) {
         return v.castAs<std::shared_ptr<Observable> >();
     });
 }
@@ -210,6 +298,20 @@ std::shared_ptr<Observable> Observable::zipArray(const std::vector<std::shared_p
     return std::make_shared<ObservableZip>(sources, zipper);
 }
 
+std::shared_ptr<Observable> Observable::zipArray(const std::vector<std::shared_ptr<Observable> > &sources,
+                                                 const CombineLatestFunction &zipper,
+                                                 uint64_t capacity,
+                                                 OverflowStrategy strategy)
+{
+    if (capacity == 0) {
+        throw GAnyException("Zip capacity must be greater than zero");
+    }
+    if (strategy == OverflowStrategy::Block) {
+        throw GAnyException("Zip does not support OverflowStrategy::Block");
+    }
+    return std::make_shared<ObservableZip>(sources, zipper, capacity, strategy);
+}
+
 std::shared_ptr<Observable> Observable::zip(const std::shared_ptr<Observable> &source1,
                                             const std::shared_ptr<Observable> &source2,
                                             const BiFunction &zipper)
@@ -225,6 +327,18 @@ std::shared_ptr<Observable> Observable::map(const MapFunction &function)
     return std::make_shared<ObservableMap>(this->shared_from_this(), function);
 }
 
+std::shared_ptr<Observable> Observable::mapAsync(const MapFunction &function, SchedulerPtr scheduler,
+                                                uint32_t maxConcurrency)
+{
+    if (maxConcurrency == 0) {
+        throw GAnyException("MapAsync maxConcurrency must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = NewThreadScheduler::create();
+    }
+    return std::make_shared<ObservableMapAsync>(this->shared_from_this(), function, scheduler, maxConcurrency);
+}
+
 std::shared_ptr<Observable> Observable::flatMap(const FlatMapFunction &function)
 {
     return std::make_shared<ObservableFlatMap>(this->shared_from_this(), function);
@@ -253,11 +367,289 @@ std::shared_ptr<Observable> Observable::buffer(uint64_t count)
     return buffer(count, count);
 }
 
+std::shared_ptr<Observable> Observable::bufferTimed(uint64_t timespan, uint64_t maxCount, SchedulerPtr scheduler)
+{
+    if (timespan == 0) {
+        throw GAnyException("Buffer timespan must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableBufferTimed>(this->shared_from_this(), timespan, 0, maxCount, scheduler);
+}
+
+std::shared_ptr<Observable> Observable::bufferTimedSkip(uint64_t timespan, uint64_t timeskip, SchedulerPtr scheduler)
+{
+    if (timespan == 0 || timeskip == 0) {
+        throw GAnyException("Buffer timespan and timeskip must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableBufferTimed>(this->shared_from_this(), timespan, timeskip, 0, scheduler);
+}
+
+std::shared_ptr<Observable> Observable::bufferView(uint64_t count, uint64_t skip)
+{
+    if (count == 0 || skip == 0) {
+        throw GAnyException("Buffer count and skip must be greater than zero");
+    }
+    return std::make_shared<ObservableBuffer>(this->shared_from_this(), count, skip, true);
+}
+
+std::shared_ptr<Observable> Observable::bufferView(uint64_t count)
+{
+    return bufferView(count, count);
+}
+
 std::shared_ptr<Observable> Observable::toArray()
 {
     return std::make_shared<ObservableToArray>(this->shared_from_this());
 }
 
+std::shared_ptr<Observable> Observable::toSortedList(const ComparatorFunction &comparator, SchedulerPtr scheduler)
+{
+    return std::make_shared<ObservableSorted>(this->shared_from_this(), comparator, nullptr, std::move(scheduler), true);
+}
+
+std::shared_ptr<Observable> Observable::sorted(const ComparatorFunction &comparator, SchedulerPtr scheduler)
+{
+    return std::make_shared<ObservableSorted>(this->shared_from_this(), comparator, nullptr, std::move(scheduler), false);
+}
+
+std::shared_ptr<Observable> Observable::toSortedListBy(const MapFunction &keySelector, SchedulerPtr scheduler)
+{
+    return std::make_shared<ObservableSorted>(this->shared_from_this(), nullptr, keySelector, std::move(scheduler), true);
+}
+
+std::shared_ptr<Observable> Observable::sortedBy(const MapFunction &keySelector, SchedulerPtr scheduler)
+{
+    return std::make_shared<ObservableSorted>(this->shared_from_this(), nullptr, keySelector, std::move(scheduler), false);
+}
+
+std::shared_ptr<Observable> Observable::sortedExternal(const ComparatorFunction &comparator, uint64_t memoryBudget,
+                                                       const std::string &tmpDir, std::shared_ptr<SpillCodec> codec)
+{
+    if (memoryBudget == 0) {
+        throw GAnyException("SortedExternal memoryBudget must be greater than zero");
+    }
+    if (!codec) {
+        codec = std::make_shared<BinarySpillCodec>();
+    }
+    return std::make_shared<ObservableSortedExternal>(this->shared_from_this(), comparator, memoryBudget, tmpDir,
+                                                      std::move(codec));
+}
+
+std::shared_ptr<ConnectableObservable> Observable::publish()
+{
+    return std::make_shared<ObservablePublish>(this->shared_from_this());
+}
+
+std::shared_ptr<Observable> Observable::share()
+{
+    return publish()->refCount();
+}
+
+std::shared_ptr<ConnectableObservable> Observable::broadcast(uint64_t capacity, WaitStrategy waitStrategy,
+                                                             SchedulerPtr scheduler)
+{
+    if (capacity == 0) {
+        throw GAnyException("Broadcast capacity must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = NewThreadScheduler::create();
+    }
+    return std::make_shared<ObservableBroadcast>(this->shared_from_this(), capacity, waitStrategy, scheduler);
+}
+
+std::vector<std::shared_ptr<Observable> > Observable::balance(uint32_t n, BalanceStrategy strategy,
+                                                              SchedulerPtr scheduler, uint64_t capacity)
+{
+    if (n == 0) {
+        throw GAnyException("Balance rail count must be greater than zero");
+    }
+    if (capacity == 0) {
+        throw GAnyException("Balance capacity must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = NewThreadScheduler::create();
+    }
+    const auto parent = std::make_shared<BalanceParent>(this->shared_from_this(), n, strategy, scheduler, capacity);
+    std::vector<std::shared_ptr<Observable> > rails;
+    rails.reserve(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        rails.push_back(std::make_shared<ObservableBalanceRail>(parent, i));
+    }
+    return rails;
+}
+
+std::shared_ptr<ParallelObservable> Observable::parallel(uint32_t n, uint32_t batchSize)
+{
+    if (n == 0) {
+        throw GAnyException("Parallelism must be greater than zero");
+    }
+    if (batchSize == 0) {
+        throw GAnyException("Parallel batchSize must be greater than zero");
+    }
+    return std::make_shared<ParallelFrom>(this->shared_from_this(), n, batchSize);
+}
+
+std::shared_ptr<ParallelObservable> Observable::parallel(uint32_t n, SchedulerPtr scheduler, uint32_t batchSize)
+{
+    return parallel(n, batchSize)->runOn(std::move(scheduler));
+}
+
+std::shared_ptr<ConnectableObservable> Observable::replay()
+{
+    return std::make_shared<ObservableReplay>(this->shared_from_this(), [] {
+        return ReplaySubject::create();
+    });
+}
+
+std::shared_ptr<ConnectableObservable> Observable::replay(uint64_t bufferSize)
+{
+    if (bufferSize == 0) {
+        throw GAnyException("Replay bufferSize must be greater than zero");
+    }
+    return std::make_shared<ObservableReplay>(this->shared_from_this(), [bufferSize] {
+        return ReplaySubject::createWithSize(bufferSize);
+    });
+}
+
+std::shared_ptr<ConnectableObservable> Observable::replay(uint64_t time, SchedulerPtr scheduler)
+{
+    if (time == 0) {
+        throw GAnyException("Replay time must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableReplay>(this->shared_from_this(), [time, scheduler] {
+        return ReplaySubject::createWithTime(time, scheduler);
+    });
+}
+
+std::shared_ptr<ConnectableObservable> Observable::replay(uint64_t bufferSize, uint64_t time, SchedulerPtr scheduler)
+{
+    if (bufferSize == 0) {
+        throw GAnyException("Replay bufferSize must be greater than zero");
+    }
+    if (time == 0) {
+        throw GAnyException("Replay time must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableReplay>(this->shared_from_this(), [bufferSize, time, scheduler] {
+        return ReplaySubject::createWithTime(time, scheduler, bufferSize);
+    });
+}
+
+std::shared_ptr<Observable> Observable::cache()
+{
+    return replay()->autoConnect();
+}
+
+DisposablePtr ConnectableObservable::connect()
+{
+    DisposablePtr connection;
+    connect([&connection](const DisposablePtr &d) { connection = d; });
+    return connection;
+}
+
+std::shared_ptr<Observable> ConnectableObservable::refCount()
+{
+    return refCount(1, 0);
+}
+
+std::shared_ptr<Observable> ConnectableObservable::refCount(uint32_t minSubscribers, uint64_t gracePeriod,
+                                                            SchedulerPtr scheduler)
+{
+    if (minSubscribers == 0) {
+        throw GAnyException("RefCount minSubscribers must be greater than zero");
+    }
+    if (gracePeriod > 0 && !scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableRefCount>(
+        std::static_pointer_cast<ConnectableObservable>(this->shared_from_this()), minSubscribers, gracePeriod, scheduler);
+}
+
+std::shared_ptr<Observable> ConnectableObservable::autoConnect(uint32_t numberOfObservers)
+{
+    if (numberOfObservers == 0) {
+        throw GAnyException("AutoConnect numberOfObservers must be greater than zero");
+    }
+    return std::make_shared<ObservableAutoConnect>(
+        std::static_pointer_cast<ConnectableObservable>(this->shared_from_this()), numberOfObservers);
+}
+
+bool ParallelObservable::validate(const std::vector<RailObserverPtr> &rails) const
+{
+    if (rails.size() == parallelism()) {
+        return true;
+    }
+    const GAnyException e("ParallelObservable expects " + std::to_string(parallelism()) + " rails, got "
+                          + std::to_string(rails.size()));
+    for (const auto &rail: rails) {
+        rail->onSubscribe(DisposableHelper::disposed());
+        rail->onError(e);
+    }
+    return false;
+}
+
+std::shared_ptr<ParallelObservable> ParallelObservable::runOn(SchedulerPtr scheduler, uint64_t capacity)
+{
+    if (capacity == 0) {
+        throw GAnyException("ParallelObservable capacity must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = NewThreadScheduler::create();
+    }
+    return std::make_shared<ParallelRunOn>(this->shared_from_this(), scheduler, capacity);
+}
+
+std::shared_ptr<ParallelObservable> ParallelObservable::map(const MapFunction &function)
+{
+    return std::make_shared<ParallelMap>(this->shared_from_this(), function);
+}
+
+std::shared_ptr<ParallelObservable> ParallelObservable::filter(const FilterFunction &filter)
+{
+    return std::make_shared<ParallelFilter>(this->shared_from_this(), filter);
+}
+
+std::shared_ptr<Observable> ParallelObservable::reduce(const BiFunction &accumulator)
+{
+    return std::make_shared<ParallelReduce>(this->shared_from_this(), accumulator);
+}
+
+std::shared_ptr<Observable> ParallelObservable::sorted(const ComparatorFunction &comparator)
+{
+    return std::make_shared<ParallelSorted>(this->shared_from_this(), comparator);
+}
+
+std::shared_ptr<Observable> ParallelObservable::sequential(uint64_t capacity)
+{
+    if (capacity == 0) {
+        throw GAnyException("ParallelObservable capacity must be greater than zero");
+    }
+    return std::make_shared<ParallelJoin<ParallelJoinState> >(this->shared_from_this(), capacity);
+}
+
+std::shared_ptr<Observable> ParallelObservable::sequentialOrdered(uint64_t capacity)
+{
+    if (capacity == 0) {
+        throw GAnyException("ParallelObservable capacity must be greater than zero");
+    }
+    return std::make_shared<ParallelJoin<ParallelJoinOrderedState> >(this->shared_from_this(), capacity);
+}
+
+std::shared_ptr<Observable> Observable::toArrayView()
+{
+    return std::make_shared<ObservableToArray>(this->shared_from_this(), true);
+}
+
 std::shared_ptr<Observable> Observable::repeat(uint64_t times)
 {
     if (times == 0) {
@@ -316,6 +708,16 @@ std::shared_ptr<Observable> Observable::reduce(const BiFunction &accumulator)
     return std::make_shared<ObservableReduce>(this->shared_from_this(), accumulator);
 }
 
+std::shared_ptr<Observable> Observable::reduceParallel(const GAny &identity, const BiFunction &accumulator,
+                                                      const BiFunction &combiner, SchedulerPtr scheduler)
+{
+    if (!scheduler) {
+        scheduler = NewThreadScheduler::create();
+    }
+    return std::make_shared<ObservableReduceParallel>(this->shared_from_this(), identity, accumulator, combiner,
+                                                      scheduler);
+}
+
 
 std::shared_ptr<Observable> Observable::filter(const FilterFunction &filter)
 {
@@ -332,6 +734,14 @@ std::shared_ptr<Observable> Observable::distinct(const MapFunction &keySelector)
     return std::make_shared<ObservableDistinct>(this->shared_from_this(), keySelector);
 }
 
+std::shared_ptr<Observable> Observable::distinct(const MapFunction &keySelector, uint64_t maxKeys)
+{
+    if (maxKeys == 0) {
+        throw GAnyException("Distinct maxKeys must be greater than zero");
+    }
+    return std::make_shared<ObservableDistinct>(this->shared_from_this(), keySelector, maxKeys);
+}
+
 std::shared_ptr<Observable> Observable::distinctUntilChanged()
 {
     return std::make_shared<ObservableDistinctUntilChanged>(this->shared_from_this(), nullptr, nullptr);
@@ -403,6 +813,17 @@ std::shared_ptr<Observable> Observable::skipLast(uint64_t count)
     return std::make_shared<ObservableSkipLast>(this->shared_from_this(), count);
 }
 
+std::shared_ptr<Observable> Observable::skipLast(uint64_t time, SchedulerPtr scheduler)
+{
+    if (time == 0) {
+        return this->shared_from_this();
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableSkipLastTimed>(this->shared_from_this(), time, scheduler);
+}
+
 std::shared_ptr<Observable> Observable::take(uint64_t count)
 {
     return std::make_shared<ObservableTake>(this->shared_from_this(), count);
@@ -413,6 +834,14 @@ std::shared_ptr<Observable> Observable::takeLast(uint64_t count)
     return std::make_shared<ObservableTakeLast>(this->shared_from_this(), count);
 }
 
+std::shared_ptr<Observable> Observable::takeLast(uint64_t count, uint64_t time, SchedulerPtr scheduler)
+{
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableTakeLastTimed>(this->shared_from_this(), count, time, scheduler);
+}
+
 std::shared_ptr<Observable> Observable::takeUntil(const std::shared_ptr<Observable> &other)
 {
     return std::make_shared<ObservableTakeUntil>(shared_from_this(), other);
@@ -438,6 +867,26 @@ std::shared_ptr<Observable> Observable::groupBy(const MapFunction &keySelector,
     return std::make_shared<ObservableGroupBy>(shared_from_this(), keySelector, valueSelector);
 }
 
+std::shared_ptr<Observable> Observable::groupBy(const MapFunction &keySelector, const MapFunction &valueSelector, GroupOptions options)
+{
+    if (options.idleTimeout > 0 && !options.scheduler) {
+        options.scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableGroupBy>(shared_from_this(), keySelector, valueSelector, std::move(options));
+}
+
+std::shared_ptr<Observable> Observable::groupByParallel(const MapFunction &keySelector, SchedulerPtr scheduler,
+                                                       uint32_t parallelism)
+{
+    if (parallelism == 0) {
+        throw GAnyException("GroupByParallel parallelism must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = NewThreadScheduler::create();
+    }
+    return std::make_shared<ObservableGroupByParallel>(shared_from_this(), keySelector, scheduler, parallelism);
+}
+
 std::shared_ptr<Observable> Observable::window(int32_t count)
 {
     return window(count, count);
@@ -451,6 +900,28 @@ std::shared_ptr<Observable> Observable::window(int32_t count, int32_t skip)
     return std::make_shared<ObservableWindow>(shared_from_this(), count, skip);
 }
 
+std::shared_ptr<Observable> Observable::windowTimed(uint64_t timespan, uint64_t maxCount, SchedulerPtr scheduler)
+{
+    if (timespan == 0) {
+        throw GAnyException("Window timespan must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableWindowTimed>(this->shared_from_this(), timespan, 0, maxCount, scheduler);
+}
+
+std::shared_ptr<Observable> Observable::windowTimedSkip(uint64_t timespan, uint64_t timeskip, SchedulerPtr scheduler)
+{
+    if (timespan == 0 || timeskip == 0) {
+        throw GAnyException("Window timespan and timeskip must be greater than zero");
+    }
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableWindowTimed>(this->shared_from_this(), timespan, timeskip, 0, scheduler);
+}
+
 std::shared_ptr<Observable> Observable::timeout(uint64_t timeout, SchedulerPtr scheduler, const std::shared_ptr<Observable> &fallback)
 {
     if (!scheduler) {
@@ -502,6 +973,47 @@ std::shared_ptr<Observable> Observable::join(const std::shared_ptr<Observable> &
     );
 }
 
+std::shared_ptr<Observable> Observable::joinOnKey(const std::shared_ptr<Observable> &other,
+                                                  const MapFunction &leftKeySelector,
+                                                  const MapFunction &rightKeySelector,
+                                                  const FlatMapFunction &leftDurationSelector,
+                                                  const FlatMapFunction &rightDurationSelector,
+                                                  const BiFunction &resultSelector)
+{
+    return std::make_shared<ObservableJoinOnKey>(
+        this->shared_from_this(),
+        other,
+        leftKeySelector,
+        rightKeySelector,
+        leftDurationSelector,
+        rightDurationSelector,
+        resultSelector
+    );
+}
+
+std::shared_ptr<Observable> Observable::joinOnKey(const std::shared_ptr<Observable> &other,
+                                                  const MapFunction &leftKeySelector,
+                                                  const MapFunction &rightKeySelector,
+                                                  uint64_t leftWindow,
+                                                  uint64_t rightWindow,
+                                                  const BiFunction &resultSelector,
+                                                  SchedulerPtr scheduler)
+{
+    if (!scheduler) {
+        scheduler = MainThreadScheduler::create();
+    }
+    return std::make_shared<ObservableJoinOnKey>(
+        this->shared_from_this(),
+        other,
+        leftKeySelector,
+        rightKeySelector,
+        leftWindow,
+        rightWindow,
+        resultSelector,
+        scheduler
+    );
+}
+
 std::shared_ptr<Observable> Observable::startWith(const GAny &item)
 {
     return std::make_shared<ObservableStartWith>(shared_from_this(), std::vector<GAny>{item});
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "support/test_observer.h"
+#include "support/test_scheduler.h"
 
 #include <rx/disposables/atomic_disposable.h>
 #include <rx/disposables/disposable_helper.h>
@@ -11,9 +12,11 @@
 #include <atomic>
 #include <barrier>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace
@@ -111,6 +114,14 @@ protected:
 private:
     int32_t &mDestructionCount;
 };
+
+// An operator that ends on its own, drive() pushes the signals that make it end after the observer subscribed
+struct TerminatingOperator
+{
+    const char *name;
+    std::shared_ptr<Observable> source;
+    std::function<void()> drive = nullptr;
+};
 } // namespace
 
 TEST(ObservableLifetimeTest, BasePointerUsesTheVirtualDestructor)
@@ -467,3 +478,81 @@ TEST(SequentialDisposableTest, ConcurrentUpdatesDisposeEveryCandidateExactlyOnce
         EXPECT_EQ(candidate->disposeCount(), 1);
     }
 }
+
+TEST(DisposableContractTest, SelfTerminatingOperatorsStayUndisposedThroughTheirTerminal)
+{
+    // doOnComplete() asks its upstream isDisposed() before forwarding, so an operator that reported its own
+    // terminal as a disposal would swallow it
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto add = [](const GAny &a, const GAny &b) { return GAny(a.toInt64() + b.toInt64()); };
+    const auto never = [](const GAny &) { return Observable::never(); };
+    const auto lastDigit = [](const GAny &value) { return GAny(value.toInt64() % 10); };
+    const auto published = Observable::range(1, 3)->publish();
+    const auto replayed = Observable::range(1, 3)->replay();
+    const auto boundedReplay = Observable::range(1, 3)->replay(2);
+    // Late observers of these two get the recorded values and the terminal from the buffer
+    const auto cached = Observable::range(1, 3)->cache();
+    cached->subscribe(std::make_shared<TestObserver>());
+    const auto completedReplay = ReplaySubject::create();
+    completedReplay->onNext(1);
+    completedReplay->onComplete();
+
+    std::vector<TerminatingOperator> operators{
+        {"zip", Observable::zip(Observable::just(1), Observable::just(2), add)},
+        {"combineLatest", Observable::combineLatest(Observable::just(1), Observable::just(2), add)},
+        {"combineLatest coalesced", Observable::combineLatestArray(
+             {Observable::just(1), Observable::just(2)},
+             [](const std::vector<GAny> &latest) { return GAny(latest[0].toInt64() + latest[1].toInt64()); },
+             CombineOptions{true})},
+        {"join", Observable::just(1)->join(Observable::just(10), never, never, add)},
+        {"joinOnKey", Observable::just(1)->joinOnKey(Observable::just(11), lastDigit, lastDigit, never, never, add)},
+        {"window", Observable::range(1, 3)->window(2)},
+        {"bufferTimed", Observable::range(1, 10)->bufferTimed(100, 0, scheduler)},
+        {"bufferTimedSkip", Observable::range(1, 3)->bufferTimedSkip(100, 50, scheduler)},
+        {"windowTimed", Observable::range(1, 3)->windowTimed(100, 0, scheduler)},
+        {"windowTimedSkip", Observable::range(1, 3)->windowTimedSkip(100, 50, scheduler)},
+        {"publish", published, [published] { published->connect(); }},
+        {"refCount", Observable::range(1, 3)->publish()->refCount()},
+        {"share", Observable::range(1, 3)->share()},
+        {"replay", replayed, [replayed] { replayed->connect(); }},
+        {"bounded replay", boundedReplay, [boundedReplay] { boundedReplay->connect(); }},
+        {"cache", Observable::range(1, 3)->cache()},
+        {"cache, late observer", cached},
+        {"completed ReplaySubject", completedReplay},
+        {"mapAsync", Observable::range(0, 2)->mapAsync([](const GAny &v) { return v; }, scheduler, 2)},
+        {"balance", Observable::range(0, 3)->balance(1, BalanceStrategy::RoundRobin, scheduler)[0]},
+        {"reduceParallel", Observable::range(1, 4)->reduceParallel(0, add, add, scheduler)},
+        {"sequential", Observable::range(1, 6)->parallel(2)->sequential()},
+        {"sequentialOrdered", Observable::range(1, 6)->parallel(2)->sequentialOrdered()},
+        {"parallel sorted", Observable::range(1, 6)->parallel(2)->sorted()},
+        {"parallel reduce", Observable::range(1, 6)->parallel(2)->reduce(add)},
+    };
+    const std::vector<std::pair<const char *, std::shared_ptr<Subject> > > subjects{
+        {"PublishSubject", PublishSubject::create()},
+        {"BehaviorSubject", BehaviorSubject::create()},
+        {"ReplaySubject", ReplaySubject::create()},
+        {"AsyncSubject", AsyncSubject::create()},
+        {"UnicastSubject", UnicastSubject::create()},
+    };
+    for (const auto &entry: subjects) {
+        const auto subject = entry.second;
+        operators.push_back({entry.first, subject, [subject] {
+            subject->onNext(1);
+            subject->onComplete();
+        }});
+    }
+
+    for (const auto &op: operators) {
+        SCOPED_TRACE(op.name);
+        int32_t completions = 0;
+        const auto observer = std::make_shared<TestObserver>();
+        op.source->doOnComplete([&completions] { ++completions; })->subscribe(observer);
+        if (op.drive) {
+            op.drive();
+        }
+        scheduler->runUntilIdle();
+        EXPECT_FALSE(observer->values().empty());
+        observer->expectComplete();
+        EXPECT_EQ(completions, 1);
+    }
+}
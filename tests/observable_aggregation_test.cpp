@@ -1,11 +1,20 @@
 #include <gtest/gtest.h>
 
 #include "support/test_observer.h"
+#include "support/bounded_wait.h"
+#include "support/test_scheduler.h"
 
 #include <rx/rx.h>
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -31,6 +40,24 @@ public:
         disposable->dispose();
     }
 };
+
+// Keeps every worker it hands out, onCreate runs before each one is created
+class RecordingScheduler : public TestScheduler
+{
+public:
+    WorkerPtr createWorker() override
+    {
+        if (onCreate) {
+            onCreate(workers.size());
+        }
+        workers.push_back(TestScheduler::createWorker());
+        return workers.back();
+    }
+
+public:
+    std::function<void(size_t)> onCreate;
+    std::vector<WorkerPtr> workers;
+};
 } // namespace
 
 TEST(ObservableScanTest, EmitsRunningAccumulation)
@@ -113,6 +140,144 @@ TEST(ObservableReduceTest, ConvertsAccumulatorExceptionAndForwardsUpstreamError)
     upstreamObserver->expectErrorContains("upstream failure");
 }
 
+TEST(ObservableReduceParallelTest, FoldsSizedSourcesInChunksAndFallsBackForOthers)
+{
+    const auto sum = [](const GAny &a, const GAny &b) { return GAny(a.toInt64() + b.toInt64()); };
+    const auto scheduler = std::make_shared<TestScheduler>();
+
+    // Large enough for several chunks
+    const auto rangeObserver = std::make_shared<TestObserver>();
+    Observable::range(1, 100000)->reduceParallel(0, sum, sum, scheduler)->subscribe(rangeObserver);
+    rangeObserver->expectNotTerminated();
+    scheduler->runUntilIdle();
+    rangeObserver->expectInt64Values({5000050000});
+    rangeObserver->expectComplete();
+
+    const auto emptyObserver = std::make_shared<TestObserver>();
+    Observable::fromArray(std::vector<GAny>{})->reduceParallel(0, sum, sum, scheduler)->subscribe(emptyObserver);
+    emptyObserver->expectInt64Values({0});
+    emptyObserver->expectComplete();
+
+    const auto failedObserver = std::make_shared<TestObserver>();
+    Observable::range(0, 100000)
+        ->reduceParallel(0, [](const GAny &a, const GAny &b) -> GAny {
+            if (b.toInt64() == 70000) {
+                throw std::runtime_error("accumulator failure");
+            }
+            return a.toInt64() + b.toInt64();
+        }, sum, scheduler)
+        ->subscribe(failedObserver);
+    scheduler->runUntilIdle();
+    failedObserver->expectErrorContains("accumulator failure");
+
+    // A source of unknown size is folded sequentially from identity
+    const auto subject = PublishSubject::create();
+    const auto fallbackObserver = std::make_shared<TestObserver>();
+    subject->reduceParallel(100, sum, sum, scheduler)->subscribe(fallbackObserver);
+    subject->onNext(1);
+    subject->onNext(2);
+    subject->onComplete();
+    fallbackObserver->expectInt64Values({103});
+    fallbackObserver->expectComplete();
+}
+
+TEST(ObservableReduceParallelTest, DisposeBeforeOrDuringStartLeavesNoWorkerBehind)
+{
+    const auto sum = [](const GAny &a, const GAny &b) { return GAny(a.toInt64() + b.toInt64()); };
+
+    // Disposed in onSubscribe(), start() creates no workers at all
+    const auto early = std::make_shared<RecordingScheduler>();
+    const auto earlyObserver = std::make_shared<DisposeOnSubscribeObserver>();
+    Observable::range(1, 100000)->reduceParallel(0, sum, sum, early)->subscribe(earlyObserver);
+    EXPECT_TRUE(early->workers.empty());
+    earlyObserver->expectNotTerminated();
+
+    // Disposed while start() creates the workers, every one of them ends up disposed
+    const auto during = std::make_shared<RecordingScheduler>();
+    const auto duringObserver = std::make_shared<TestObserver>();
+    during->onCreate = [duringObserver](size_t created) {
+        if (created == 0) {
+            duringObserver->dispose();
+        }
+    };
+    Observable::range(1, 100000)->reduceParallel(0, sum, sum, during)->subscribe(duringObserver);
+    ASSERT_FALSE(during->workers.empty());
+    for (const auto &worker: during->workers) {
+        EXPECT_TRUE(worker->isDisposed());
+    }
+    during->runUntilIdle();
+    duringObserver->expectNotTerminated();
+}
+
+TEST(ObservableReduceParallelTest, ChunksRunOnSeveralThreads)
+{
+    GTaskSystem taskSystem("ObservableReduceParallelTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    std::vector<GAny> items;
+    for (int64_t i = 0; i < 300000; ++i) {
+        items.emplace_back(i % 7);
+    }
+    const auto observer = std::make_shared<TestObserver>();
+    const auto sum = [](const GAny &a, const GAny &b) { return GAny(a.toInt64() + b.toInt64()); };
+    Observable::fromArray(std::move(items))->reduceParallel(0, sum, sum, scheduler)->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+    observer->expectInt64Values({899997});
+    observer->expectComplete();
+
+    taskSystem.stopAndWait();
+}
+
+TEST(ObservableReduceParallelTest, DefaultSchedulerFoldsChunksOffTheSubscribingThread)
+{
+    ScopedGlobalTimerScheduler timerScope("ObservableReduceParallelDefaultTest");
+    std::thread timerThread([timerScheduler = timerScope.scheduler()] {
+        timerScheduler->run();
+    });
+
+    auto items = std::make_shared<std::vector<GAny> >();
+    for (int64_t i = 0; i < 300000; ++i) {
+        items->emplace_back(i % 7);
+    }
+    const std::weak_ptr<std::vector<GAny> > weakItems = items;
+    std::mutex lock;
+    std::set<std::thread::id> threads;
+    const auto observer = std::make_shared<TestObserver>();
+    const auto sum = [&lock, &threads](const GAny &a, const GAny &b) {
+        {
+            std::lock_guard guard(lock);
+            threads.insert(std::this_thread::get_id());
+        }
+        return GAny(a.toInt64() + b.toInt64());
+    };
+    Observable::fromIterable(std::move(items))->reduceParallel(0, sum, sum)->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000))) << observer->describe();
+    observer->expectInt64Values({899997});
+    observer->expectComplete();
+    {
+        std::lock_guard guard(lock);
+        EXPECT_EQ(threads.count(std::this_thread::get_id()), 0u);
+        if (std::thread::hardware_concurrency() > 1) {
+            EXPECT_GT(threads.size(), 1u);
+        }
+    }
+
+    // The last worker drops the coordinator, its workers and then the source just after the result.
+    // Dropped workers stop their threads from the timer thread, so wait for both before the leak check
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!weakItems.expired() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(weakItems.expired());
+    BoundedWait stopped;
+    timerScope.scheduler()->post([&stopped] { stopped.signal(); }, 0);
+    EXPECT_TRUE(stopped.await(std::chrono::milliseconds(1000)));
+
+    timerScope.scheduler()->stop();
+    timerThread.join();
+}
+
 TEST(ObservableAllTest, CoversTrueFalseEmptyAndPredicateException)
 {
     const auto allTrue = std::make_shared<TestObserver>();
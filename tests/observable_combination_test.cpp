@@ -2,6 +2,7 @@
 
 #include "support/bounded_wait.h"
 #include "support/test_observer.h"
+#include "support/test_scheduler.h"
 
 #include <rx/rx.h>
 #include <rx/disposables/atomic_disposable.h>
@@ -313,6 +314,65 @@ TEST(ObservableCombineLatestTest, ArrayUsesLatestValuesUntilAllSourcesComplete)
     observer->expectComplete();
 }
 
+TEST(ObservableCombineLatestTest, CoalescingModeCombinesOncePerBatchOfUpdates)
+{
+    ManualSource first;
+    ManualSource second;
+    int32_t combinations = 0;
+    std::vector<int64_t> values;
+    int32_t completions = 0;
+    Observable::combineLatestArray(
+        {first.observable, second.observable},
+        [&combinations](const std::vector<GAny> &latest) {
+            ++combinations;
+            return latest[0].toInt64() + latest[1].toInt64();
+        },
+        CombineOptions{true})
+        ->subscribe(
+            [&first, &values](const GAny &value) {
+                values.push_back(value.toInt64());
+                if (values.size() == 1) {
+                    // Updates arriving while the drain is emitting are folded into one combination
+                    first.emitter->onNext(2);
+                    first.emitter->onNext(3);
+                    first.emitter->onNext(4);
+                }
+            },
+            [](const GAnyException &) { FAIL() << "coalesced combineLatest must not fail"; },
+            [&completions] { ++completions; });
+
+    first.emitter->onNext(1);
+    second.emitter->onNext(10);
+    second.emitter->onNext(20);
+    first.emitter->onComplete();
+    second.emitter->onComplete();
+
+    EXPECT_EQ(values, std::vector<int64_t>({11, 14, 24}));
+    EXPECT_EQ(combinations, 3);
+    EXPECT_EQ(completions, 1);
+
+    ManualSource failingFirst;
+    ManualSource failingSecond;
+    const auto errorObserver = std::make_shared<TestObserver>();
+    Observable::combineLatestArray(
+        {failingFirst.observable, failingSecond.observable},
+        [](const std::vector<GAny> &) -> GAny { throw std::runtime_error("coalesced failure"); },
+        CombineOptions{true})
+        ->subscribe(errorObserver);
+    failingFirst.emitter->onNext(1);
+    failingSecond.emitter->onNext(2);
+    errorObserver->expectErrorContains("coalesced failure");
+    EXPECT_TRUE(failingFirst.disposable->isDisposed());
+    EXPECT_TRUE(failingSecond.disposable->isDisposed());
+
+    const auto emptyObserver = std::make_shared<TestObserver>();
+    Observable::combineLatestArray({Observable::empty(), Observable::never()},
+                                   [](const std::vector<GAny> &) { return GAny(); },
+                                   CombineOptions{true})
+        ->subscribe(emptyObserver);
+    emptyObserver->expectComplete();
+}
+
 TEST(ObservableCombineLatestTest, EmptyOrErroredSourceTerminatesAndCancelsPeers)
 {
     ManualSource other;
@@ -405,6 +465,272 @@ TEST(ObservableTakeUntilTest, PropagatesEitherErrorAndCancelsBothSources)
     disposedObserver->expectNotTerminated();
 }
 
+TEST(ObservableZipTest, BoundedBuffersDropOrFailOnOverflow)
+{
+    const auto sum = [](const std::vector<GAny> &values) {
+        return values[0].toInt64() + values[1].toInt64();
+    };
+
+    ManualSource droppingFirst;
+    ManualSource droppingSecond;
+    const auto dropping = std::make_shared<TestObserver>();
+    Observable::zipArray({droppingFirst.observable, droppingSecond.observable}, sum, 2, OverflowStrategy::DropLatest)
+        ->subscribe(dropping);
+    droppingFirst.emitter->onNext(1);
+    droppingFirst.emitter->onNext(2);
+    droppingFirst.emitter->onNext(3);
+    droppingSecond.emitter->onNext(10);
+    droppingSecond.emitter->onNext(20);
+    droppingSecond.emitter->onNext(30);
+    dropping->expectInt64Values({11, 22});
+    dropping->expectNotTerminated();
+    dropping->dispose();
+
+    ManualSource failingFirst;
+    ManualSource failingSecond;
+    const auto failing = std::make_shared<TestObserver>();
+    Observable::zipArray({failingFirst.observable, failingSecond.observable}, sum, 2)
+        ->subscribe(failing);
+    failingFirst.emitter->onNext(1);
+    failingFirst.emitter->onNext(2);
+    failingFirst.emitter->onNext(3);
+    failing->expectErrorContains("capacity");
+    EXPECT_TRUE(failingFirst.disposable->isDisposed());
+    EXPECT_TRUE(failingSecond.disposable->isDisposed());
+
+    EXPECT_THROW(Observable::zipArray({droppingFirst.observable}, sum, 0), GAnyException);
+    EXPECT_THROW(Observable::zipArray({droppingFirst.observable}, sum, 1, OverflowStrategy::Block), GAnyException);
+}
+
+TEST(ObservableZipTest, ConcurrentSourcesProduceEveryRowInOrder)
+{
+    constexpr int64_t count = 10000;
+    ManualSource first;
+    ManualSource second;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::zip(first.observable, second.observable,
+                    [](const GAny &left, const GAny &right) {
+                        return left.toInt64() * 2 - right.toInt64();
+                    })
+        ->subscribe(observer);
+
+    const auto start = std::make_shared<std::barrier<> >(3);
+    const auto finished = std::make_shared<BoundedWait>(2);
+    const auto produce = [start, finished](const ObservableEmitterPtr &emitter) {
+        start->arrive_and_wait();
+        for (int64_t i = 0; i < count; ++i) {
+            emitter->onNext(i);
+        }
+        emitter->onComplete();
+        finished->signal();
+    };
+    std::thread firstThread(produce, first.emitter);
+    std::thread secondThread(produce, second.emitter);
+    start->arrive_and_wait();
+
+    if (!finished->await(std::chrono::seconds(5))) {
+        firstThread.detach();
+        secondThread.detach();
+        FAIL() << "concurrent zip timed out";
+        return;
+    }
+    firstThread.join();
+    secondThread.join();
+
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < count; ++i) {
+        expected.push_back(i);
+    }
+    observer->expectInt64Values(expected);
+    observer->expectComplete();
+}
+
+TEST(ObservableMergeSortedTest, EmitsTheSmallestHeadOnceEveryLiveSourceHasOne)
+{
+    ManualSource first;
+    ManualSource second;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::mergeSorted({first.observable, second.observable})->subscribe(observer);
+    first.emitter->onNext(1);
+    first.emitter->onNext(5);
+    observer->expectInt64Values({});
+    second.emitter->onNext(2);
+    observer->expectInt64Values({1, 2});
+    second.emitter->onComplete();
+    observer->expectInt64Values({1, 2, 5});
+    first.emitter->onNext(7);
+    first.emitter->onComplete();
+    observer->expectInt64Values({1, 2, 5, 7});
+    observer->expectComplete();
+
+    // Synchronous sources are buffered until the later ones catch up, ties go to the earlier source
+    const auto synchronous = std::make_shared<TestObserver>();
+    Observable::mergeSorted({Observable::just(9, 6, 3), Observable::just(8, 6, 2), Observable::empty()},
+                            [](const GAny &a, const GAny &b) { return a.toInt64() > b.toInt64(); })
+        ->subscribe(synchronous);
+    synchronous->expectInt64Values({9, 8, 6, 6, 3, 2});
+    synchronous->expectComplete();
+
+    // A prefetch does not hold back values emitted while the sources are being subscribed
+    const auto synchronousPrefetch = std::make_shared<TestObserver>();
+    Observable::mergeSorted({Observable::just(1, 3, 5, 7), Observable::just(2, 4)}, nullptr, 1)
+        ->subscribe(synchronousPrefetch);
+    synchronousPrefetch->expectInt64Values({1, 2, 3, 4, 5, 7});
+    synchronousPrefetch->expectComplete();
+
+    // With a prefetch, a source that runs that far ahead fails the stream, DropLatest discards its value instead
+    ManualSource overflowingFirst;
+    ManualSource overflowingSecond;
+    const auto overflowed = std::make_shared<TestObserver>();
+    Observable::mergeSorted({overflowingFirst.observable, overflowingSecond.observable}, nullptr, 2)
+        ->subscribe(overflowed);
+    ManualSource droppingFirst;
+    ManualSource droppingSecond;
+    const auto dropped = std::make_shared<TestObserver>();
+    Observable::mergeSorted({droppingFirst.observable, droppingSecond.observable}, nullptr, 2,
+                            OverflowStrategy::DropLatest)
+        ->subscribe(dropped);
+    // The head taken into the heap no longer counts against the queue
+    for (int64_t i = 1; i <= 4; ++i) {
+        overflowingFirst.emitter->onNext(i);
+        droppingFirst.emitter->onNext(i);
+    }
+    overflowed->expectErrorContains("prefetch of 2");
+    EXPECT_TRUE(overflowingSecond.disposable->isDisposed());
+    droppingSecond.emitter->onNext(0);
+    droppingSecond.emitter->onComplete();
+    droppingFirst.emitter->onComplete();
+    dropped->expectInt64Values({0, 1, 2, 3});
+    dropped->expectComplete();
+
+    // With Block, a source that runs a prefetch ahead waits on its thread until the merge takes a value from it
+    ManualSource fastFirst;
+    ManualSource slowSecond;
+    const auto heldBack = std::make_shared<TestObserver>();
+    Observable::mergeSorted({fastFirst.observable, slowSecond.observable}, nullptr, 2, OverflowStrategy::Block)
+        ->subscribe(heldBack);
+    std::atomic<int64_t> offered = 0;
+    std::thread fastThread([&fastFirst, &offered] {
+        for (int64_t i = 1; i <= 4; ++i) {
+            fastFirst.emitter->onNext(i);
+            offered.store(i);
+        }
+        fastFirst.emitter->onComplete();
+    });
+    while (offered.load() < 3) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(offered.load(), 3);
+    heldBack->expectInt64Values({});
+    slowSecond.emitter->onNext(0);
+    slowSecond.emitter->onComplete();
+    fastThread.join();
+    heldBack->expectInt64Values({0, 1, 2, 3, 4});
+    heldBack->expectComplete();
+
+    // Disposing releases a source that is held back
+    ManualSource parkedFirst;
+    ManualSource idleSecond;
+    const auto disposed = std::make_shared<TestObserver>();
+    Observable::mergeSorted({parkedFirst.observable, idleSecond.observable}, nullptr, 1, OverflowStrategy::Block)
+        ->subscribe(disposed);
+    std::thread parkedThread([&parkedFirst] {
+        for (int64_t i = 1; i <= 3; ++i) {
+            parkedFirst.emitter->onNext(i);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    disposed->dispose();
+    parkedThread.join();
+    disposed->expectInt64Values({});
+    EXPECT_TRUE(parkedFirst.disposable->isDisposed());
+
+    const auto failed = std::make_shared<TestObserver>();
+    Observable::mergeSorted({Observable::just(1), Observable::just(2)},
+                            [](const GAny &, const GAny &) -> bool { throw std::runtime_error("comparator failure"); })
+        ->subscribe(failed);
+    failed->expectErrorContains("comparator failure");
+}
+
+TEST(ObservableMergeSortedTest, ConcurrentSourcesMergeInGlobalOrder)
+{
+    constexpr int64_t count = 10000;
+    ManualSource even;
+    ManualSource odd;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::mergeSorted({even.observable, odd.observable}, nullptr, 64, OverflowStrategy::Block)->subscribe(observer);
+
+    const auto start = std::make_shared<std::barrier<> >(3);
+    const auto finished = std::make_shared<BoundedWait>(2);
+    // Neither producer waits for the other, the prefetch holds back whichever runs ahead
+    const auto produce = [start, finished](const ObservableEmitterPtr &emitter, int64_t offset) {
+        start->arrive_and_wait();
+        for (int64_t i = 0; i < count; ++i) {
+            emitter->onNext(i * 2 + offset);
+        }
+        emitter->onComplete();
+        finished->signal();
+    };
+    std::thread evenThread(produce, even.emitter, 0);
+    std::thread oddThread(produce, odd.emitter, 1);
+    start->arrive_and_wait();
+
+    if (!finished->await(std::chrono::seconds(5))) {
+        evenThread.detach();
+        oddThread.detach();
+        FAIL() << "concurrent mergeSorted timed out";
+        return;
+    }
+    evenThread.join();
+    oddThread.join();
+    // The last drain may still be running on the other producer thread
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < count * 2; ++i) {
+        expected.push_back(i);
+    }
+    observer->expectInt64Values(expected);
+    observer->expectComplete();
+}
+
+TEST(ObservableMergeSortedTest, SourcesSharingAThreadMergeByDefault)
+{
+    ScopedGlobalTimerScheduler timerScope("ObservableMergeSortedTest");
+    std::thread timerThread([timerScheduler = timerScope.scheduler()] {
+        timerScheduler->run();
+    });
+
+    // Both chunked ranges emit on the one timer thread, so each chunk of 10 runs ahead of the other source.
+    // The default unbounded queues buffer the skew and the merge stays ordered.
+    const auto merged = std::make_shared<TestObserver>();
+    Observable::mergeSorted({Observable::range(0, 100, MainThreadScheduler::create(), 10),
+                             Observable::range(0, 100, MainThreadScheduler::create(), 10)})
+        ->subscribe(merged);
+    ASSERT_TRUE(merged->awaitTerminal(std::chrono::milliseconds(5000)));
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 100; ++i) {
+        expected.push_back(i);
+        expected.push_back(i);
+    }
+    merged->expectInt64Values(expected);
+    merged->expectComplete();
+
+    // An opt-in prefetch of 4 is overrun by a chunk before the other source gets to run. Blocking there would
+    // park the only thread that can feed the other source, Error fails instead of hanging.
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::mergeSorted({Observable::range(0, 100, MainThreadScheduler::create(), 10),
+                             Observable::range(0, 100, MainThreadScheduler::create(), 10)},
+                            nullptr, 4)
+        ->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+    observer->expectErrorContains("prefetch of 4");
+
+    timerScope.scheduler()->stop();
+    timerThread.join();
+}
+
 TEST(ObservableJoinTest, MatchesValuesWhileBothDurationsRemainOpen)
 {
     const auto observer = std::make_shared<TestObserver>();
@@ -533,6 +859,75 @@ TEST(ObservableJoinTest, DurationClosureExcludesOldValuesAndDurationErrorDispose
     EXPECT_TRUE(failingDuration.disposable->isDisposed());
 }
 
+TEST(ObservableJoinOnKeyTest, PairsOnlyMatchingKeysAndHonorsDurationClosure)
+{
+    ManualSource left;
+    ManualSource right;
+    ManualSource firstDuration;
+    int32_t leftValues = 0;
+    const auto observer = std::make_shared<TestObserver>();
+    left.observable
+        ->joinOnKey(right.observable,
+                    [](const GAny &value) { return value.toInt64() % 10; },
+                    [](const GAny &value) { return value.toInt64() % 10; },
+                    [&firstDuration, &leftValues](const GAny &) {
+                        return leftValues++ == 0 ? firstDuration.observable : Observable::never();
+                    },
+                    [](const GAny &) { return Observable::never(); },
+                    [](const GAny &leftValue, const GAny &rightValue) {
+                        return leftValue.toInt64() * 100 + rightValue.toInt64();
+                    })
+        ->subscribe(observer);
+
+    left.emitter->onNext(1);
+    left.emitter->onNext(2);
+    right.emitter->onNext(11);
+    right.emitter->onNext(12);
+    ASSERT_NE(firstDuration.emitter, nullptr);
+    firstDuration.emitter->onComplete();
+    right.emitter->onNext(21);
+    left.emitter->onNext(31);
+    left.emitter->onComplete();
+    right.emitter->onComplete();
+
+    observer->expectInt64Values({111, 212, 3111, 3121});
+    observer->expectComplete();
+}
+
+TEST(ObservableJoinOnKeyTest, IntervalWindowsExpireByDeadline)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ManualSource left;
+    ManualSource right;
+    const auto observer = std::make_shared<TestObserver>();
+    left.observable
+        ->joinOnKey(right.observable,
+                    [](const GAny &value) { return value.toInt64() % 10; },
+                    [](const GAny &value) { return value.toInt64() % 10; },
+                    100,
+                    0,
+                    [](const GAny &leftValue, const GAny &rightValue) {
+                        return leftValue.toInt64() * 100 + rightValue.toInt64();
+                    },
+                    scheduler)
+        ->subscribe(observer);
+
+    left.emitter->onNext(1);
+    scheduler->advanceBy(50);
+    left.emitter->onNext(11);
+    right.emitter->onNext(21);
+    scheduler->advanceBy(60);
+    right.emitter->onNext(31);
+    scheduler->advanceBy(50);
+    right.emitter->onNext(41);
+
+    observer->expectInt64Values({121, 1121, 1131});
+    observer->dispose();
+    EXPECT_TRUE(left.disposable->isDisposed());
+    EXPECT_TRUE(right.disposable->isDisposed());
+    observer->expectNotTerminated();
+}
+
 TEST(ObservableSequenceEqualTest, CoversEqualDifferentLengthAndComparatorFailure)
 {
     const auto equal = std::make_shared<TestObserver>();
@@ -640,6 +1035,15 @@ TEST(ObservableCombinationRegressionTest, ZipCompletesWhenEmptySourceEnds)
             [&completionCount] { ++completionCount; });
 
     EXPECT_EQ(completionCount, 1);
+
+    Observable::zip(Observable::never(), Observable::empty(),
+                    [](const GAny &, const GAny &) { return GAny(); })
+        ->subscribe(
+            [](const GAny &) { FAIL() << "zip(never, empty) must not emit"; },
+            [](const GAnyException &) { FAIL() << "zip(never, empty) must not fail"; },
+            [&completionCount] { ++completionCount; });
+
+    EXPECT_EQ(completionCount, 2);
 }
 
 TEST(ObservableCombinationRegressionTest, ZipAllowsDisposalFromOnNext)
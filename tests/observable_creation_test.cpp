@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 
 #include "support/test_observer.h"
+#include "support/test_scheduler.h"
 
 #include <rx/rx.h>
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -90,6 +92,86 @@ TEST(ObservableFromArrayTest, StopsImmediatelyWhenDisposedOnSubscribe)
     observer->expectNotTerminated();
 }
 
+TEST(ObservableScheduledSourceTest, ChunkedRangeAndArrayTakeTurnsOnOneWorker)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    std::vector<int64_t> order;
+    const auto record = [&order](const GAny &value) { order.push_back(value.toInt64()); };
+    const auto range = std::make_shared<TestObserver>();
+    const auto array = std::make_shared<TestObserver>();
+
+    Observable::range(0, 5, scheduler, 2)->doOnNext(record)->subscribe(range);
+    Observable::fromArray({100, 101, 102, 103, 104}, scheduler, 2)->doOnNext(record)->subscribe(array);
+    EXPECT_TRUE(order.empty());
+
+    scheduler->runUntilIdle();
+    EXPECT_EQ(order, std::vector<int64_t>({0, 1, 100, 101, 2, 3, 102, 103, 4, 104}));
+    range->expectComplete();
+    array->expectComplete();
+
+    EXPECT_THROW(Observable::range(0, 5, scheduler, 0), GAnyException);
+    EXPECT_THROW(Observable::fromArray({1}, scheduler, 0), GAnyException);
+}
+
+TEST(ObservableScheduledSourceTest, ChunkedRangeStopsOnceDisposed)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    std::vector<int64_t> values;
+    DisposablePtr subscription;
+    bool terminated = false;
+    Observable::range(0, 10, scheduler, 3)->subscribe(std::make_shared<LambdaObserver>(
+        [&values, &subscription](const GAny &value) {
+            values.push_back(value.toInt64());
+            if (values.size() == 4) {
+                subscription->dispose();
+            }
+        },
+        [&terminated](const GAnyException &) { terminated = true; },
+        [&terminated] { terminated = true; },
+        [&subscription](const DisposablePtr &d) { subscription = d; }));
+
+    scheduler->runUntilIdle();
+    EXPECT_EQ(values, std::vector<int64_t>({0, 1, 2, 3}));
+    EXPECT_FALSE(terminated);
+}
+
+TEST(ObservableFromIterableTest, SharesStorageAcrossSubscribersWithoutCopying)
+{
+    const auto items = std::make_shared<const std::vector<GAny> >(std::vector<GAny>{1, 2, 3});
+    const auto source = Observable::fromIterable(items);
+    const auto storageUsers = items.use_count();
+
+    for (int32_t i = 0; i < 2; ++i) {
+        const auto observer = std::make_shared<TestObserver>();
+        source->subscribe(observer);
+        observer->expectInt64Values({1, 2, 3});
+        observer->expectComplete();
+    }
+    EXPECT_EQ(items.use_count(), storageUsers);
+
+    const auto emptyObserver = std::make_shared<TestObserver>();
+    Observable::fromIterable(nullptr)->subscribe(emptyObserver);
+    emptyObserver->expectInt64Values({});
+    emptyObserver->expectComplete();
+}
+
+TEST(ObservableFromIterableTest, KeepsSpanOwnerAliveUntilSourceIsReleased)
+{
+    auto owner = std::make_shared<std::vector<GAny> >(std::vector<GAny>{1, 2, 3, 4});
+    const std::weak_ptr<std::vector<GAny> > weakOwner = owner;
+    auto source = Observable::fromIterable(std::span<const GAny>(*owner).subspan(1, 2), owner);
+    owner.reset();
+
+    const auto observer = std::make_shared<TestObserver>();
+    source->subscribe(observer);
+    observer->expectInt64Values({2, 3});
+    observer->expectComplete();
+    EXPECT_FALSE(weakOwner.expired());
+
+    source.reset();
+    EXPECT_TRUE(weakOwner.expired());
+}
+
 TEST(ObservableJustTest, EmitsSingleAndMultipleValuesInOrder)
 {
     const auto singleObserver = std::make_shared<TestObserver>();
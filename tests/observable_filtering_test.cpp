@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "support/test_observer.h"
+#include "support/test_scheduler.h"
 
 #include <rx/rx.h>
 #include <rx/disposables/atomic_disposable.h>
@@ -65,6 +66,33 @@ TEST(ObservableDistinctTest, SupportsDefaultAndSelectedKeys)
     selected->expectComplete();
 }
 
+TEST(ObservableDistinctTest, DeduplicatesLargeStreamsByHash)
+{
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::range(0, 200000)
+        ->distinct([](const GAny &value) { return value.toInt64() % 1000; })
+        ->subscribe(observer);
+    EXPECT_EQ(observer->values().size(), 1000U);
+    observer->expectComplete();
+}
+
+TEST(ObservableDistinctTest, BoundedKeySetEvictsLeastRecentlySeenKey)
+{
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::just(1, 2, 1, 3, 1, 2)->distinct(nullptr, 2)->subscribe(observer);
+    observer->expectInt64Values({1, 2, 3, 2});
+    observer->expectComplete();
+
+    const auto selected = std::make_shared<TestObserver>();
+    Observable::just(10, 21, 30, 41)
+        ->distinct([](const GAny &value) { return value.toInt64() % 2; }, 1)
+        ->subscribe(selected);
+    selected->expectInt64Values({10, 21, 30, 41});
+    selected->expectComplete();
+
+    EXPECT_THROW(Observable::just(1)->distinct(nullptr, 0), GAnyException);
+}
+
 TEST(ObservableDistinctTest, ConvertsKeySelectorException)
 {
     const auto observer = std::make_shared<TestObserver>();
@@ -282,6 +310,48 @@ TEST(ObservableSkipLastTest, CoversZeroWithinAndBeyondLength)
     errorObserver->expectErrorContains("upstream failure");
 }
 
+TEST(ObservableSkipLastTest, TimedVariantReleasesValuesOnceOlderThanWindow)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ObservableEmitterPtr emitter;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::create([&emitter](const ObservableEmitterPtr &value) { emitter = value; })
+        ->skipLast(100, scheduler)
+        ->subscribe(observer);
+
+    emitter->onNext(1);
+    scheduler->advanceBy(50);
+    emitter->onNext(2);
+    observer->expectInt64Values({});
+
+    scheduler->advanceBy(60);
+    emitter->onNext(3);
+    observer->expectInt64Values({1});
+
+    scheduler->advanceBy(40);
+    emitter->onNext(4);
+    emitter->onComplete();
+    observer->expectInt64Values({1, 2});
+    observer->expectComplete();
+
+    // A value that aged past the window during a quiet gap is still emitted on completion
+    ObservableEmitterPtr quietEmitter;
+    const auto quiet = std::make_shared<TestObserver>();
+    Observable::create([&quietEmitter](const ObservableEmitterPtr &value) { quietEmitter = value; })
+        ->skipLast(100, scheduler)
+        ->subscribe(quiet);
+    quietEmitter->onNext(1);
+    scheduler->advanceBy(10);
+    quietEmitter->onNext(2);
+    scheduler->advanceBy(60);
+    quietEmitter->onNext(3);
+    quiet->expectInt64Values({});
+    scheduler->advanceBy(50);
+    quietEmitter->onComplete();
+    quiet->expectInt64Values({1, 2});
+    quiet->expectComplete();
+}
+
 TEST(ObservableTakeTest, CoversZeroBoundaryAndUpstreamError)
 {
     const auto zero = std::make_shared<TestObserver>();
@@ -321,6 +391,42 @@ TEST(ObservableTakeLastTest, CoversZeroWithinAndBeyondLength)
     errorObserver->expectErrorContains("upstream failure");
 }
 
+TEST(ObservableTakeLastTest, TimedVariantEvictsByAgeAndCount)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ObservableEmitterPtr emitter;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::create([&emitter](const ObservableEmitterPtr &value) { emitter = value; })
+        ->takeLast(2, 100, scheduler)
+        ->subscribe(observer);
+
+    emitter->onNext(1);
+    scheduler->advanceBy(60);
+    emitter->onNext(2);
+    scheduler->advanceBy(60);
+    emitter->onNext(3);
+    emitter->onNext(4);
+    emitter->onNext(5);
+    observer->expectInt64Values({});
+    emitter->onComplete();
+
+    observer->expectInt64Values({4, 5});
+    observer->expectComplete();
+
+    const auto expired = std::make_shared<TestObserver>();
+    ObservableEmitterPtr expiredEmitter;
+    Observable::create([&expiredEmitter](const ObservableEmitterPtr &value) { expiredEmitter = value; })
+        ->takeLast(10, 100, scheduler)
+        ->subscribe(expired);
+    expiredEmitter->onNext(1);
+    scheduler->advanceBy(60);
+    expiredEmitter->onNext(2);
+    scheduler->advanceBy(60);
+    expiredEmitter->onComplete();
+    expired->expectInt64Values({2});
+    expired->expectComplete();
+}
+
 TEST(ObservableTakeWhileTest, StopsAtBoundaryAndConvertsPredicateException)
 {
     const auto observer = std::make_shared<TestObserver>();
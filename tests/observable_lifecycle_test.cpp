@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "support/test_observer.h"
+#include "support/test_scheduler.h"
 
 #include <rx/rx.h>
 #include <rx/disposables/atomic_disposable.h>
@@ -36,6 +37,24 @@ std::vector<std::vector<int64_t> > collectWindows(const std::shared_ptr<Observab
     }
     return result;
 }
+
+struct GroupRecord
+{
+    int64_t key;
+    std::shared_ptr<TestObserver> observer;
+};
+
+ObserverPtr groupCollector(std::vector<GroupRecord> &groups)
+{
+    return std::make_shared<LambdaObserver>(
+        [&groups](const GAny &value) {
+            const auto group = value.castAs<std::shared_ptr<GroupedObservable> >();
+            const auto observer = std::make_shared<TestObserver>();
+            groups.push_back({group->getKey().toInt64(), observer});
+            group->subscribe(observer);
+        },
+        nullptr, nullptr, nullptr);
+}
 } // namespace
 
 TEST(ObservableWindowTest, SupportsExactOverlappingAndGappedWindows)
@@ -48,6 +67,28 @@ TEST(ObservableWindowTest, SupportsExactOverlappingAndGappedWindows)
               std::vector<std::vector<int64_t> >({{1, 2}, {4, 5}}));
 }
 
+TEST(ObservableWindowTest, WindowsQueueUntilTheirSingleObserverSubscribes)
+{
+    std::vector<std::shared_ptr<Observable> > windows;
+    Observable::range(1, 4)->window(2)->subscribe([&windows](const GAny &value) {
+        windows.push_back(value.castAs<std::shared_ptr<Observable> >());
+    });
+    ASSERT_EQ(windows.size(), 2u);
+
+    const std::vector<std::vector<int64_t> > expected{{1, 2}, {3, 4}};
+    for (size_t i = 0; i < windows.size(); ++i) {
+        const auto first = std::make_shared<TestObserver>();
+        windows[i]->subscribe(first);
+        first->expectInt64Values(expected[i]);
+        first->expectComplete();
+
+        const auto second = std::make_shared<TestObserver>();
+        windows[i]->subscribe(second);
+        second->expectInt64Values({});
+        second->expectErrorContains("single observer");
+    }
+}
+
 TEST(ObservableWindowTest, PropagatesErrorToActiveWindowAndOuterObserver)
 {
     const auto outer = std::make_shared<TestObserver>();
@@ -258,6 +299,77 @@ TEST(ObservableGroupByTest, DownstreamCancellationCompletesActiveGroupAndDispose
     EXPECT_TRUE(upstream->isDisposed());
 }
 
+TEST(ObservableGroupByTest, ReleasesGroupWhenAllSubscribersDispose)
+{
+    ObservableEmitterPtr sourceEmitter;
+    std::vector<GroupRecord> groups;
+    Observable::create([&sourceEmitter](const ObservableEmitterPtr &emitter) { sourceEmitter = emitter; })
+        ->groupBy([](const GAny &value) { return value.toInt64() % 2; })
+        ->subscribe(groupCollector(groups));
+
+    ASSERT_NE(sourceEmitter, nullptr);
+    sourceEmitter->onNext(1);
+    ASSERT_EQ(groups.size(), 1u);
+    groups[0].observer->dispose();
+    sourceEmitter->onNext(3);
+    sourceEmitter->onComplete();
+
+    ASSERT_EQ(groups.size(), 2u);
+    groups[0].observer->expectInt64Values({1});
+    groups[0].observer->expectNotTerminated();
+    EXPECT_EQ(groups[1].key, 1);
+    groups[1].observer->expectInt64Values({3});
+    groups[1].observer->expectComplete();
+}
+
+TEST(ObservableGroupByTest, MaxGroupsCompletesLeastRecentlyActiveGroup)
+{
+    std::vector<GroupRecord> groups;
+    Observable::just(1, 2, 1, 3, 2)
+        ->groupBy([](const GAny &value) { return value; }, nullptr, GroupOptions{0, 2})
+        ->subscribe(groupCollector(groups));
+
+    ASSERT_EQ(groups.size(), 4u);
+    EXPECT_EQ(groups[0].key, 1);
+    groups[0].observer->expectInt64Values({1, 1});
+    EXPECT_EQ(groups[1].key, 2);
+    groups[1].observer->expectInt64Values({2});
+    groups[1].observer->expectComplete();
+    EXPECT_EQ(groups[2].key, 3);
+    EXPECT_EQ(groups[3].key, 2);
+    groups[3].observer->expectInt64Values({2});
+    for (const auto &group: groups) {
+        group.observer->expectComplete();
+    }
+}
+
+TEST(ObservableGroupByTest, IdleTimeoutCompletesQuietGroups)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ObservableEmitterPtr sourceEmitter;
+    std::vector<GroupRecord> groups;
+    Observable::create([&sourceEmitter](const ObservableEmitterPtr &emitter) { sourceEmitter = emitter; })
+        ->groupBy([](const GAny &value) { return value; }, nullptr, GroupOptions{100, 0, scheduler})
+        ->subscribe(groupCollector(groups));
+
+    ASSERT_NE(sourceEmitter, nullptr);
+    sourceEmitter->onNext(1);
+    scheduler->advanceBy(50);
+    ASSERT_EQ(groups.size(), 1u);
+    groups[0].observer->expectNotTerminated();
+
+    scheduler->advanceBy(100);
+    groups[0].observer->expectInt64Values({1});
+    groups[0].observer->expectComplete();
+
+    sourceEmitter->onNext(1);
+    ASSERT_EQ(groups.size(), 2u);
+    groups[1].observer->expectInt64Values({1});
+    groups[1].observer->expectNotTerminated();
+    sourceEmitter->onComplete();
+    groups[1].observer->expectComplete();
+}
+
 TEST(ObservableLifetimeRegressionTest, ClosedWindowRemainsSubscribable)
 {
     std::shared_ptr<Observable> window;
@@ -0,0 +1,630 @@
+#include <gtest/gtest.h>
+
+#include "support/test_observer.h"
+#include "support/test_scheduler.h"
+
+#include <rx/rx.h>
+#include <rx/disposables/atomic_disposable.h>
+#include <rx/operators/observable_balance.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using namespace rx;
+using namespace rx::test;
+
+struct ControlledSource
+{
+    std::shared_ptr<Observable> observable;
+    std::shared_ptr<int32_t> subscriptions = std::make_shared<int32_t>(0);
+    std::shared_ptr<ObservableEmitterPtr> emitter = std::make_shared<ObservableEmitterPtr>();
+    std::shared_ptr<std::shared_ptr<AtomicDisposable> > upstream =
+            std::make_shared<std::shared_ptr<AtomicDisposable> >();
+
+    ControlledSource()
+    {
+        observable = Observable::create([subscriptions = subscriptions, emitter = emitter, upstream = upstream](
+            const ObservableEmitterPtr &sourceEmitter) {
+                ++*subscriptions;
+                *emitter = sourceEmitter;
+                *upstream = std::make_shared<AtomicDisposable>();
+                sourceEmitter->setDisposable(*upstream);
+            });
+    }
+};
+} // namespace
+
+TEST(ObservablePublishTest, SharesOneUpstreamSubscriptionAfterConnect)
+{
+    ControlledSource source;
+    const auto published = source.observable->publish();
+
+    std::vector<std::shared_ptr<TestObserver> > observers;
+    for (int32_t i = 0; i < 8; ++i) {
+        observers.push_back(std::make_shared<TestObserver>());
+        published->subscribe(observers.back());
+    }
+    EXPECT_EQ(*source.subscriptions, 0);
+
+    const auto connection = published->connect();
+    EXPECT_EQ(*source.subscriptions, 1);
+    EXPECT_EQ(published->connect(), connection);
+    EXPECT_EQ(*source.subscriptions, 1);
+
+    (*source.emitter)->onNext(1);
+    observers[0]->dispose();
+    (*source.emitter)->onNext(2);
+    (*source.emitter)->onComplete();
+    observers[0]->expectInt64Values({1});
+    for (size_t i = 1; i < observers.size(); ++i) {
+        observers[i]->expectInt64Values({1, 2});
+        observers[i]->expectComplete();
+    }
+
+    // Until reset() a late observer sees the finished connection's terminal event
+    const auto late = std::make_shared<TestObserver>();
+    published->subscribe(late);
+    late->expectComplete();
+
+    published->reset();
+    const auto fresh = std::make_shared<TestObserver>();
+    published->subscribe(fresh);
+    fresh->expectNotTerminated();
+    published->connect()->dispose();
+    EXPECT_EQ(*source.subscriptions, 2);
+    EXPECT_TRUE((*source.upstream)->isDisposed());
+    fresh->dispose();
+}
+
+TEST(ObservablePublishTest, ShareConnectsOnFirstObserverAndDisconnectsOnLast)
+{
+    ControlledSource source;
+    const auto shared = source.observable->share();
+
+    const auto first = std::make_shared<TestObserver>();
+    const auto second = std::make_shared<TestObserver>();
+    shared->subscribe(first);
+    shared->subscribe(second);
+    EXPECT_EQ(*source.subscriptions, 1);
+
+    (*source.emitter)->onNext(1);
+    first->dispose();
+    EXPECT_FALSE((*source.upstream)->isDisposed());
+    (*source.emitter)->onNext(2);
+    second->dispose();
+    EXPECT_TRUE((*source.upstream)->isDisposed());
+    first->expectInt64Values({1});
+    second->expectInt64Values({1, 2});
+
+    // The next observer starts a new upstream subscription, so does one after completion
+    const auto third = std::make_shared<TestObserver>();
+    shared->subscribe(third);
+    EXPECT_EQ(*source.subscriptions, 2);
+    (*source.emitter)->onComplete();
+    third->expectComplete();
+
+    const auto synchronous = Observable::range(1, 3)->share();
+    for (int32_t i = 0; i < 2; ++i) {
+        const auto observer = std::make_shared<TestObserver>();
+        synchronous->subscribe(observer);
+        observer->expectInt64Values({1, 2, 3});
+        observer->expectComplete();
+    }
+}
+
+TEST(ObservablePublishTest, RefCountWaitsForMinSubscribersAndGracePeriod)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ControlledSource source;
+    const auto shared = source.observable->publish()->refCount(2, 100, scheduler);
+
+    const auto first = std::make_shared<TestObserver>();
+    const auto second = std::make_shared<TestObserver>();
+    shared->subscribe(first);
+    EXPECT_EQ(*source.subscriptions, 0);
+    shared->subscribe(second);
+    EXPECT_EQ(*source.subscriptions, 1);
+
+    first->dispose();
+    second->dispose();
+    scheduler->advanceBy(50);
+    EXPECT_FALSE((*source.upstream)->isDisposed());
+
+    // Arriving within the grace period keeps the running connection
+    const auto third = std::make_shared<TestObserver>();
+    shared->subscribe(third);
+    scheduler->advanceBy(100);
+    EXPECT_FALSE((*source.upstream)->isDisposed());
+    (*source.emitter)->onNext(7);
+    third->expectInt64Values({7});
+    EXPECT_EQ(*source.subscriptions, 1);
+
+    third->dispose();
+    scheduler->advanceBy(99);
+    EXPECT_FALSE((*source.upstream)->isDisposed());
+    scheduler->advanceBy(1);
+    EXPECT_TRUE((*source.upstream)->isDisposed());
+
+    EXPECT_THROW(source.observable->publish()->refCount(0, 0), GAnyException);
+}
+
+TEST(ObservableSubjectTest, PublishSubjectRelaysLaterValuesAndReplaysTerminal)
+{
+    const auto subject = PublishSubject::create();
+    const auto first = std::make_shared<TestObserver>();
+    subject->onNext(0);
+    subject->subscribe(first);
+    EXPECT_TRUE(subject->hasObservers());
+
+    subject->onNext(1);
+    const auto second = std::make_shared<TestObserver>();
+    subject->subscribe(second);
+    subject->onNext(2);
+    first->dispose();
+    subject->onNext(3);
+    subject->onComplete();
+
+    first->expectInt64Values({1, 2});
+    first->expectNotTerminated();
+    second->expectInt64Values({2, 3});
+    second->expectComplete();
+    EXPECT_TRUE(subject->hasComplete());
+    EXPECT_FALSE(subject->hasObservers());
+
+    const auto late = std::make_shared<TestObserver>();
+    subject->subscribe(late);
+    late->expectInt64Values({});
+    late->expectComplete();
+}
+
+TEST(ObservableSubjectTest, BehaviorSubjectStartsWithTheLatestValue)
+{
+    const auto subject = BehaviorSubject::createDefault(0);
+    const auto first = std::make_shared<TestObserver>();
+    subject->subscribe(first);
+    subject->onNext(1);
+    subject->onNext(2);
+
+    const auto second = std::make_shared<TestObserver>();
+    subject->subscribe(second);
+    subject->onNext(3);
+    EXPECT_TRUE(subject->hasValue());
+    EXPECT_EQ(subject->getValue().toInt64(), 3);
+
+    subject->onError(GAnyException("boom"));
+    first->expectInt64Values({0, 1, 2, 3});
+    first->expectErrorContains("boom");
+    second->expectInt64Values({2, 3});
+    second->expectErrorContains("boom");
+    EXPECT_FALSE(subject->hasValue());
+
+    const auto late = std::make_shared<TestObserver>();
+    subject->subscribe(late);
+    late->expectInt64Values({});
+    late->expectErrorContains("boom");
+
+    const auto empty = BehaviorSubject::create();
+    const auto observer = std::make_shared<TestObserver>();
+    empty->subscribe(observer);
+    observer->expectInt64Values({});
+    empty->onNext(4);
+    empty->onComplete();
+    observer->expectInt64Values({4});
+    observer->expectComplete();
+}
+
+TEST(ObservableSubjectTest, ReplaySubjectReplaysWithinSizeAndTimeBounds)
+{
+    // Enough values to span several buffer segments
+    const auto unbounded = ReplaySubject::create();
+    const auto sized = ReplaySubject::createWithSize(3);
+    std::vector<int64_t> all;
+    for (int64_t i = 0; i < 200; ++i) {
+        unbounded->onNext(i);
+        sized->onNext(i);
+        all.push_back(i);
+    }
+    const auto full = std::make_shared<TestObserver>();
+    unbounded->subscribe(full);
+    full->expectInt64Values(all);
+    unbounded->onNext(200);
+    unbounded->onComplete();
+    all.push_back(200);
+    full->expectInt64Values(all);
+    full->expectComplete();
+
+    const auto tail = std::make_shared<TestObserver>();
+    sized->subscribe(tail);
+    tail->expectInt64Values({197, 198, 199});
+    tail->dispose();
+    sized->onNext(200);
+    tail->expectInt64Values({197, 198, 199});
+    EXPECT_EQ(sized->getValues().size(), 3u);
+
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto timed = ReplaySubject::createWithTime(100, scheduler);
+    timed->onNext(1);
+    scheduler->advanceBy(60);
+    timed->onNext(2);
+    scheduler->advanceBy(60);
+    timed->onNext(3);
+    timed->onError(GAnyException("boom"));
+
+    const auto late = std::make_shared<TestObserver>();
+    timed->subscribe(late);
+    late->expectInt64Values({2, 3});
+    late->expectErrorContains("boom");
+    EXPECT_TRUE(timed->hasThrowable());
+}
+
+TEST(ObservableSubjectTest, AsyncSubjectEmitsTheLastValueOnCompletion)
+{
+    const auto subject = AsyncSubject::create();
+    const auto early = std::make_shared<TestObserver>();
+    subject->subscribe(early);
+    subject->onNext(1);
+    subject->onNext(2);
+    early->expectInt64Values({});
+    early->expectNotTerminated();
+
+    subject->onComplete();
+    early->expectInt64Values({2});
+    early->expectComplete();
+
+    const auto late = std::make_shared<TestObserver>();
+    subject->subscribe(late);
+    late->expectInt64Values({2});
+    late->expectComplete();
+
+    const auto unicast = UnicastSubject::create();
+    unicast->onNext(1);
+    unicast->onNext(2);
+    const auto only = std::make_shared<TestObserver>();
+    const auto other = std::make_shared<TestObserver>();
+    unicast->subscribe(only);
+    unicast->subscribe(other);
+    unicast->onComplete();
+    only->expectInt64Values({1, 2});
+    only->expectComplete();
+    other->expectErrorContains("single observer");
+}
+
+TEST(ObservableReplayTest, BoundedReplayHandsTheTailToLateObservers)
+{
+    ControlledSource source;
+    const auto replayed = source.observable->replay(2);
+    const auto early = std::make_shared<TestObserver>();
+    replayed->subscribe(early);
+    const auto connection = replayed->connect();
+    EXPECT_EQ(*source.subscriptions, 1);
+
+    for (int64_t i = 1; i <= 5; ++i) {
+        (*source.emitter)->onNext(i);
+    }
+    const auto late = std::make_shared<TestObserver>();
+    replayed->subscribe(late);
+    (*source.emitter)->onNext(6);
+    (*source.emitter)->onComplete();
+
+    early->expectInt64Values({1, 2, 3, 4, 5, 6});
+    early->expectComplete();
+    late->expectInt64Values({4, 5, 6});
+    late->expectComplete();
+
+    // A terminated connection keeps replaying until it is reset
+    const auto afterwards = std::make_shared<TestObserver>();
+    replayed->subscribe(afterwards);
+    afterwards->expectInt64Values({5, 6});
+    afterwards->expectComplete();
+
+    replayed->reset();
+    const auto fresh = std::make_shared<TestObserver>();
+    replayed->subscribe(fresh);
+    replayed->connect();
+    EXPECT_EQ(*source.subscriptions, 2);
+    (*source.emitter)->onNext(7);
+    (*source.emitter)->onComplete();
+    fresh->expectInt64Values({7});
+    fresh->expectComplete();
+
+    EXPECT_THROW(source.observable->replay(0), GAnyException);
+}
+
+TEST(ObservableReplayTest, TimedReplayDropsValuesOlderThanTheWindow)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ControlledSource source;
+    const auto replayed = source.observable->replay(100, scheduler);
+    const auto connection = replayed->connect();
+
+    (*source.emitter)->onNext(1);
+    scheduler->advanceBy(50);
+    (*source.emitter)->onNext(2);
+    scheduler->advanceBy(80);
+    (*source.emitter)->onNext(3);
+
+    const auto late = std::make_shared<TestObserver>();
+    replayed->subscribe(late);
+    late->expectInt64Values({2, 3});
+
+    // Disposing the connection forgets the buffer, the next observer waits for a new connection
+    connection->dispose();
+    EXPECT_TRUE((*source.upstream)->isDisposed());
+    const auto next = std::make_shared<TestObserver>();
+    replayed->subscribe(next);
+    next->expectInt64Values({});
+    next->expectNotTerminated();
+    replayed->connect();
+    (*source.emitter)->onComplete();
+    next->expectComplete();
+    late->dispose();
+}
+
+TEST(ObservableReplayTest, CacheSubscribesOnceAndKeepsEverything)
+{
+    ControlledSource source;
+    const auto cached = source.observable->cache();
+    EXPECT_EQ(*source.subscriptions, 0);
+
+    const auto first = std::make_shared<TestObserver>();
+    cached->subscribe(first);
+    EXPECT_EQ(*source.subscriptions, 1);
+    (*source.emitter)->onNext(1);
+    (*source.emitter)->onNext(2);
+    first->dispose();
+
+    const auto second = std::make_shared<TestObserver>();
+    cached->subscribe(second);
+    (*source.emitter)->onNext(3);
+    EXPECT_EQ(*source.subscriptions, 1);
+    EXPECT_FALSE((*source.upstream)->isDisposed());
+    (*source.emitter)->onComplete();
+
+    first->expectInt64Values({1, 2});
+    second->expectInt64Values({1, 2, 3});
+    second->expectComplete();
+
+    const auto third = std::make_shared<TestObserver>();
+    cached->subscribe(third);
+    third->expectInt64Values({1, 2, 3});
+    third->expectComplete();
+}
+
+TEST(ObservableBroadcastTest, EveryConsumerReadsEveryValueInOrder)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    ControlledSource source;
+    const auto broadcast = source.observable->broadcast(16, WaitStrategy::Yield, scheduler);
+
+    std::vector<std::shared_ptr<TestObserver> > observers;
+    for (int32_t i = 0; i < 4; ++i) {
+        observers.push_back(std::make_shared<TestObserver>());
+        broadcast->subscribe(observers.back());
+    }
+    broadcast->connect();
+    EXPECT_EQ(*source.subscriptions, 1);
+
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 10; ++i) {
+        (*source.emitter)->onNext(i);
+        expected.push_back(i);
+    }
+    observers[0]->expectInt64Values({});
+    scheduler->runUntilIdle();
+    observers[3]->dispose();
+    (*source.emitter)->onNext(10);
+    (*source.emitter)->onComplete();
+    scheduler->runUntilIdle();
+
+    expected.push_back(10);
+    for (int32_t i = 0; i < 3; ++i) {
+        observers[i]->expectInt64Values(expected);
+        observers[i]->expectComplete();
+    }
+    expected.pop_back();
+    observers[3]->expectInt64Values(expected);
+    observers[3]->expectNotTerminated();
+
+    const auto late = std::make_shared<TestObserver>();
+    broadcast->subscribe(late);
+    scheduler->runUntilIdle();
+    late->expectInt64Values({});
+    late->expectComplete();
+
+    // The terminal also reaches observers behind an operator
+    int32_t completions = 0;
+    const auto piped = std::make_shared<TestObserver>();
+    const auto ranged = Observable::range(1, 3)->broadcast(4, WaitStrategy::Yield, scheduler);
+    ranged->doOnComplete([&completions] { ++completions; })->subscribe(piped);
+    ranged->connect();
+    scheduler->runUntilIdle();
+    piped->expectInt64Values({1, 2, 3});
+    piped->expectComplete();
+    EXPECT_EQ(completions, 1);
+
+    EXPECT_THROW(source.observable->broadcast(0), GAnyException);
+}
+
+TEST(ObservableBroadcastTest, SlowestConsumerGatesTheProducer)
+{
+    ScopedGlobalTimerScheduler timerScope("ObservableBroadcastTest");
+    std::thread timerThread([timerScheduler = timerScope.scheduler()] {
+        timerScheduler->run();
+    });
+
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 2000; ++i) {
+        expected.push_back(i);
+    }
+
+    // The default scheduler never puts a consumer on the timer thread the chunked range emits from
+    const auto timed = Observable::range(0, 2000, MainThreadScheduler::create(), 100)->broadcast(8);
+    const auto observer = std::make_shared<TestObserver>();
+    timed->subscribe(observer);
+    timed->connect();
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+    observer->expectInt64Values(expected);
+    observer->expectComplete();
+
+    for (const auto strategy: {WaitStrategy::BusySpin, WaitStrategy::Yield, WaitStrategy::Park}) {
+        // A ring far smaller than the stream, the producer keeps waiting for the consumer threads
+        const auto broadcast = Observable::range(0, 2000)->broadcast(8, strategy, NewThreadScheduler::create());
+        std::vector<std::shared_ptr<TestObserver> > observers;
+        for (int32_t i = 0; i < 3; ++i) {
+            observers.push_back(std::make_shared<TestObserver>());
+            broadcast->subscribe(observers.back());
+        }
+        broadcast->connect();
+        for (const auto &observer: observers) {
+            ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+            observer->expectInt64Values(expected);
+            observer->expectComplete();
+        }
+    }
+
+    timerScope.scheduler()->stop();
+    timerThread.join();
+}
+
+TEST(ObservableBalanceTest, RailsTakeTurnsAndEachValueGoesToOneRail)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    for (const auto strategy: {BalanceStrategy::RoundRobin, BalanceStrategy::LeastOutstanding}) {
+        const auto rails = Observable::range(0, 9)->balance(3, strategy, scheduler);
+        ASSERT_EQ(rails.size(), 3u);
+
+        std::vector<std::shared_ptr<TestObserver> > observers;
+        for (const auto &rail: rails) {
+            observers.push_back(std::make_shared<TestObserver>());
+            rail->subscribe(observers.back());
+        }
+        scheduler->runUntilIdle();
+        observers[0]->expectInt64Values({0, 3, 6});
+        observers[1]->expectInt64Values({1, 4, 7});
+        observers[2]->expectInt64Values({2, 5, 8});
+        for (const auto &observer: observers) {
+            observer->expectComplete();
+        }
+
+        const auto second = std::make_shared<TestObserver>();
+        rails[0]->subscribe(second);
+        second->expectErrorContains("single observer");
+    }
+
+    // Values skip a disposed rail
+    const auto subject = PublishSubject::create();
+    const auto rails = subject->balance(2, BalanceStrategy::RoundRobin, scheduler);
+    const auto first = std::make_shared<TestObserver>();
+    const auto second = std::make_shared<TestObserver>();
+    rails[0]->subscribe(first);
+    rails[1]->subscribe(second);
+    second->dispose();
+    for (int64_t i = 0; i < 4; ++i) {
+        subject->onNext(i);
+    }
+    subject->onComplete();
+    scheduler->runUntilIdle();
+    first->expectInt64Values({0, 1, 2, 3});
+    first->expectComplete();
+    second->expectInt64Values({});
+
+    // A rail refuses values once disposed, so the upstream hands them to the next rail
+    const auto detached = std::make_shared<BalanceRail>();
+    detached->dispose();
+    EXPECT_FALSE(detached->offer(GAny(1)));
+
+    EXPECT_THROW(Observable::range(0, 1)->balance(0), GAnyException);
+}
+
+TEST(ObservableBalanceTest, ParkedWorkStealingProducerReturnsOnceEveryRailIsDisposed)
+{
+    // Nothing drains the rails on the test scheduler, so the producer parks on the full shared queue
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto subject = PublishSubject::create();
+    const auto rails = subject->balance(2, BalanceStrategy::WorkStealing, scheduler, 2);
+    const auto first = std::make_shared<TestObserver>();
+    const auto second = std::make_shared<TestObserver>();
+    rails[0]->subscribe(first);
+    rails[1]->subscribe(second);
+
+    std::atomic<int64_t> emitted = 0;
+    std::thread producer([subject, &emitted] {
+        for (int64_t i = 0; i < 100; ++i) {
+            subject->onNext(i);
+            emitted.fetch_add(1);
+        }
+    });
+    while (emitted.load() < 2) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_LT(emitted.load(), 100);
+
+    first->dispose();
+    second->dispose();
+    producer.join();
+    EXPECT_EQ(emitted.load(), 100);
+    EXPECT_FALSE(subject->hasObservers());
+    // The pending drains release the disposed rails
+    scheduler->runUntilIdle();
+    first->expectInt64Values({});
+    second->expectInt64Values({});
+}
+
+TEST(ObservableBalanceTest, EveryStrategyDeliversEachValueExactlyOnceAcrossThreads)
+{
+    ScopedGlobalTimerScheduler timerScope("ObservableBalanceTest");
+    std::thread timerThread([timerScheduler = timerScope.scheduler()] {
+        timerScheduler->run();
+    });
+
+    // The default scheduler never puts a rail on the timer thread the chunked range emits from
+    std::vector<std::shared_ptr<TestObserver> > timedObservers;
+    for (const auto &rail: Observable::range(0, 3000, MainThreadScheduler::create(), 100)
+                               ->balance(2, BalanceStrategy::WorkStealing, nullptr, 16)) {
+        timedObservers.push_back(std::make_shared<TestObserver>());
+        rail->subscribe(timedObservers.back());
+    }
+    size_t delivered = 0;
+    for (const auto &observer: timedObservers) {
+        ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+        observer->expectComplete();
+        delivered += observer->values().size();
+    }
+    EXPECT_EQ(delivered, 3000u);
+
+    for (const auto strategy: {BalanceStrategy::RoundRobin, BalanceStrategy::LeastOutstanding,
+                               BalanceStrategy::WorkStealing}) {
+        // A shared queue much smaller than the stream keeps the work-stealing producer waiting on the rails
+        const auto rails = Observable::range(0, 3000)->balance(4, strategy, NewThreadScheduler::create(), 16);
+        std::vector<std::shared_ptr<TestObserver> > observers;
+        for (const auto &rail: rails) {
+            observers.push_back(std::make_shared<TestObserver>());
+            rail->subscribe(observers.back());
+        }
+
+        std::vector<int64_t> all;
+        for (const auto &observer: observers) {
+            ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+            observer->expectComplete();
+            for (const auto &value: observer->values()) {
+                all.push_back(value.toInt64());
+            }
+        }
+        std::sort(all.begin(), all.end());
+        ASSERT_EQ(all.size(), 3000u);
+        for (int64_t i = 0; i < 3000; ++i) {
+            EXPECT_EQ(all[i], i);
+        }
+    }
+
+    timerScope.scheduler()->stop();
+    timerThread.join();
+}
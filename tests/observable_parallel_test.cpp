@@ -0,0 +1,556 @@
+#include <gtest/gtest.h>
+
+#include "support/bounded_wait.h"
+#include "support/test_observer.h"
+#include "support/test_scheduler.h"
+
+#include <rx/rx.h>
+#include <rx/grouped_observable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using namespace rx;
+using namespace rx::test;
+
+std::vector<int64_t> int64Values(const std::shared_ptr<TestObserver> &observer)
+{
+    std::vector<int64_t> values;
+    for (const auto &value: observer->values()) {
+        values.push_back(value.toInt64());
+    }
+    return values;
+}
+
+struct GroupRecord
+{
+    int64_t key;
+    std::shared_ptr<TestObserver> observer;
+};
+
+// Subscribes a TestObserver to every group, groups may arrive from several lane threads
+ObserverPtr groupCollector(const std::shared_ptr<TestObserver> &outer, std::mutex &lock, std::vector<GroupRecord> &groups)
+{
+    return std::make_shared<LambdaObserver>(
+        [outer, &lock, &groups](const GAny &value) {
+            outer->onNext(value);
+            const auto group = value.castAs<std::shared_ptr<GroupedObservable> >();
+            const auto observer = std::make_shared<TestObserver>();
+            {
+                std::lock_guard guard(lock);
+                groups.push_back({group->getKey().toInt64(), observer});
+            }
+            group->subscribe(observer);
+        },
+        [outer](const GAnyException &error) { outer->onError(error); },
+        [outer] { outer->onComplete(); },
+        [outer](const DisposablePtr &disposable) { outer->onSubscribe(disposable); });
+}
+
+// Records how values reach one rail and whether its upstream reported itself disposed at the terminal
+class RecordingRail : public RailObserver
+{
+public:
+    void onSubscribe(const DisposablePtr &d) override
+    {
+        upstream = d;
+    }
+
+    void onNext(uint64_t index, const GAny &value) override
+    {
+        indices.push_back(index);
+        values.push_back(value.toInt64());
+    }
+
+    void onNextBatch(uint64_t firstIndex, std::vector<GAny> batch) override
+    {
+        batches.emplace_back(firstIndex, batch.size());
+        RailObserver::onNextBatch(firstIndex, std::move(batch));
+    }
+
+    void onError(const GAnyException &) override
+    {
+        terminals++;
+    }
+
+    void onComplete() override
+    {
+        terminals++;
+        disposedAtTerminal = upstream->isDisposed();
+    }
+
+public:
+    DisposablePtr upstream;
+    std::vector<std::pair<uint64_t, size_t> > batches;
+    std::vector<uint64_t> indices;
+    std::vector<int64_t> values;
+    int terminals = 0;
+    bool disposedAtTerminal = false;
+};
+} // namespace
+
+TEST(ObservableParallelTest, RailOperatorsMergeBackOnTestScheduler)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto rails = Observable::range(0, 20)->parallel(3, scheduler, 2)
+            ->map([](const GAny &v) { return GAny(v.toInt64() * 10); })
+            ->filter([](const GAny &v) { return v.toInt64() % 20 == 0; });
+    ASSERT_EQ(rails->parallelism(), 3u);
+
+    const auto ordered = std::make_shared<TestObserver>();
+    rails->sequentialOrdered()->subscribe(ordered);
+    scheduler->runUntilIdle();
+    ordered->expectInt64Values({0, 20, 40, 60, 80, 100, 120, 140, 160, 180});
+    ordered->expectComplete();
+
+    const auto unordered = std::make_shared<TestObserver>();
+    rails->sequential()->subscribe(unordered);
+    scheduler->runUntilIdle();
+    auto values = int64Values(unordered);
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int64_t>{0, 20, 40, 60, 80, 100, 120, 140, 160, 180}));
+    unordered->expectComplete();
+
+    const auto sum = std::make_shared<TestObserver>();
+    rails->reduce([](const GAny &a, const GAny &b) { return GAny(a.toInt64() + b.toInt64()); })->subscribe(sum);
+    scheduler->runUntilIdle();
+    sum->expectInt64Values({900});
+    sum->expectComplete();
+
+    const auto descending = std::make_shared<TestObserver>();
+    Observable::fromArray({GAny(5), GAny(1), GAny(4), GAny(2), GAny(3), GAny(0)})->parallel(2, 1)
+            ->sorted([](const GAny &a, const GAny &b) { return a.toInt64() > b.toInt64(); })
+            ->subscribe(descending);
+    descending->expectInt64Values({5, 4, 3, 2, 1, 0});
+    descending->expectComplete();
+
+    const auto empty = std::make_shared<TestObserver>();
+    Observable::empty()->parallel(2)->reduce([](const GAny &a, const GAny &) { return a; })->subscribe(empty);
+    empty->expectErrorContains("No elements");
+
+    EXPECT_THROW(Observable::range(0, 1)->parallel(0), GAnyException);
+    EXPECT_THROW(Observable::range(0, 1)->parallel(2, 0), GAnyException);
+    EXPECT_THROW(Observable::range(0, 1)->parallel(2)->runOn(scheduler, 0), GAnyException);
+}
+
+TEST(ObservableParallelTest, RunsReachTheirRailWholeAndThePartialRunOnTerminal)
+{
+    const auto first = std::make_shared<RecordingRail>();
+    const auto second = std::make_shared<RecordingRail>();
+    Observable::range(0, 10)->parallel(2, 4)->subscribe({first, second});
+
+    EXPECT_EQ(first->batches, (std::vector<std::pair<uint64_t, size_t> >{{0, 4}, {8, 2}}));
+    EXPECT_EQ(second->batches, (std::vector<std::pair<uint64_t, size_t> >{{4, 4}}));
+    EXPECT_EQ(first->indices, (std::vector<uint64_t>{0, 1, 2, 3, 8, 9}));
+    EXPECT_EQ(second->values, (std::vector<int64_t>{4, 5, 6, 7}));
+    EXPECT_EQ(first->terminals, 1);
+    EXPECT_EQ(second->terminals, 1);
+}
+
+TEST(ObservableParallelTest, RunOnDeliversRunsAndTerminatesWithoutDisposing)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto first = std::make_shared<RecordingRail>();
+    const auto second = std::make_shared<RecordingRail>();
+    Observable::range(0, 10)->parallel(2, 4)->runOn(scheduler, 8)->subscribe({first, second});
+    EXPECT_TRUE(first->values.empty());
+
+    scheduler->runUntilIdle();
+    EXPECT_EQ(first->indices, (std::vector<uint64_t>{0, 1, 2, 3, 8, 9}));
+    EXPECT_EQ(second->indices, (std::vector<uint64_t>{4, 5, 6, 7}));
+    EXPECT_EQ(first->terminals, 1);
+    EXPECT_EQ(second->terminals, 1);
+    // Terminating is not disposing, operators downstream still forward the terminal
+    EXPECT_FALSE(first->disposedAtTerminal);
+    EXPECT_FALSE(second->disposedAtTerminal);
+}
+
+TEST(ObservableParallelTest, SortedStopsMergingOnceTheDownstreamDisposes)
+{
+    std::vector<int64_t> values;
+    bool completed = false;
+    DisposablePtr upstream;
+    Observable::range(0, 10)->parallel(2, 1)->sorted()->subscribe(std::make_shared<LambdaObserver>(
+        [&values, &upstream](const GAny &value) {
+            values.push_back(value.toInt64());
+            if (values.size() == 3) {
+                upstream->dispose();
+            }
+        },
+        [](const GAnyException &) {},
+        [&completed] { completed = true; },
+        [&upstream](const DisposablePtr &disposable) { upstream = disposable; }));
+    EXPECT_EQ(values, (std::vector<int64_t>{0, 1, 2}));
+    EXPECT_FALSE(completed);
+}
+
+TEST(ObservableParallelTest, RailErrorCancelsTheOtherRails)
+{
+    const auto subject = PublishSubject::create();
+    const auto observer = std::make_shared<TestObserver>();
+    subject->parallel(2, 1)
+            ->map([](const GAny &v) {
+                if (v.toInt64() == 3) {
+                    throw GAnyException("boom");
+                }
+                return v;
+            })
+            ->sequentialOrdered()
+            ->subscribe(observer);
+    for (int64_t i = 0; i < 5; ++i) {
+        subject->onNext(i);
+    }
+    // The error is delivered eagerly, 2 is still waiting for rail 1 and is dropped
+    observer->expectInt64Values({0, 1});
+    observer->expectErrorContains("boom");
+    EXPECT_FALSE(subject->hasObservers());
+    subject->onComplete();
+}
+
+TEST(ObservableParallelTest, RailsOnWorkerThreadsKeepEveryValue)
+{
+    GTaskSystem taskSystem("ObservableParallelTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    // A rail queue much smaller than the stream keeps the upstream thread waiting on the rails
+    const auto rails = Observable::range(0, 5000)->parallel(4, 8)->runOn(scheduler, 16)
+            ->map([](const GAny &v) { return GAny(v.toInt64() * 2); });
+
+    const auto ordered = std::make_shared<TestObserver>();
+    rails->sequentialOrdered()->subscribe(ordered);
+    ASSERT_TRUE(ordered->awaitTerminal(std::chrono::milliseconds(5000)));
+    ordered->expectComplete();
+    const auto values = int64Values(ordered);
+    ASSERT_EQ(values.size(), 5000u);
+    for (int64_t i = 0; i < 5000; ++i) {
+        EXPECT_EQ(values[i], i * 2);
+    }
+
+    const auto unordered = std::make_shared<TestObserver>();
+    rails->sequential()->subscribe(unordered);
+    ASSERT_TRUE(unordered->awaitTerminal(std::chrono::milliseconds(5000)));
+    unordered->expectComplete();
+    auto all = int64Values(unordered);
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(all, values);
+
+    const auto sum = std::make_shared<TestObserver>();
+    rails->reduce([](const GAny &a, const GAny &b) { return GAny(a.toInt64() + b.toInt64()); })->subscribe(sum);
+    ASSERT_TRUE(sum->awaitTerminal(std::chrono::milliseconds(5000)));
+    sum->expectInt64Values({4999 * 5000});
+    sum->expectComplete();
+
+    const auto sorted = std::make_shared<TestObserver>();
+    Observable::range(0, 2000)->map([](const GAny &v) { return GAny(1999 - v.toInt64()); })
+            ->parallel(4, scheduler)->sorted()->subscribe(sorted);
+    ASSERT_TRUE(sorted->awaitTerminal(std::chrono::milliseconds(5000)));
+    sorted->expectComplete();
+    const auto sortedValues = int64Values(sorted);
+    ASSERT_EQ(sortedValues.size(), 2000u);
+    EXPECT_TRUE(std::is_sorted(sortedValues.begin(), sortedValues.end()));
+
+    taskSystem.stopAndWait();
+}
+
+TEST(ObservableParallelTest, OrderedMergeDoesNotWaitForAFilteredRail)
+{
+    GTaskSystem taskSystem("ObservableParallelTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    // Runs of 16 alternate between the two rails and the filter drops every value of rail 1. The kept values
+    // must go out while the upstream is still running instead of piling up behind the silent rail.
+    constexpr int64_t count = 20000;
+    std::atomic<int64_t> upstream = 0;
+    std::atomic<int64_t> maxLag = 0;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::range(0, count)
+            ->doOnNext([&upstream](const GAny &) { upstream.fetch_add(1); })
+            ->parallel(2, 16)->runOn(scheduler, 16)
+            ->filter([](const GAny &v) { return v.toInt64() / 16 % 2 == 0; })
+            ->sequentialOrdered(8)
+            ->doOnNext([&upstream, &maxLag](const GAny &v) {
+                const int64_t lag = upstream.load() - v.toInt64();
+                if (lag > maxLag.load()) {
+                    maxLag.store(lag);
+                }
+            })
+            ->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+    observer->expectComplete();
+
+    const auto values = int64Values(observer);
+    ASSERT_EQ(values.size(), static_cast<size_t>(count / 2));
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], static_cast<int64_t>(i / 16 * 32 + i % 16));
+    }
+    // Rail queues of 16, join queues of 8 and the run being collected bound how far the upstream gets ahead
+    EXPECT_LT(maxLag.load(), 256);
+
+    taskSystem.stopAndWait();
+}
+
+TEST(ObservableParallelTest, UnorderedMergeParksRailsBehindASlowDownstream)
+{
+    GTaskSystem taskSystem("ObservableParallelTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    // The downstream is slower than the rails, full join queues must park the rail workers and through the
+    // full runOn queues the upstream, instead of letting the join buffer the whole source
+    constexpr int64_t count = 4000;
+    std::atomic<int64_t> upstream = 0;
+    std::atomic<int64_t> downstream = 0;
+    std::atomic<int64_t> maxLag = 0;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::range(0, count)
+            ->doOnNext([&upstream](const GAny &) { upstream.fetch_add(1); })
+            ->parallel(2, 16)->runOn(scheduler, 16)
+            ->sequential(8)
+            ->doOnNext([&upstream, &downstream, &maxLag](const GAny &) {
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+                const int64_t lag = upstream.load() - downstream.fetch_add(1);
+                if (lag > maxLag.load()) {
+                    maxLag.store(lag);
+                }
+            })
+            ->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(10000)));
+    observer->expectComplete();
+
+    auto values = int64Values(observer);
+    ASSERT_EQ(values.size(), static_cast<size_t>(count));
+    std::sort(values.begin(), values.end());
+    for (int64_t i = 0; i < count; ++i) {
+        EXPECT_EQ(values[i], i);
+    }
+    // Without the bound the rails would drain the source into the join long before the downstream caught up
+    EXPECT_LT(maxLag.load(), 256);
+
+    EXPECT_THROW(Observable::range(0, 1)->parallel(2)->sequential(0), GAnyException);
+
+    taskSystem.stopAndWait();
+}
+
+TEST(ObservableMapAsyncTest, EmitsInInputOrderWithBoundedConcurrency)
+{
+    ScopedGlobalTimerScheduler timerScope("ObservableMapAsyncTest");
+    std::thread timerThread([timerScheduler = timerScope.scheduler()] {
+        timerScheduler->run();
+    });
+
+    // The default scheduler never runs the mapper on the timer thread the chunked range emits and parks on
+    const auto timed = std::make_shared<TestObserver>();
+    Observable::range(0, 100, MainThreadScheduler::create(), 10)
+            ->mapAsync([](const GAny &v) { return GAny(v.toInt64() * 2); })
+            ->subscribe(timed);
+    ASSERT_TRUE(timed->awaitTerminal(std::chrono::milliseconds(5000)));
+    timed->expectComplete();
+    const auto doubled = int64Values(timed);
+    ASSERT_EQ(doubled.size(), 100u);
+    for (int64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(doubled[i], i * 2);
+    }
+
+    GTaskSystem taskSystem("ObservableMapAsyncTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    // Later values finish first, the reorder ring still emits them in input order
+    auto inFlight = std::make_shared<std::atomic<int32_t> >(0);
+    auto maxInFlight = std::make_shared<std::atomic<int32_t> >(0);
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::range(0, 200)
+            ->mapAsync([inFlight, maxInFlight](const GAny &v) {
+                const int32_t current = inFlight->fetch_add(1) + 1;
+                int32_t seen = maxInFlight->load();
+                while (current > seen && !maxInFlight->compare_exchange_weak(seen, current)) {
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100 * (3 - v.toInt64() % 4)));
+                inFlight->fetch_sub(1);
+                return GAny(v.toInt64() * 3);
+            }, scheduler, 3)
+            ->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+    observer->expectComplete();
+    const auto values = int64Values(observer);
+    ASSERT_EQ(values.size(), 200u);
+    for (int64_t i = 0; i < 200; ++i) {
+        EXPECT_EQ(values[i], i * 3);
+    }
+    EXPECT_LE(maxInFlight->load(), 3);
+
+    const auto failed = std::make_shared<TestObserver>();
+    Observable::range(0, 10)
+            ->mapAsync([](const GAny &v) {
+                if (v.toInt64() == 5) {
+                    throw GAnyException("boom");
+                }
+                return v;
+            }, scheduler, 2)
+            ->subscribe(failed);
+    ASSERT_TRUE(failed->awaitTerminal(std::chrono::milliseconds(5000)));
+    failed->expectInt64Values({0, 1, 2, 3, 4});
+    failed->expectErrorContains("boom");
+
+    EXPECT_THROW(Observable::range(0, 1)->mapAsync([](const GAny &v) { return v; }, scheduler, 0), GAnyException);
+
+    taskSystem.stopAndWait();
+    timerScope.scheduler()->stop();
+    timerThread.join();
+}
+
+TEST(ObservableMapAsyncTest, DeliversUpstreamTerminalAfterPendingResults)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto subject = PublishSubject::create();
+    const auto observer = std::make_shared<TestObserver>();
+    subject->mapAsync([](const GAny &v) { return GAny(v.toInt64() + 1); }, scheduler, 2)->subscribe(observer);
+
+    subject->onNext(1);
+    subject->onNext(2);
+    subject->onError(GAnyException("upstream"));
+    observer->expectInt64Values({});
+    observer->expectNotTerminated();
+
+    scheduler->runUntilIdle();
+    observer->expectInt64Values({2, 3});
+    observer->expectErrorContains("upstream");
+}
+
+TEST(ObservableGroupByParallelTest, KeepsPerKeyOrderOnSerialLanes)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto outer = std::make_shared<TestObserver>();
+    std::mutex lock;
+    std::vector<GroupRecord> groups;
+    Observable::range(0, 12)
+            ->groupByParallel([](const GAny &v) { return v.toInt64() % 3; }, scheduler, 2)
+            ->subscribe(groupCollector(outer, lock, groups));
+    outer->expectNotTerminated();
+
+    scheduler->runUntilIdle();
+    outer->expectComplete();
+    ASSERT_EQ(groups.size(), 3u);
+    std::sort(groups.begin(), groups.end(), [](const GroupRecord &a, const GroupRecord &b) { return a.key < b.key; });
+    for (int64_t key = 0; key < 3; ++key) {
+        EXPECT_EQ(groups[key].key, key);
+        groups[key].observer->expectInt64Values({key, key + 3, key + 6, key + 9});
+        groups[key].observer->expectComplete();
+    }
+
+    // A key selector failure errors the open groups and the outer observer once
+    const auto failedOuter = std::make_shared<TestObserver>();
+    std::vector<GroupRecord> failedGroups;
+    Observable::range(0, 4)
+            ->groupByParallel([](const GAny &v) {
+                if (v.toInt64() == 2) {
+                    throw GAnyException("boom");
+                }
+                return v.toInt64() % 2;
+            }, scheduler, 2)
+            ->subscribe(groupCollector(failedOuter, lock, failedGroups));
+    scheduler->runUntilIdle();
+    failedOuter->expectErrorContains("boom");
+    ASSERT_EQ(failedGroups.size(), 2u);
+    for (const auto &group: failedGroups) {
+        group.observer->expectInt64Values({group.key});
+        group.observer->expectErrorContains("boom");
+    }
+
+    EXPECT_THROW(Observable::range(0, 1)->groupByParallel([](const GAny &v) { return v; }, scheduler, 0),
+                 GAnyException);
+}
+
+TEST(ObservableGroupByParallelTest, LanesRunConcurrentlyAndKeepPerKeyOrder)
+{
+    GTaskSystem taskSystem("ObservableGroupByParallelTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    const auto outer = std::make_shared<TestObserver>();
+    std::mutex lock;
+    std::vector<GroupRecord> groups;
+    Observable::range(0, 20000)
+            ->groupByParallel([](const GAny &v) { return v.toInt64() % 64; }, scheduler, 4)
+            ->subscribe(groupCollector(outer, lock, groups));
+    ASSERT_TRUE(outer->awaitTerminal(std::chrono::milliseconds(5000)));
+    outer->expectComplete();
+
+    std::lock_guard guard(lock);
+    ASSERT_EQ(groups.size(), 64u);
+    for (const auto &group: groups) {
+        group.observer->expectComplete();
+        const auto values = int64Values(group.observer);
+        ASSERT_EQ(values.size(), 20000u / 64 + (group.key < 20000 % 64 ? 1 : 0));
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(values[i], group.key + static_cast<int64_t>(i) * 64);
+        }
+    }
+
+    taskSystem.stopAndWait();
+}
+
+TEST(ObservableGroupByParallelTest, DefaultSchedulerRunsLanesOnTheirOwnThreads)
+{
+    ScopedGlobalTimerScheduler timerScope("ObservableGroupByParallelDefaultTest");
+    std::thread timerThread([timerScheduler = timerScope.scheduler()] {
+        timerScheduler->run();
+    });
+
+    // Held by the key selector, so it expires once the last lane has dropped the operator
+    auto token = std::make_shared<int32_t>(0);
+    const std::weak_ptr<int32_t> weakToken = token;
+    const auto outer = std::make_shared<TestObserver>();
+    std::mutex lock;
+    std::vector<GroupRecord> groups;
+    std::set<std::thread::id> laneThreads;
+    Observable::range(0, 4000)
+            ->groupByParallel([token = std::move(token)](const GAny &v) { return v.toInt64() % 16; })
+            ->doOnNext([&lock, &laneThreads](const GAny &) {
+                std::lock_guard guard(lock);
+                laneThreads.insert(std::this_thread::get_id());
+            })
+            ->subscribe(groupCollector(outer, lock, groups));
+    ASSERT_TRUE(outer->awaitTerminal(std::chrono::milliseconds(5000))) << outer->describe();
+    outer->expectComplete();
+
+    {
+        std::lock_guard guard(lock);
+        EXPECT_GT(laneThreads.size(), 1u);
+        EXPECT_EQ(laneThreads.count(std::this_thread::get_id()), 0u);
+        ASSERT_EQ(groups.size(), 16u);
+        for (const auto &group: groups) {
+            ASSERT_TRUE(group.observer->awaitTerminal(std::chrono::milliseconds(5000)));
+            group.observer->expectComplete();
+            const auto values = int64Values(group.observer);
+            ASSERT_EQ(values.size(), 4000u / 16);
+            for (size_t i = 0; i < values.size(); ++i) {
+                EXPECT_EQ(values[i], group.key + static_cast<int64_t>(i) * 16);
+            }
+        }
+    }
+
+    // Dropped lane workers stop their threads from the timer thread, wait for that before the leak check
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!weakToken.expired() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(weakToken.expired());
+    BoundedWait stopped;
+    timerScope.scheduler()->post([&stopped] { stopped.signal(); }, 0);
+    EXPECT_TRUE(stopped.await(std::chrono::milliseconds(1000)));
+
+    timerScope.scheduler()->stop();
+    timerThread.join();
+}
@@ -20,6 +20,19 @@ namespace
 {
 using namespace rx;
 using namespace rx::test;
+
+std::vector<std::vector<int64_t> > batches(const TestObserver &observer)
+{
+    std::vector<std::vector<int64_t> > result;
+    for (const auto &value: observer.values()) {
+        std::vector<int64_t> row;
+        for (const auto &item: value.castAs<std::vector<GAny> >()) {
+            row.push_back(item.toInt64());
+        }
+        result.push_back(std::move(row));
+    }
+    return result;
+}
 } // namespace
 
 TEST(ObservableTimeoutRegressionTest, TimeoutRejectsLateSourceValue)
@@ -371,6 +384,154 @@ TEST(ObservableSampleTest, ForwardsSourceErrorAndStopsSampling)
     observer->expectErrorContains("sample failure");
 }
 
+TEST(ObservableBufferTimedTest, FlushesOnTimespanOrMaxCountWhicheverComesFirst)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto observer = std::make_shared<TestObserver>();
+    ObservableEmitterPtr emitter;
+
+    Observable::create([&emitter](const ObservableEmitterPtr &sourceEmitter) {
+        emitter = sourceEmitter;
+    })->bufferTimed(100, 3, scheduler)->subscribe(observer);
+
+    emitter->onNext(1);
+    emitter->onNext(2);
+    scheduler->advanceBy(100);
+    EXPECT_EQ(batches(*observer), std::vector<std::vector<int64_t> >({{1, 2}}));
+
+    // Reaching maxCount flushes immediately and restarts the timespan
+    scheduler->advanceBy(50);
+    emitter->onNext(3);
+    emitter->onNext(4);
+    emitter->onNext(5);
+    emitter->onNext(6);
+    scheduler->advanceBy(60);
+    EXPECT_EQ(batches(*observer), std::vector<std::vector<int64_t> >({{1, 2}, {3, 4, 5}}));
+    scheduler->advanceBy(40);
+    EXPECT_EQ(batches(*observer), std::vector<std::vector<int64_t> >({{1, 2}, {3, 4, 5}, {6}}));
+
+    // Quiet periods emit nothing, completion flushes the open batch
+    scheduler->advanceBy(300);
+    emitter->onNext(7);
+    emitter->onComplete();
+    EXPECT_EQ(batches(*observer), std::vector<std::vector<int64_t> >({{1, 2}, {3, 4, 5}, {6}, {7}}));
+    observer->expectComplete();
+
+    EXPECT_THROW(Observable::never()->bufferTimed(0, 1, scheduler), GAnyException);
+}
+
+TEST(ObservableBufferTimedTest, SkipModeOpensOverlappingBuffersOnOneTimer)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    const auto observer = std::make_shared<TestObserver>();
+    ObservableEmitterPtr emitter;
+
+    Observable::create([&emitter](const ObservableEmitterPtr &sourceEmitter) {
+        emitter = sourceEmitter;
+    })->bufferTimedSkip(100, 50, scheduler)->subscribe(observer);
+
+    emitter->onNext(1);
+    scheduler->advanceBy(60);
+    emitter->onNext(2);
+    scheduler->advanceBy(60);
+    emitter->onNext(3);
+    scheduler->advanceBy(60);
+    EXPECT_EQ(batches(*observer), std::vector<std::vector<int64_t> >({{1, 2}, {2, 3}}));
+
+    emitter->onError(GAnyException("buffer source failure"));
+    observer->expectErrorContains("buffer source failure");
+
+    const auto disposed = std::make_shared<TestObserver>();
+    Observable::never()->bufferTimedSkip(100, 50, scheduler)->subscribe(disposed);
+    disposed->dispose();
+    scheduler->runUntilIdle();
+    disposed->expectNotTerminated();
+}
+
+TEST(ObservableWindowTimedTest, RollsOverOnTimespanOrMaxCount)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    std::vector<std::shared_ptr<TestObserver> > windows;
+    const auto outer = std::make_shared<TestObserver>();
+    ObservableEmitterPtr emitter;
+
+    Observable::create([&emitter](const ObservableEmitterPtr &sourceEmitter) {
+        emitter = sourceEmitter;
+    })->windowTimed(100, 2, scheduler)->subscribe(std::make_shared<LambdaObserver>(
+        [&windows](const GAny &value) {
+            windows.push_back(std::make_shared<TestObserver>());
+            value.castAs<std::shared_ptr<Observable> >()->subscribe(windows.back());
+        },
+        [&outer](const GAnyException &error) { outer->onError(error); },
+        [&outer] { outer->onComplete(); },
+        [&outer](const DisposablePtr &disposable) { outer->onSubscribe(disposable); }));
+
+    ASSERT_EQ(windows.size(), 1u);
+    emitter->onNext(1);
+    scheduler->advanceBy(100);
+    ASSERT_EQ(windows.size(), 2u);
+    windows[0]->expectInt64Values({1});
+    windows[0]->expectComplete();
+
+    // Hitting maxCount rolls over at once and the next window gets a full timespan
+    scheduler->advanceBy(30);
+    emitter->onNext(2);
+    emitter->onNext(3);
+    ASSERT_EQ(windows.size(), 3u);
+    windows[1]->expectInt64Values({2, 3});
+    windows[1]->expectComplete();
+    scheduler->advanceBy(90);
+    EXPECT_EQ(windows.size(), 3u);
+    scheduler->advanceBy(10);
+    ASSERT_EQ(windows.size(), 4u);
+    windows[2]->expectComplete();
+
+    emitter->onNext(4);
+    emitter->onError(GAnyException("window source failure"));
+    windows[3]->expectInt64Values({4});
+    windows[3]->expectErrorContains("window source failure");
+    outer->expectErrorContains("window source failure");
+
+    EXPECT_THROW(Observable::never()->windowTimed(0, 1, scheduler), GAnyException);
+}
+
+TEST(ObservableWindowTimedTest, SkipModeWindowsAreUnicastQueues)
+{
+    const auto scheduler = std::make_shared<TestScheduler>();
+    std::vector<std::shared_ptr<Observable> > windows;
+    const auto outer = std::make_shared<TestObserver>();
+    ObservableEmitterPtr emitter;
+
+    Observable::create([&emitter](const ObservableEmitterPtr &sourceEmitter) {
+        emitter = sourceEmitter;
+    })->windowTimedSkip(100, 50, scheduler)->subscribe(std::make_shared<LambdaObserver>(
+        [&windows](const GAny &value) { windows.push_back(value.castAs<std::shared_ptr<Observable> >()); },
+        [&outer](const GAnyException &error) { outer->onError(error); },
+        [&outer] { outer->onComplete(); },
+        [&outer](const DisposablePtr &disposable) { outer->onSubscribe(disposable); }));
+
+    emitter->onNext(1);
+    scheduler->advanceBy(60);
+    emitter->onNext(2);
+    scheduler->advanceBy(60);
+    emitter->onNext(3);
+    emitter->onComplete();
+    outer->expectComplete();
+    ASSERT_EQ(windows.size(), 3u);
+
+    // Windows subscribed late still replay what they queued, but only to their first observer
+    const std::vector<std::vector<int64_t> > expected{{1, 2}, {2, 3}, {3}};
+    for (size_t i = 0; i < windows.size(); ++i) {
+        const auto observer = std::make_shared<TestObserver>();
+        windows[i]->subscribe(observer);
+        observer->expectInt64Values(expected[i]);
+        observer->expectComplete();
+    }
+    const auto second = std::make_shared<TestObserver>();
+    windows[0]->subscribe(second);
+    second->expectErrorContains("single observer");
+}
+
 TEST(ObservableTimeoutTest, SwitchesToFallbackAtTheDeadline)
 {
     const auto scheduler = std::make_shared<TestScheduler>();
@@ -6,8 +6,15 @@
 #include <rx/disposables/atomic_disposable.h>
 #include <rx/operators/observable_switch_map.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace
@@ -166,41 +173,137 @@ TEST(ObservableSwitchMapTest, SwitchesToLatestInnerAndWaitsForItAfterUpstreamCom
     const auto upstreamDisposable = std::make_shared<AtomicDisposable>();
     const auto firstDisposable = std::make_shared<AtomicDisposable>();
     const auto secondDisposable = std::make_shared<AtomicDisposable>();
+    std::vector<ObservableEmitterPtr> inners;
     const auto observer = std::make_shared<TestObserver>();
     const auto parent = std::make_shared<SwitchMapObserver>(
-        observer, [firstDisposable, secondDisposable](const GAny &value) {
-            if (value.toInt64() == 1) {
-                return Observable::create([firstDisposable](const ObservableEmitterPtr &emitter) {
-                    emitter->setDisposable(firstDisposable);
-                });
-            }
-            return Observable::create([secondDisposable](const ObservableEmitterPtr &emitter) {
-                emitter->setDisposable(secondDisposable);
+        observer, [&inners, firstDisposable, secondDisposable](const GAny &value) {
+            const auto disposable = value.toInt64() == 1 ? firstDisposable : secondDisposable;
+            return Observable::create([&inners, disposable](const ObservableEmitterPtr &emitter) {
+                emitter->setDisposable(disposable);
+                inners.push_back(emitter);
             });
         });
 
     parent->onSubscribe(upstreamDisposable);
     parent->onNext(1);
-    parent->innerNext(1, 10);
+    ASSERT_EQ(inners.size(), 1u);
+    inners[0]->onNext(10);
 
+    // The upstream thread only retires the old inner, the drain at the end of onNext cancels it
     parent->onNext(2);
+    ASSERT_EQ(inners.size(), 2u);
     EXPECT_TRUE(firstDisposable->isDisposed());
-    parent->innerNext(1, 11);
-    parent->innerError(1, GAnyException("late inner failure"));
+    inners[0]->onNext(11);
+    inners[0]->onError(GAnyException("late inner failure"));
 
     parent->onComplete();
     EXPECT_FALSE(secondDisposable->isDisposed());
     observer->expectInt64Values({10});
     observer->expectNotTerminated();
 
-    parent->innerNext(2, 20);
-    parent->innerComplete(2);
+    inners[1]->onNext(20);
+    inners[1]->onComplete();
     observer->expectInt64Values({10, 20});
     observer->expectComplete();
+    EXPECT_TRUE(secondDisposable->isDisposed());
 
     parent->dispose();
     EXPECT_TRUE(upstreamDisposable->isDisposed());
-    EXPECT_TRUE(secondDisposable->isDisposed());
+    EXPECT_TRUE(parent->isDisposed());
+}
+
+TEST(ObservableSwitchMapTest, DropsStaleInnerSignalsAndForwardsLateCurrentInnerError)
+{
+    std::vector<ObservableEmitterPtr> inners;
+    ObservableEmitterPtr mainEmitter;
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::create([&mainEmitter](const ObservableEmitterPtr &emitter) { mainEmitter = emitter; })
+        ->switchMap([&inners](const GAny &) {
+            return Observable::create([&inners](const ObservableEmitterPtr &emitter) { inners.push_back(emitter); });
+        })
+        ->subscribe(observer);
+
+    mainEmitter->onNext(1);
+    mainEmitter->onNext(2);
+    ASSERT_EQ(inners.size(), 2u);
+    EXPECT_TRUE(inners[0]->isDisposed());
+    inners[0]->onNext(10);
+    inners[1]->onNext(20);
+    mainEmitter->onComplete();
+    observer->expectNotTerminated();
+
+    inners[1]->onError(GAnyException("late inner failure"));
+    observer->expectInt64Values({20});
+    observer->expectErrorContains("late inner failure");
+}
+
+TEST(ObservableSwitchMapTest, InnersOnDifferentThreadsNeverOverlapDownstream)
+{
+    // Fails the test if two signals are ever inside the observer at once
+    class OverlapObserver : public TestObserver
+    {
+    public:
+        void onNext(const GAny &value) override
+        {
+            enter();
+            TestObserver::onNext(value);
+            std::this_thread::yield();
+            mInside.fetch_sub(1);
+        }
+
+        void onComplete() override
+        {
+            enter();
+            TestObserver::onComplete();
+            mInside.fetch_sub(1);
+        }
+
+        bool overlapped() const
+        {
+            return mOverlapped.load();
+        }
+
+    private:
+        void enter()
+        {
+            if (mInside.fetch_add(1) != 0) {
+                mOverlapped.store(true);
+            }
+        }
+
+        std::atomic<int32_t> mInside = 0;
+        std::atomic<bool> mOverlapped = false;
+    };
+
+    // Every inner emits from its own thread, joined before the test ends
+    std::vector<std::thread> threads;
+    const auto observer = std::make_shared<OverlapObserver>();
+    Observable::range(0, 8)
+        ->switchMap([&threads](const GAny &) {
+            return Observable::create([&threads](const ObservableEmitterPtr &emitter) {
+                threads.emplace_back([emitter] {
+                    for (int64_t i = 0; i < 2000 && !emitter->isDisposed(); ++i) {
+                        emitter->onNext(i);
+                    }
+                    emitter->onComplete();
+                });
+            });
+        })
+        ->subscribe(observer);
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000))) << observer->describe();
+    EXPECT_FALSE(observer->overlapped());
+    observer->expectComplete();
+
+    // Once the last inner got through, nothing from a stale inner follows it
+    const auto values = observer->values();
+    ASSERT_GE(values.size(), 2000u);
+    for (int64_t i = 0; i < 2000; ++i) {
+        EXPECT_EQ(values[values.size() - 2000 + i].toInt64(), i);
+    }
 }
 
 TEST(ObservableSwitchMapTest, ForwardsInnerError)
@@ -248,6 +351,51 @@ TEST(ObservableBufferTest, SupportsExactOverlappingAndInvalidBoundaries)
     EXPECT_THROW(Observable::just(1)->buffer(1, 0), GAnyException);
 }
 
+TEST(ObservableBufferTest, ViewsShareStorageAcrossOverlappingAndGappedWindows)
+{
+    std::vector<ArrayViewPtr> views;
+    Observable::range(0, 2000)
+        ->bufferView(300, 1)
+        ->subscribe([&views](const GAny &value) { views.push_back(value.castAs<ArrayViewPtr>()); });
+
+    // Full windows first, then the trailing partial windows on completion, across segment rollovers
+    ASSERT_EQ(views.size(), 2000u);
+    for (size_t i = 0; i < views.size(); ++i) {
+        const auto &view = *views[i];
+        ASSERT_EQ(view.size(), std::min<size_t>(300, 2000 - i));
+        EXPECT_EQ(view[0].toInt64(), static_cast<int64_t>(i));
+        EXPECT_EQ(view[view.size() - 1].toInt64(), static_cast<int64_t>(i + view.size() - 1));
+    }
+    EXPECT_EQ(views[0]->owner(), views[1]->owner());
+
+    const auto gapped = std::make_shared<TestObserver>();
+    Observable::range(1, 7)->bufferView(2, 3)->subscribe(gapped);
+    std::vector<std::vector<int64_t> > rows;
+    for (const auto &value: gapped->values()) {
+        std::vector<int64_t> row;
+        for (const auto &item: value.castAs<ArrayViewPtr>()->toVector()) {
+            row.push_back(item.toInt64());
+        }
+        rows.push_back(std::move(row));
+    }
+    EXPECT_EQ(rows, std::vector<std::vector<int64_t> >({{1, 2}, {4, 5}, {7}}));
+    gapped->expectComplete();
+
+    const auto gappedVectors = std::make_shared<TestObserver>();
+    Observable::range(1, 7)->buffer(2, 3)->subscribe(gappedVectors);
+    EXPECT_EQ(nestedInt64Values(*gappedVectors), rows);
+
+    // Segments grow with the values that arrive, a huge count reserves nothing up front
+    const auto huge = std::make_shared<TestObserver>();
+    Observable::range(1, 3)->bufferView(std::numeric_limits<uint64_t>::max() / 2, 1)->subscribe(huge);
+    ASSERT_EQ(huge->values().size(), 3u);
+    EXPECT_EQ(huge->values()[0].castAs<ArrayViewPtr>()->size(), 3u);
+    EXPECT_EQ(huge->values()[2].castAs<ArrayViewPtr>()->size(), 1u);
+    huge->expectComplete();
+
+    EXPECT_THROW(Observable::just(1)->bufferView(0, 1), GAnyException);
+}
+
 TEST(ObservableBufferTest, ForwardsUpstreamErrorAndStopsWhenDisposed)
 {
     const auto errorObserver = std::make_shared<TestObserver>();
@@ -287,6 +435,228 @@ TEST(ObservableToArrayTest, ForwardsUpstreamErrorAndHonorsEarlyDisposal)
     disposedObserver->expectNotTerminated();
 }
 
+TEST(ObservableToArrayTest, ViewVariantsPassTheSameStorageDownstream)
+{
+    std::vector<ArrayViewPtr> seen;
+    std::vector<ArrayViewPtr> received;
+    Observable::range(1, 3)
+        ->toArrayView()
+        ->doOnNext([&seen](const GAny &value) { seen.push_back(value.castAs<ArrayViewPtr>()); })
+        ->map([](const GAny &value) { return value; })
+        ->subscribe([&received](const GAny &value) { received.push_back(value.castAs<ArrayViewPtr>()); });
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(seen[0], received[0]);
+    EXPECT_EQ(received[0]->toVector().size(), 3u);
+    EXPECT_EQ((*received[0])[2].toInt64(), 3);
+
+    std::vector<std::vector<int64_t> > rows;
+    Observable::range(1, 5)->bufferView(2)->subscribe([&rows](const GAny &value) {
+        std::vector<int64_t> row;
+        for (const auto &item: *value.castAs<ArrayViewPtr>()) {
+            row.push_back(item.toInt64());
+        }
+        rows.push_back(std::move(row));
+    });
+    EXPECT_EQ(rows, std::vector<std::vector<int64_t> >({{1, 2}, {3, 4}, {5}}));
+}
+
+TEST(ObservableSortedTest, SortsStablyByComparatorOrKey)
+{
+    const auto ascending = std::make_shared<TestObserver>();
+    Observable::just(3, 1, 2)->sorted()->subscribe(ascending);
+    ascending->expectInt64Values({1, 2, 3});
+    ascending->expectComplete();
+
+    const auto descending = std::make_shared<TestObserver>();
+    Observable::just(3, 1, 2)
+        ->toSortedList([](const GAny &a, const GAny &b) { return a.toInt64() > b.toInt64(); })
+        ->subscribe(descending);
+    EXPECT_EQ(nestedInt64Values(*descending), std::vector<std::vector<int64_t> >({{3, 2, 1}}));
+    descending->expectComplete();
+
+    // Equal keys keep their upstream order
+    const auto byNumber = std::make_shared<TestObserver>();
+    Observable::just(21, 10, 31, 11, 20)
+        ->sortedBy([](const GAny &value) { return value.toInt64() % 10; })
+        ->subscribe(byNumber);
+    byNumber->expectInt64Values({10, 20, 21, 31, 11});
+    byNumber->expectComplete();
+
+    const auto byString = std::make_shared<TestObserver>();
+    Observable::just(3, 12, 1, 100)
+        ->toSortedListBy([](const GAny &value) { return GAny(std::to_string(value.toInt64())); })
+        ->subscribe(byString);
+    EXPECT_EQ(nestedInt64Values(*byString), std::vector<std::vector<int64_t> >({{1, 100, 12, 3}}));
+    byString->expectComplete();
+
+    // Integer keys beyond 2^53 keep their exact order, mixed integer and floating point keys compare as GAny
+    const auto byTimestamp = std::make_shared<TestObserver>();
+    Observable::just(int64_t(1700000000000000001), int64_t(1700000000000000000))
+        ->sortedBy([](const GAny &value) { return value; })
+        ->subscribe(byTimestamp);
+    byTimestamp->expectInt64Values({1700000000000000000, 1700000000000000001});
+    byTimestamp->expectComplete();
+
+    const auto mixed = std::make_shared<TestObserver>();
+    Observable::just(3, 1, 2)
+        ->sortedBy([](const GAny &value) { return value.toInt64() == 2 ? GAny(1.5) : value; })
+        ->subscribe(mixed);
+    mixed->expectInt64Values({1, 2, 3});
+    mixed->expectComplete();
+
+    const auto failed = std::make_shared<TestObserver>();
+    Observable::just(1, 2)
+        ->sorted([](const GAny &, const GAny &) -> bool { throw std::runtime_error("comparator failure"); })
+        ->subscribe(failed);
+    failed->expectInt64Values({});
+    failed->expectErrorContains("comparator failure");
+}
+
+TEST(ObservableSortedTest, LargeInputsAreMergeSortedOnTheScheduler)
+{
+    GTaskSystem taskSystem("ObservableSortedTest", 4);
+    taskSystem.start();
+    const auto scheduler = TaskSystemScheduler::create(&taskSystem);
+
+    std::vector<GAny> items;
+    for (int64_t i = 0; i < 60000; ++i) {
+        items.emplace_back((i * 7919) % 60000);
+    }
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::fromArray(items)->sorted(nullptr, scheduler)->subscribe(observer);
+    ASSERT_TRUE(observer->awaitTerminal(std::chrono::milliseconds(5000)));
+    observer->expectComplete();
+    const auto values = observer->values();
+    ASSERT_EQ(values.size(), 60000u);
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i].toInt64(), static_cast<int64_t>(i));
+    }
+
+    // Keys are sorted natively, ties keep the upstream order across runs
+    const auto keyed = std::make_shared<TestObserver>();
+    Observable::fromArray(items)
+        ->toSortedListBy([](const GAny &value) { return value.toInt64() % 3; }, scheduler)
+        ->subscribe(keyed);
+    ASSERT_TRUE(keyed->awaitTerminal(std::chrono::milliseconds(5000)));
+    keyed->expectComplete();
+    const auto rows = nestedInt64Values(*keyed);
+    ASSERT_EQ(rows.size(), 1u);
+    std::vector<int64_t> expected;
+    for (int64_t key = 0; key < 3; ++key) {
+        for (const auto &item: items) {
+            if (item.toInt64() % 3 == key) {
+                expected.push_back(item.toInt64());
+            }
+        }
+    }
+    EXPECT_EQ(rows[0], expected);
+
+    const auto failed = std::make_shared<TestObserver>();
+    Observable::fromArray(items)
+        ->sorted([](const GAny &a, const GAny &b) -> bool {
+            if (a.toInt64() == 59999 || b.toInt64() == 59999) {
+                throw std::runtime_error("comparator failure");
+            }
+            return a < b;
+        }, scheduler)
+        ->subscribe(failed);
+    ASSERT_TRUE(failed->awaitTerminal(std::chrono::milliseconds(5000)));
+    failed->expectInt64Values({});
+    failed->expectErrorContains("comparator failure");
+
+    taskSystem.stopAndWait();
+}
+
+TEST(ObservableSortedExternalTest, MergesSpilledRunsInOrderAndRemovesThem)
+{
+    const auto tmpDir = std::filesystem::temp_directory_path() / "rx_sorted_external_test";
+    std::filesystem::remove_all(tmpDir);
+    std::filesystem::create_directories(tmpDir);
+    const auto fileCount = [&tmpDir] {
+        return std::distance(std::filesystem::directory_iterator(tmpDir), std::filesystem::directory_iterator());
+    };
+
+    // [key, sequence] pairs, a budget of a few KiB spills dozens of runs, so intermediate merge passes run first
+    std::vector<GAny> items;
+    for (int64_t i = 0; i < 3000; ++i) {
+        items.emplace_back(std::vector<GAny>{(i * 7919) % 100, i});
+    }
+    const auto byKey = [](const GAny &a, const GAny &b) {
+        return a.castAs<std::vector<GAny> >()[0].toInt64() < b.castAs<std::vector<GAny> >()[0].toInt64();
+    };
+    const auto observer = std::make_shared<TestObserver>();
+    Observable::fromArray(items)->sortedExternal(byKey, 8 * 1024, tmpDir.string())->subscribe(observer);
+    observer->expectComplete();
+    const auto values = observer->values();
+    ASSERT_EQ(values.size(), items.size());
+    for (size_t i = 1; i < values.size(); ++i) {
+        const auto previous = values[i - 1].castAs<std::vector<GAny> >();
+        const auto current = values[i].castAs<std::vector<GAny> >();
+        ASSERT_LE(previous[0].toInt64(), current[0].toInt64());
+        if (previous[0].toInt64() == current[0].toInt64()) {
+            ASSERT_LT(previous[1].toInt64(), current[1].toInt64());
+        }
+    }
+    EXPECT_EQ(fileCount(), 0);
+
+    // Disposing during an intermediate merge pass removes the old runs and the partly written one
+    bool completed = false;
+    int comparisons = 0;
+    const auto midMerge = std::make_shared<TestObserver>();
+    Observable::fromArray(items)
+        ->doOnComplete([&completed] { completed = true; })
+        ->sortedExternal([&](const GAny &a, const GAny &b) {
+            if (completed && ++comparisons == 1000) {
+                midMerge->dispose();
+            }
+            return byKey(a, b);
+        }, 8 * 1024, tmpDir.string())
+        ->subscribe(midMerge);
+    EXPECT_GE(comparisons, 1000);
+    midMerge->expectInt64Values({});
+    EXPECT_EQ(fileCount(), 0);
+
+    // Disposing between spills removes the runs written so far
+    const auto subject = PublishSubject::create();
+    const auto disposed = std::make_shared<TestObserver>();
+    subject->sortedExternal(nullptr, 1024, tmpDir.string())->subscribe(disposed);
+    for (int64_t i = 0; i < 200; ++i) {
+        subject->onNext(200 - i);
+    }
+    EXPECT_GT(fileCount(), 0);
+    disposed->dispose();
+    EXPECT_EQ(fileCount(), 0);
+    disposed->expectInt64Values({});
+
+    // The default codec refuses user objects
+    const auto failed = std::make_shared<TestObserver>();
+    Observable::just(GAny(std::make_shared<TestObserver>()), 1)
+        ->sortedExternal([](const GAny &, const GAny &) { return false; }, 1, tmpDir.string())
+        ->subscribe(failed);
+    failed->expectErrorContains("BinarySpillCodec cannot encode");
+    EXPECT_EQ(fileCount(), 0);
+
+    std::filesystem::remove_all(tmpDir);
+}
+
+TEST(ObservableSortedExternalTest, BinarySpillCodecRoundTripsPlainValues)
+{
+    BinarySpillCodec codec;
+    const std::vector<GAny> values{GAny(), GAny(nullptr), true, false, int64_t(-300), int64_t(1) << 62, 2.5,
+                                   std::string("spill"), std::vector<GAny>{1, std::string("a"), std::vector<GAny>{}}};
+    for (const auto &value: values) {
+        std::string record;
+        codec.encode(value, record);
+        const GAny decoded = codec.decode(record);
+        EXPECT_EQ(decoded.toString(), value.toString());
+        EXPECT_EQ(decoded.isNumber(), value.isNumber());
+    }
+    std::string truncated;
+    codec.encode(std::string("truncated"), truncated);
+    truncated.pop_back();
+    EXPECT_THROW(codec.decode(truncated), GAnyException);
+}
+
 TEST(ObservableStartWithTest, SupportsSingleArrayAndVariadicPrefixes)
 {
     const auto single = std::make_shared<TestObserver>();
@@ -143,6 +143,12 @@ public:
         return mNow;
     }
 
+    // Virtual clock in nanoseconds, anchored at the real steady time of construction
+    uint64_t now() const
+    {
+        return mEpoch + currentTime() * 1000000;
+    }
+
     size_t pendingTaskCount(const std::shared_ptr<TestWorkerState> &worker) const
     {
         std::lock_guard lock(mMutex);
@@ -167,6 +173,7 @@ private:
     std::vector<Task> mTasks;
     uint64_t mNow = 0;
     uint64_t mSequence = 0;
+    const uint64_t mEpoch = GTime::currentSteadyTime().nanosecond();
 };
 
 class TestWorker : public Worker
@@ -201,6 +208,11 @@ public:
         return mState->disposed.load(std::memory_order_acquire);
     }
 
+    uint64_t now() const override
+    {
+        return mScheduler->now();
+    }
+
     void advanceBy(uint64_t duration)
     {
         mScheduler->advanceBy(duration);
@@ -267,6 +279,11 @@ public:
         return mState->currentTime();
     }
 
+    uint64_t now() const override
+    {
+        return mState->now();
+    }
+
 private:
     std::shared_ptr<TestSchedulerState> mState;
 };